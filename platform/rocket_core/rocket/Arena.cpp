@@ -0,0 +1,88 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include "detail/math.h"
+#include "detail/memory.h"
+
+namespace rocket {
+
+Arena::Arena(std::size_t chunkSize) : chunkSize_(chunkSize) {
+    if (chunkSize_ == 0) {
+        throw std::runtime_error("invalid argument (chunk size)");
+    }
+    auto storage = std::make_unique_for_overwrite<std::byte[]>(chunkSize_);
+    auto const data = storage.get();
+    chunks_.push_back({.storage = std::move(storage), .data = data, .size = chunkSize_});
+    reset();
+}
+
+Arena::Arena(std::string_view name, std::size_t capacity, MemorySource const& memorySource,
+    MappingOptions const& mappingOptions) {
+    if (capacity == 0) {
+        throw std::runtime_error("invalid argument (capacity)");
+    }
+
+    auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+    if (!result) {
+        throw std::runtime_error("failed to open memory source");
+    }
+
+    File file;
+    std::size_t pageSize;
+    std::tie(file, pageSize) = std::move(result).value();
+
+    chunkSize_ = detail::align_up(capacity, pageSize);
+    if (file.getFileSize() != chunkSize_) {
+        file.truncate(chunkSize_);
+    }
+    region_ = detail::mapFile(file, chunkSize_, mappingOptions, mappingStatus_);
+
+    chunks_.push_back({.storage = nullptr, .data = region_.data(), .size = region_.size()});
+    reset();
+}
+
+void Arena::release() noexcept {
+    chunks_.resize(std::min<std::size_t>(chunks_.size(), 1));
+    reset();
+}
+
+auto Arena::capacity() const noexcept -> std::size_t {
+    return std::accumulate(
+        chunks_.begin(), chunks_.end(), std::size_t(0), [](std::size_t sum, Chunk const& chunk) {
+            return sum + chunk.size;
+        });
+}
+
+auto Arena::allocateSlow(std::size_t size, std::size_t align) -> void* {
+    // Chunks after current are free since the last reset, skip ones not fitting allocation
+    auto const fits = [&](Chunk const& chunk) {
+        auto const address = (std::bit_cast<std::uintptr_t>(chunk.data) + align - 1) & ~(align - 1);
+        return address + size <= std::bit_cast<std::uintptr_t>(chunk.data + chunk.size);
+    };
+
+    auto next = current_ + 1;
+    while (next < chunks_.size() && !fits(chunks_[next])) {
+        ++next;
+    }
+
+    if (next == chunks_.size()) {
+        auto const chunkSize = std::max(chunkSize_, size + align);
+        auto storage = std::make_unique_for_overwrite<std::byte[]>(chunkSize);
+        auto const data = storage.get();
+        chunks_.push_back({.storage = std::move(storage), .data = data, .size = chunkSize});
+    }
+
+    current_ = next;
+    pos_ = chunks_[current_].data;
+    end_ = chunks_[current_].data + chunks_[current_].size;
+    return allocate(size, align);
+}
+
+} // namespace rocket
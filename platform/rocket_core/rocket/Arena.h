@@ -0,0 +1,158 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#include "MappedRegion.h"
+#include "MemorySource.h"
+#include "Platform.h"
+
+namespace rocket {
+
+/// Monotonic bump allocator
+/// Memory is allocated by moving pointer inside current chunk, deallocation is no-op and reset() rewinds arena to the
+/// first chunk keeping all chunks for reuse, so steady state allocations never reach malloc. Arena is not thread-safe.
+class Arena {
+  public:
+    /// Default size of heap chunks
+    static constexpr std::size_t kDefaultChunkSize = std::size_t(64) << 10;
+
+  private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> storage;
+        std::byte* data;
+        std::size_t size;
+    };
+
+    MappedRegion region_;
+    MappingStatus mappingStatus_;
+    std::vector<Chunk> chunks_;
+    std::size_t chunkSize_ = kDefaultChunkSize;
+    std::size_t current_ = 0;
+    std::byte* pos_ = nullptr;
+    std::byte* end_ = nullptr;
+
+  public:
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    Arena(Arena&& that) noexcept {
+        swap(that);
+    }
+
+    Arena& operator=(Arena&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Construct arena of heap chunks
+    /// \param[in] chunkSize is size of chunk, larger allocations take own chunk
+    /// Throws on error
+    explicit Arena(std::size_t chunkSize = kDefaultChunkSize);
+
+    /// Construct arena with the first chunk mapped from memory source, e.g. AnonymousMemorySource with huge pages
+    /// Chunks allocated on the region exhausted are taken from heap and have the region size
+    /// \param[in] name is memory source name
+    /// \param[in] capacity is region size, rounded up to page size
+    /// Throws on error
+    Arena(std::string_view name, std::size_t capacity, MemorySource const& memorySource,
+        MappingOptions const& mappingOptions = {});
+
+    /// Allocate size bytes aligned to align (power of two)
+    /// Throws std::bad_alloc on heap chunk allocation failed
+    [[nodiscard]] ROCKET_FORCE_INLINE auto allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+        -> void* {
+        auto const address = (std::bit_cast<std::uintptr_t>(pos_) + align - 1) & ~(align - 1);
+        if (address + size <= std::bit_cast<std::uintptr_t>(end_)) [[likely]] {
+            pos_ = std::bit_cast<std::byte*>(address + size);
+            return std::bit_cast<void*>(address);
+        }
+        return allocateSlow(size, align);
+    }
+
+    /// Allocate uninitialized array of count objects
+    template <typename T>
+    [[nodiscard]] ROCKET_FORCE_INLINE auto allocate(std::size_t count) -> T* {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Rewind arena to the first chunk, memory allocated before is invalidated
+    void reset() noexcept {
+        current_ = 0;
+        pos_ = chunks_.empty() ? nullptr : chunks_.front().data;
+        end_ = chunks_.empty() ? nullptr : chunks_.front().data + chunks_.front().size;
+    }
+
+    /// Reset arena and return heap chunks except the first one
+    void release() noexcept;
+
+    /// Total size of chunks
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+    /// Chunks count
+    [[nodiscard]] auto chunksCount() const noexcept -> std::size_t {
+        return chunks_.size();
+    }
+
+    /// Result of applying mapping options to the memory source region
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
+    /// Swap resources with other arena
+    void swap(Arena& that) noexcept {
+        using std::swap;
+        swap(region_, that.region_);
+        swap(mappingStatus_, that.mappingStatus_);
+        swap(chunks_, that.chunks_);
+        swap(chunkSize_, that.chunkSize_);
+        swap(current_, that.current_);
+        swap(pos_, that.pos_);
+        swap(end_, that.end_);
+    }
+
+    /// \see Arena::swap
+    friend void swap(Arena& a, Arena& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    /// Move to the next chunk fitting allocation or allocate a new one
+    auto allocateSlow(std::size_t size, std::size_t align) -> void*;
+};
+
+/// Adapter of Arena to std::pmr::memory_resource, e.g. for std::pmr containers on hot path
+class ArenaMemoryResource final : public std::pmr::memory_resource {
+  private:
+    Arena* arena_;
+
+  public:
+    explicit ArenaMemoryResource(Arena& arena) noexcept : arena_(&arena) {}
+
+    /// Underlying arena
+    [[nodiscard]] auto arena() const noexcept -> Arena& {
+        return *arena_;
+    }
+
+  private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        return arena_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    [[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+} // namespace rocket
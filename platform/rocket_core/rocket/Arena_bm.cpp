@@ -0,0 +1,91 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <array>
+#include <cstdlib>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Arena.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Sizes of small objects allocated while handling a message (strings, nodes, buffers)
+constexpr std::array<std::size_t, 8> kSizes = {16, 24, 48, 32, 96, 16, 200, 64};
+
+} // namespace
+
+/// Allocate batch of small objects per message and free them all, the first argument is batch size
+static void BM_Arena_Malloc(::benchmark::State& state) {
+    auto const batch = static_cast<std::size_t>(state.range(0));
+    std::vector<void*> pointers(batch);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch; ++i) {
+            pointers[i] = std::malloc(kSizes[i % kSizes.size()]);
+            benchmark::DoNotOptimize(pointers[i]);
+        }
+        for (std::size_t i = 0; i < batch; ++i) {
+            std::free(pointers[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Arena_Malloc)->RangeMultiplier(4)->Range(4, 1024);
+
+/// \see BM_Arena_Malloc
+static void BM_Arena_Bump(::benchmark::State& state) {
+    auto const batch = static_cast<std::size_t>(state.range(0));
+    Arena arena;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch; ++i) {
+            auto const pointer = arena.allocate(kSizes[i % kSizes.size()]);
+            benchmark::DoNotOptimize(pointer);
+        }
+        arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Arena_Bump)->RangeMultiplier(4)->Range(4, 1024);
+
+/// Build vector of strings per message, the first argument is strings count
+static void BM_Arena_VectorOfStrings_Std(::benchmark::State& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<std::string> values;
+        for (std::size_t i = 0; i < count; ++i) {
+            values.emplace_back(kSizes[i % kSizes.size()], 'x');
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Arena_VectorOfStrings_Std)->RangeMultiplier(4)->Range(4, 1024);
+
+/// \see BM_Arena_VectorOfStrings_Std
+static void BM_Arena_VectorOfStrings_Pmr(::benchmark::State& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    Arena arena;
+    ArenaMemoryResource resource(arena);
+    for (auto _ : state) {
+        {
+            std::pmr::vector<std::pmr::string> values(&resource);
+            for (std::size_t i = 0; i < count; ++i) {
+                values.emplace_back(kSizes[i % kSizes.size()], 'x');
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+        arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Arena_VectorOfStrings_Pmr)->RangeMultiplier(4)->Range(4, 1024);
+
+} // namespace rocket::testing
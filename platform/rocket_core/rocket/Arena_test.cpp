@@ -0,0 +1,90 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "Arena.h"
+
+namespace rocket::testing {
+
+TEST_CASE("Arena: basic") {
+    Arena arena(1024);
+    REQUIRE(arena.chunksCount() == 1);
+    REQUIRE(arena.capacity() == 1024);
+
+    auto const a = arena.allocate(10, 1);
+    auto const b = arena.allocate(8, 8);
+    REQUIRE(b != a);
+    REQUIRE(std::bit_cast<std::uintptr_t>(b) % 8 == 0);
+    REQUIRE(std::bit_cast<std::uintptr_t>(arena.allocate(1, 64)) % 64 == 0);
+
+    auto const values = arena.allocate<std::uint64_t>(16);
+    for (std::uint64_t i = 0; i < 16; ++i) {
+        values[i] = i;
+    }
+
+    // Exhausted chunk is followed by a new one, allocation larger than chunk takes own chunk
+    std::memset(arena.allocate(1000, 1), 0xff, 1000);
+    REQUIRE(arena.chunksCount() == 2);
+    std::memset(arena.allocate(5000, 1), 0xff, 5000);
+    REQUIRE(arena.chunksCount() == 3);
+    REQUIRE(arena.capacity() >= 1024 + 1024 + 5000);
+
+    for (std::uint64_t i = 0; i < 16; ++i) {
+        REQUIRE(values[i] == i);
+    }
+
+    // Reset reuses chunks without allocations
+    arena.reset();
+    REQUIRE(arena.allocate(10, 1) == a);
+    [[maybe_unused]] auto const c = arena.allocate(1000, 1);
+    [[maybe_unused]] auto const d = arena.allocate(5000, 1);
+    REQUIRE(arena.chunksCount() == 3);
+
+    arena.release();
+    REQUIRE(arena.chunksCount() == 1);
+    REQUIRE(arena.allocate(10, 1) == a);
+}
+
+TEST_CASE("Arena: memory source") {
+    Arena arena("test", 10000, AnonymousMemorySource());
+    REQUIRE(arena.mappingStatus());
+    REQUIRE(arena.capacity() % 4096 == 0);
+    REQUIRE(arena.capacity() >= 10000);
+
+    auto const data = static_cast<std::byte*>(arena.allocate(arena.capacity(), 1));
+    std::memset(data, 0xff, arena.capacity());
+    REQUIRE(arena.chunksCount() == 1);
+
+    // Region exhausted, next chunk is taken from heap
+    REQUIRE(arena.allocate(1, 1));
+    REQUIRE(arena.chunksCount() == 2);
+
+    arena.release();
+    REQUIRE(arena.allocate(1, 1) == data);
+}
+
+TEST_CASE("Arena: memory resource") {
+    Arena arena(256);
+    ArenaMemoryResource resource(arena);
+    ArenaMemoryResource other(arena);
+    REQUIRE(resource.is_equal(resource));
+    REQUIRE(!resource.is_equal(other));
+
+    std::pmr::vector<std::pmr::string> values(&resource);
+    for (int i = 0; i < 100; ++i) {
+        values.emplace_back(std::string(64, char('a' + i % 26)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(std::string_view(values[std::size_t(i)]) == std::string(64, char('a' + i % 26)));
+    }
+    REQUIRE(arena.chunksCount() > 1);
+}
+
+} // namespace rocket::testing
@@ -3,12 +3,18 @@
 
 #pragma once
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <atomic>
 #include <bit>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <format>
+#include <limits>
+#include <memory>
 #include <span>
 #include <string_view>
 #include <type_traits>
@@ -16,6 +22,8 @@
 #include "MappedRegion.h"
 #include "MemorySource.h"
 #include "Platform.h"
+#include "QueueStatistics.h"
+#include "ThreadUtils.h"
 #include "detail/math.h"
 #include "detail/memory.h"
 
@@ -31,19 +39,27 @@ struct BoundedMPSCRawQueueDetail {
     static constexpr std::size_t kSegmentSize = Traits::kSegmentSize;
     /// Alignment
     static constexpr std::size_t kAlign = Traits::kAlign;
+    /// Statistics enabled
+    static constexpr bool kStatistics = QueueStatisticsTraits<Traits>;
+    /// Producer events between statistics publications
+    static constexpr std::size_t kStatisticsInterval = getQueueStatisticsInterval<Traits>();
 
     /// Control struct for queue buffer
     struct MemoryHeader {
-        /// Placeholder for queue tag
-        char tag[kTag.size()];
+        /// Placeholder for queue tag, NUL-terminated so a tag never matches a longer one sharing its prefix
+        char tag[kTag.size() + 1];
         /// Max message size
         std::size_t maxMessageSize;
         /// Queue length
         std::size_t length;
         /// Consumer position
         alignas(kAlign) std::size_t consumerPos;
+        /// Messages abandoned by dead producers and skipped by consumer
+        std::size_t abandoned;
         /// Producer position
         alignas(kAlign) std::size_t producerPos;
+        /// Statistics (own cache line, empty on disabled)
+        [[no_unique_address]] QueueStatisticsStorage<kStatistics> statistics;
 
         static_assert(std::atomic_ref<std::size_t>::is_always_lock_free);
     };
@@ -55,13 +71,32 @@ struct BoundedMPSCRawQueueDetail {
     };
     static_assert(std::is_trivially_copyable_v<MessageHeader>);
 
+    /// Slot claim of free slot
+    static constexpr std::uint64_t kSlotFree = 0;
+    /// Slot claim of committed message
+    static constexpr std::uint64_t kSlotCommitted = 0xffffffff;
+
     /// Control struct for commit state
+    /// Slot is claimed by producer and skipped by consumer with CAS on the state, so a producer preempted between
+    /// reserving position and claiming the slot finds the slot skipped and reserves the next position
     struct StateHeader {
-        alignas(kAlign) bool commited;
-        static_assert(std::atomic_ref<bool>::is_always_lock_free);
+        /// Lap of the position the slot is expected for (high half) and the claim (low half): kSlotFree, pid of
+        /// producer claimed the slot or kSlotCommitted
+        alignas(kAlign) std::uint64_t state;
+        static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
     };
     static_assert(std::is_trivially_copyable_v<StateHeader>);
 
+    /// Slot state for position lap and claim, lap is truncated to 32 bits
+    [[nodiscard]] static constexpr auto makeSlotState(std::size_t lap, std::uint64_t claim) noexcept -> std::uint64_t {
+        return (static_cast<std::uint64_t>(lap) << 32) | claim;
+    }
+
+    /// Claim part of slot state
+    [[nodiscard]] static constexpr auto getSlotClaim(std::uint64_t state) noexcept -> std::uint64_t {
+        return state & 0xffffffff;
+    }
+
     /// Align message buffer size
     [[nodiscard]] static constexpr auto alignBufferSize(std::size_t value) noexcept -> std::size_t {
         return detail::align_up(value, kSegmentSize);
@@ -70,6 +105,11 @@ struct BoundedMPSCRawQueueDetail {
     /// Offset for the first message header from memory buffer start
     static constexpr std::size_t kDataStartPos = alignBufferSize(sizeof(MemoryHeader));
 
+    /// Return true on header tagged with the queue tag (full tag field compared)
+    [[nodiscard]] static auto checkTag(MemoryHeader const* header) noexcept -> bool {
+        return std::equal(kTag.begin(), kTag.end(), header->tag) && header->tag[kTag.size()] == '\0';
+    }
+
     /// Check buffer points to valid SPMC queue region
     /// Return true on success and false otherwise.
     [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
@@ -77,7 +117,7 @@ struct BoundedMPSCRawQueueDetail {
         if (header->maxMessageSize == 0 || header->length == 0) {
             return false;
         }
-        if (!std::equal(kTag.begin(), kTag.end(), header->tag)) {
+        if (!checkTag(header)) {
             return false;
         }
         return true;
@@ -87,8 +127,12 @@ struct BoundedMPSCRawQueueDetail {
     static void init(std::span<std::byte> buffer, std::size_t maxMessageSize, std::size_t length) noexcept {
         auto header = std::bit_cast<MemoryHeader*>(buffer.data());
         std::copy(kTag.begin(), kTag.end(), header->tag);
+        header->tag[kTag.size()] = '\0';
         header->maxMessageSize = maxMessageSize;
         header->length = length;
+        if constexpr (kStatistics) {
+            header->statistics = QueueStatisticsBlock{};
+        }
     }
 };
 
@@ -101,16 +145,25 @@ class BoundedMPSCRawQueueProducer {
     using MessageHeader = typename QueueDetail::MessageHeader;
     using StateHeader = typename QueueDetail::StateHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::span<StateHeader> commitStates_;
     std::size_t producerPosCache_ = 0;
     std::size_t consumerPosCache_ = 0;
+    std::uint64_t claim_ = 0;
+    std::uint32_t lapShift_ = 0;
+    std::int32_t pid_ = 0;
+    [[no_unique_address]] QueueStatisticsCounter<QueueDetail::kStatistics, QueueDetail::kStatisticsInterval>
+        statistics_;
 
   public:
     BoundedMPSCRawQueueProducer() = default;
-    ~BoundedMPSCRawQueueProducer() = default;
+
+    /// Destructor. Publish pending statistics
+    ~BoundedMPSCRawQueueProducer() {
+        publishStatistics();
+    }
 
     BoundedMPSCRawQueueProducer(BoundedMPSCRawQueueProducer&& that) noexcept {
         swap(that);
@@ -121,26 +174,33 @@ class BoundedMPSCRawQueueProducer {
         return *this;
     }
 
-    BoundedMPSCRawQueueProducer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedMPSCRawQueueProducer(MappedRegion&& storage)
+        : BoundedMPSCRawQueueProducer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedMPSCRawQueueProducer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
         }
 
-        header_ = std::bit_cast<MemoryHeader*>(storage_.data());
+        header_ = std::bit_cast<MemoryHeader*>(storage_->data());
         std::size_t offset = QueueDetail::kDataStartPos;
 
-        data_ = std::span<std::byte>(storage_.data() + offset, header_->maxMessageSize * header_->length);
+        data_ = std::span<std::byte>(storage_->data() + offset, header_->maxMessageSize * header_->length);
         offset += (header_->maxMessageSize * header_->length);
 
-        commitStates_ = std::span<StateHeader>(std::bit_cast<StateHeader*>(storage_.data() + offset), header_->length);
+        commitStates_ = std::span<StateHeader>(std::bit_cast<StateHeader*>(storage_->data() + offset), header_->length);
         consumerPosCache_ = std::atomic_ref(header_->consumerPos).load(std::memory_order_acquire);
+        lapShift_ = std::countr_zero(header_->length);
+        // Producer created before fork() is owned by parent process
+        pid_ = ::getpid();
     }
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return queue max message size
@@ -168,23 +228,31 @@ class BoundedMPSCRawQueueProducer {
                 std::format("buffer exceed max message size ({} > {})", totalSize, header_->maxMessageSize));
         }
 
-        std::size_t currentProducerPos = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
-        if (currentProducerPos - consumerPosCache_ >= header_->length) [[unlikely]] {
-            consumerPosCache_ = std::atomic_ref(header_->consumerPos).load(std::memory_order_acquire);
+        std::size_t currentProducerPos;
+        do {
+            currentProducerPos = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
             if (currentProducerPos - consumerPosCache_ >= header_->length) [[unlikely]] {
-                return {};
+                consumerPosCache_ = std::atomic_ref(header_->consumerPos).load(std::memory_order_acquire);
+                if constexpr (QueueDetail::kStatistics) {
+                    statistics_.onOccupancy((currentProducerPos - consumerPosCache_) * header_->maxMessageSize);
+                }
+                if (currentProducerPos - consumerPosCache_ >= header_->length) [[unlikely]] {
+                    onFull();
+                    return {};
+                }
             }
-        }
 
-        while (!std::atomic_ref(header_->producerPos)
-                .compare_exchange_weak(currentProducerPos, currentProducerPos + 1, std::memory_order_release,
-                    std::memory_order_relaxed)) [[unlikely]] {
-            if (currentProducerPos - consumerPosCache_ >= header_->length) [[unlikely]] {
-                return {};
+            while (!std::atomic_ref(header_->producerPos)
+                    .compare_exchange_weak(currentProducerPos, currentProducerPos + 1, std::memory_order_release,
+                        std::memory_order_relaxed)) [[unlikely]] {
+                if (currentProducerPos - consumerPosCache_ >= header_->length) [[unlikely]] {
+                    onFull();
+                    return {};
+                }
             }
-        }
+            // Slot is skipped by consumer recover() on producer preempted before the claim, reserve the next position
+        } while (!claim(currentProducerPos));
 
-        producerPosCache_ = currentProducerPos & (header_->length - 1);
         std::byte* content = data_.data() + producerPosCache_ * header_->maxMessageSize;
         std::bit_cast<MessageHeader*>(content)->payloadSize = size;
 
@@ -192,8 +260,20 @@ class BoundedMPSCRawQueueProducer {
     }
 
     /// Make reserved buffer visible for consumers
+    /// Message is dropped on consumer reset() the queue since prepare()
     ROCKET_FORCE_INLINE void commit() noexcept {
-        std::atomic_ref(commitStates_[producerPosCache_].commited).store(true, std::memory_order_release);
+        auto expected = claim_;
+        if (!std::atomic_ref(commitStates_[producerPosCache_].state)
+                .compare_exchange_strong(expected,
+                    QueueDetail::makeSlotState(claim_ >> 32, QueueDetail::kSlotCommitted), std::memory_order_release,
+                    std::memory_order_relaxed)) [[unlikely]] {
+            return;
+        }
+        if constexpr (QueueDetail::kStatistics) {
+            auto const header =
+                std::bit_cast<MessageHeader const*>(data_.data() + producerPosCache_ * header_->maxMessageSize);
+            statistics_.onCommit(header_->statistics, header->payloadSize);
+        }
     }
 
     /// \overload
@@ -207,6 +287,15 @@ class BoundedMPSCRawQueueProducer {
         commit();
     }
 
+    /// Publish pending statistics (Traits::kStatistics), otherwise they are published each kStatisticsInterval events
+    void publishStatistics() noexcept {
+        if constexpr (QueueDetail::kStatistics) {
+            if (header_) {
+                statistics_.publish(header_->statistics);
+            }
+        }
+    }
+
     /// Swap resources with other producer
     void swap(BoundedMPSCRawQueueProducer& that) noexcept {
         using std::swap;
@@ -216,12 +305,33 @@ class BoundedMPSCRawQueueProducer {
         swap(commitStates_, that.commitStates_);
         swap(producerPosCache_, that.producerPosCache_);
         swap(consumerPosCache_, that.consumerPosCache_);
+        swap(claim_, that.claim_);
+        swap(lapShift_, that.lapShift_);
+        swap(pid_, that.pid_);
+        swap(statistics_, that.statistics_);
     }
 
     /// \see BoundedMPSCRawQueueProducer::swap
     friend void swap(BoundedMPSCRawQueueProducer& a, BoundedMPSCRawQueueProducer& b) noexcept {
         a.swap(b);
     }
+
+  private:
+    /// Claim the slot of reserved position, return false on the slot is skipped by consumer already
+    [[nodiscard]] ROCKET_FORCE_INLINE auto claim(std::size_t position) noexcept -> bool {
+        producerPosCache_ = position & (header_->length - 1);
+        auto const lap = position >> lapShift_;
+        auto expected = QueueDetail::makeSlotState(lap, QueueDetail::kSlotFree);
+        claim_ = QueueDetail::makeSlotState(lap, static_cast<std::uint32_t>(pid_));
+        return std::atomic_ref(commitStates_[producerPosCache_].state)
+            .compare_exchange_strong(expected, claim_, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    ROCKET_FORCE_INLINE void onFull() noexcept {
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onFull(header_->statistics);
+        }
+    }
 };
 
 /// Implements a MPSC queue consumer
@@ -233,7 +343,7 @@ class BoundedMPSCRawQueueConsumer {
     using MessageHeader = typename QueueDetail::MessageHeader;
     using StateHeader = typename QueueDetail::StateHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::span<StateHeader> commitStates_;
@@ -241,6 +351,9 @@ class BoundedMPSCRawQueueConsumer {
     std::size_t consumerPosCache_ = 0;
     MessageHeader* lastMessageHeader_ = nullptr;
     StateHeader* lastCommitState_ = nullptr;
+    std::uint32_t lapShift_ = 0;
+    std::size_t stalledPos_ = std::numeric_limits<std::size_t>::max();
+    std::chrono::steady_clock::time_point stalledSince_;
 
   public:
     BoundedMPSCRawQueueConsumer() = default;
@@ -255,28 +368,33 @@ class BoundedMPSCRawQueueConsumer {
         return *this;
     }
 
-    BoundedMPSCRawQueueConsumer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedMPSCRawQueueConsumer(MappedRegion&& storage)
+        : BoundedMPSCRawQueueConsumer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedMPSCRawQueueConsumer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
         }
 
-        header_ = std::bit_cast<MemoryHeader*>(storage_.data());
+        header_ = std::bit_cast<MemoryHeader*>(storage_->data());
 
         std::size_t offset = QueueDetail::kDataStartPos;
         data_ = std::span<std::byte>(content.data() + offset, header_->maxMessageSize * header_->length);
 
         offset += header_->maxMessageSize * header_->length;
-        commitStates_ = std::span<StateHeader>(std::bit_cast<StateHeader*>(storage_.data() + offset), header_->length);
+        commitStates_ = std::span<StateHeader>(std::bit_cast<StateHeader*>(storage_->data() + offset), header_->length);
 
         producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
         consumerPosCache_ = std::atomic_ref(header_->consumerPos).load(std::memory_order_acquire);
+        lapShift_ = std::countr_zero(header_->length);
     }
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return queue max message size
@@ -306,7 +424,8 @@ class BoundedMPSCRawQueueConsumer {
         std::size_t const consumerPos = consumerPosCache_ & (header_->length - 1);
 
         lastCommitState_ = &commitStates_[consumerPos];
-        if (!std::atomic_ref(lastCommitState_->commited).load(std::memory_order_acquire)) [[unlikely]] {
+        if (std::atomic_ref(lastCommitState_->state).load(std::memory_order_acquire) !=
+            QueueDetail::makeSlotState(consumerPosCache_ >> lapShift_, QueueDetail::kSlotCommitted)) [[unlikely]] {
             return {};
         }
 
@@ -317,23 +436,76 @@ class BoundedMPSCRawQueueConsumer {
     /// Consume front buffer and make buffer available for producer
     /// pre: fetch() -> non empty buffer
     ROCKET_FORCE_INLINE void consume() noexcept {
+        release(*lastCommitState_, consumerPosCache_);
         consumerPosCache_++;
-        std::atomic_ref(lastCommitState_->commited).store(false, std::memory_order_release);
         std::atomic_ref(header_->consumerPos).store(consumerPosCache_, std::memory_order_release);
     }
 
     /// Reset queue
+    /// Messages reserved and not committed yet are dropped, their producers find it on claim or commit
     ROCKET_FORCE_INLINE void reset() noexcept {
         while (consumerPosCache_ != producerPosCache_) {
             // Drop message.
             std::size_t const consumerPos = consumerPosCache_ & (header_->length - 1);
             lastCommitState_ = &commitStates_[consumerPos];
-            std::atomic_ref(lastCommitState_->commited).store(false, std::memory_order_release);
+            release(*lastCommitState_, consumerPosCache_);
             consumerPosCache_++;
         }
         std::atomic_ref(header_->consumerPos).store(consumerPosCache_, std::memory_order_release);
     }
 
+    /// Skip messages abandoned at the queue front, return number of messages skipped
+    /// Claimed slot is abandoned on its owner process is dead. Reserved slot not claimed within ownerTimeout (producer
+    /// died or is preempted right after reserving the position) is skipped with CAS, so the producer resumed later
+    /// fails to claim it and reserves the next position. Call it on fetch() returns empty buffer, e.g. on reattach or
+    /// idle. Producers have to share pid namespace with the consumer.
+    auto recover(std::chrono::nanoseconds ownerTimeout = std::chrono::seconds(1)) noexcept -> std::size_t {
+        std::size_t skipped = 0;
+        while (true) {
+            producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
+            if (consumerPosCache_ == producerPosCache_) {
+                break;
+            }
+
+            auto const lap = consumerPosCache_ >> lapShift_;
+            auto state = std::atomic_ref(commitStates_[consumerPosCache_ & (header_->length - 1)].state);
+            auto current = state.load(std::memory_order_acquire);
+            auto const claim = QueueDetail::getSlotClaim(current);
+            if (claim == QueueDetail::kSlotCommitted) {
+                break;
+            }
+            if (claim != QueueDetail::kSlotFree) {
+                if (isProcessAlive(static_cast<std::int32_t>(claim))) {
+                    break;
+                }
+            } else {
+                auto const now = std::chrono::steady_clock::now();
+                if (stalledPos_ != consumerPosCache_) {
+                    stalledPos_ = consumerPosCache_;
+                    stalledSince_ = now;
+                }
+                if (now - stalledSince_ < ownerTimeout) {
+                    break;
+                }
+            }
+
+            // Fails on the producer claimed the slot meanwhile, the slot is checked again
+            if (!state.compare_exchange_strong(current, QueueDetail::makeSlotState(lap + 1, QueueDetail::kSlotFree),
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                continue;
+            }
+            consumerPosCache_++;
+            std::atomic_ref(header_->consumerPos).store(consumerPosCache_, std::memory_order_release);
+            ++skipped;
+        }
+
+        if (skipped > 0) {
+            auto abandoned = std::atomic_ref(header_->abandoned);
+            abandoned.store(abandoned.load(std::memory_order_relaxed) + skipped, std::memory_order_relaxed);
+        }
+        return skipped;
+    }
+
     /// Swap resources with other object
     void swap(BoundedMPSCRawQueueConsumer& that) noexcept {
         using std::swap;
@@ -345,12 +517,89 @@ class BoundedMPSCRawQueueConsumer {
         swap(consumerPosCache_, that.consumerPosCache_);
         swap(lastMessageHeader_, that.lastMessageHeader_);
         swap(lastCommitState_, that.lastCommitState_);
+        swap(lapShift_, that.lapShift_);
+        swap(stalledPos_, that.stalledPos_);
+        swap(stalledSince_, that.stalledSince_);
     }
 
     /// \see BoundedMPSCRawQueueConsumer::swap
     friend void swap(BoundedMPSCRawQueueConsumer& a, BoundedMPSCRawQueueConsumer& b) noexcept {
         a.swap(b);
     }
+
+  private:
+    /// Make the slot of position free for the position of the next lap
+    ROCKET_FORCE_INLINE void release(StateHeader& slot, std::size_t position) noexcept {
+        std::atomic_ref(slot.state).store(
+            QueueDetail::makeSlotState((position >> lapShift_) + 1, QueueDetail::kSlotFree), std::memory_order_release);
+    }
+};
+
+/// Read-only MPSC queue observer
+/// Maps memory header only and never writes, so producers and consumer are not disturbed beyond cache line sharing
+/// on sampling
+template <typename Traits>
+class BoundedMPSCRawQueueObserver {
+  private:
+    using QueueDetail = BoundedMPSCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+
+    MappedRegion storage_;
+    MemoryHeader const* header_ = nullptr;
+
+  public:
+    BoundedMPSCRawQueueObserver() = default;
+
+    /// Construct over mapped memory header
+    explicit BoundedMPSCRawQueueObserver(MappedRegion&& storage) : storage_(std::move(storage)) {
+        if (storage_.size() < sizeof(MemoryHeader) || !QueueDetail::check(storage_.content())) {
+            throw std::runtime_error("invalid queue");
+        }
+        header_ = std::bit_cast<MemoryHeader const*>(storage_.data());
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return static_cast<bool>(storage_);
+    }
+
+    /// Queue max message size
+    [[nodiscard]] auto maxMessageSize() const noexcept -> std::size_t {
+        return header_->maxMessageSize;
+    }
+
+    /// Queue length (max messages count)
+    [[nodiscard]] auto length() const noexcept -> std::size_t {
+        return header_->length;
+    }
+
+    /// Producer position (messages reserved)
+    [[nodiscard]] auto producerPos() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->producerPos)).load(std::memory_order_acquire);
+    }
+
+    /// Consumer position (messages consumed)
+    [[nodiscard]] auto consumerPos() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->consumerPos)).load(std::memory_order_acquire);
+    }
+
+    /// Messages reserved by producers and not consumed yet
+    [[nodiscard]] auto occupancy() const noexcept -> std::size_t {
+        auto const consumerPos = this->consumerPos();
+        return this->producerPos() - consumerPos;
+    }
+
+    /// Messages abandoned by dead producers and skipped by consumer
+    [[nodiscard]] auto abandoned() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->abandoned)).load(std::memory_order_relaxed);
+    }
+
+    /// Statistics published by producers
+    [[nodiscard]] auto statistics() const noexcept -> QueueStatistics
+        requires(QueueDetail::kStatistics)
+    {
+        return header_->statistics.load();
+    }
 };
 
 } // namespace detail
@@ -366,6 +615,15 @@ struct BoundedMPSCRawQueueDefaultTraits {
 
 using BoundedMPSCRawQueue = BoundedMPSCRawQueueImpl<BoundedMPSCRawQueueDefaultTraits>;
 
+/// Default traits with statistics enabled
+/// Tag differs from the default one at non-prefix position, queues of different layout never match each other
+struct BoundedMPSCRawQueueStatisticsTraits : BoundedMPSCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/stats/MPSC";
+    static constexpr bool kStatistics = true;
+};
+
+using BoundedMPSCRawQueueWithStatistics = BoundedMPSCRawQueueImpl<BoundedMPSCRawQueueStatisticsTraits>;
+
 template <typename Traits>
 class BoundedMPSCRawQueueImpl {
   private:
@@ -375,10 +633,14 @@ class BoundedMPSCRawQueueImpl {
     using StateHeader = typename QueueDetail::StateHeader;
 
     File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
 
   public:
     using Producer = detail::BoundedMPSCRawQueueProducer<Traits>;
     using Consumer = detail::BoundedMPSCRawQueueConsumer<Traits>;
+    using Observer = detail::BoundedMPSCRawQueueObserver<Traits>;
 
     struct CreationOptions {
         std::size_t maxMessageSizeHint;
@@ -399,7 +661,9 @@ class BoundedMPSCRawQueueImpl {
     }
 
     /// Open only queue. Throws on error.
-    BoundedMPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) {
+    BoundedMPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         auto result = memorySource.open(name, MemorySource::OpenOnly);
         if (!result) {
             throw std::runtime_error("failed to open memory source");
@@ -408,14 +672,16 @@ class BoundedMPSCRawQueueImpl {
         std::size_t pageSize;
         std::tie(file_, pageSize) = std::move(result).value();
 
-        if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!QueueDetail::check(storage_->content())) {
             throw std::runtime_error("failed to open queue (invalid)");
         }
     }
 
     /// Open or create queue. Throws on error.
     BoundedMPSCRawQueueImpl(std::string_view name, CreationOptions const& options,
-        MemorySource const& memorySource = DefaultMemorySource()) {
+        MemorySource const& memorySource = DefaultMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         if (options.maxMessageSizeHint == 0) {
             throw std::runtime_error("invalid argument (max message size)");
         }
@@ -442,12 +708,14 @@ class BoundedMPSCRawQueueImpl {
             if (fileSize != capacity) {
                 throw std::runtime_error("size mismatch");
             }
-            if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!QueueDetail::check(storage_->content())) {
                 throw std::runtime_error("failed to open queue (invalid)");
             }
         } else {
             file_.truncate(capacity);
-            QueueDetail::init(detail::mapFile(file_, capacity).content(), maxMessageSize, length);
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            QueueDetail::init(storage_->content(), maxMessageSize, length);
         }
     }
 
@@ -456,12 +724,17 @@ class BoundedMPSCRawQueueImpl {
         return static_cast<bool>(file_);
     }
 
+    /// Result of applying mapping options to the queue mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
     /// Create producer for the queue. Throws on error.
     [[nodiscard]] ROCKET_FORCE_INLINE auto createProducer() -> Producer {
         if (!operator bool()) {
             throw std::runtime_error("queue in not initialized");
         }
-        return Producer(detail::mapFile(file_));
+        return Producer(storage_);
     }
 
     /// Create consumer for the queue. Throws on error.
@@ -472,13 +745,40 @@ class BoundedMPSCRawQueueImpl {
         if (!file_.tryLock()) {
             throw std::runtime_error("can't create consumer (already exists?)");
         }
-        return Consumer(detail::mapFile(file_));
+        return Consumer(storage_);
+    }
+
+    /// Create read-only observer for the queue. Throws on error.
+    [[nodiscard]] auto createObserver() const -> Observer {
+        if (!operator bool()) {
+            throw std::runtime_error("queue in not initialized");
+        }
+        return Observer(detail::mapReadOnly(file_, sizeof(MemoryHeader)));
+    }
+
+    /// Open read-only observer of existing queue without opening the queue itself (e.g. by monitoring process)
+    /// Maps memory header only, read-only and without prefault. Throws on error.
+    [[nodiscard]] static auto openObserver(
+        std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) -> Observer {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+        auto const [file, pageSize] = std::move(result).value();
+        auto const fileSize = file.getFileSize();
+        if (fileSize < sizeof(MemoryHeader)) {
+            throw std::runtime_error("invalid queue");
+        }
+        return Observer(detail::mapReadOnly(file, sizeof(MemoryHeader)));
     }
 
     /// Swap resources with other queue.
     void swap(BoundedMPSCRawQueueImpl& that) noexcept {
         using std::swap;
         swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
     }
 
     /// \see BoundedMPSCRawQueueImpl::swap
@@ -1,8 +1,13 @@
 // Copyright (c) Sergey Kovalevich <inndie@gmail.com>
 // SPDX-License-Identifier: AGPL-3.0
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <string>
 
 #include <doctest/doctest.h>
@@ -59,4 +64,137 @@ TEST_CASE("BoundedMPSCRawQueue: basic") {
     REQUIRE(value == std::uint64_t(-1));
 }
 
+TEST_CASE("BoundedMPSCRawQueue: statistics") {
+    using Queue = BoundedMPSCRawQueueWithStatistics;
+    Queue queue("test", Queue::CreationOptions(sizeof(std::uint64_t), 4), AnonymousMemorySource());
+
+    auto observer = queue.createObserver();
+    REQUIRE(observer.length() == 4);
+
+    auto consumer = queue.createConsumer();
+    {
+        auto producer = queue.createProducer();
+        for (std::uint64_t i = 0; i < 4; ++i) {
+            REQUIRE(enqueue(producer, i));
+        }
+        REQUIRE(!enqueue(producer, std::uint64_t(4)));
+        REQUIRE(observer.occupancy() == 4);
+    }
+
+    auto const statistics = observer.statistics();
+    REQUIRE(statistics.messages == 4);
+    REQUIRE(statistics.bytes == 4 * sizeof(std::uint64_t));
+    REQUIRE(statistics.fullEvents == 1);
+    REQUIRE(statistics.highWaterMark == 4 * observer.maxMessageSize());
+
+    std::uint64_t value = 0;
+    while (dequeue(consumer, value)) {}
+    REQUIRE(observer.occupancy() == 0);
+}
+
+TEST_CASE("BoundedMPSCRawQueue: standalone observer") {
+    using Queue = BoundedMPSCRawQueueWithStatistics;
+    auto const name = "rocket-mpsc-observer-test-" + std::to_string(::getpid());
+    auto const memorySource = DefaultMemorySource();
+
+    {
+        Queue queue(name, Queue::CreationOptions(sizeof(std::uint64_t), 4), memorySource);
+        auto producer = queue.createProducer();
+        REQUIRE(enqueue(producer, std::uint64_t(1)));
+
+        auto observer = Queue::openObserver(name, memorySource);
+        REQUIRE(observer.length() == 4);
+        REQUIRE(observer.occupancy() == 1);
+
+        REQUIRE_THROWS(BoundedMPSCRawQueue(name, memorySource));
+        REQUIRE_THROWS(BoundedMPSCRawQueue::openObserver(name, memorySource));
+    }
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("BoundedMPSCRawQueue: recover abandoned slot") {
+    BoundedMPSCRawQueue queue(
+        "test", BoundedMPSCRawQueue::CreationOptions(sizeof(std::uint64_t), 4), AnonymousMemorySource());
+    auto observer = queue.createObserver();
+    auto consumer = queue.createConsumer();
+    auto producer = queue.createProducer();
+
+    REQUIRE(enqueue(producer, std::uint64_t(1)));
+
+    // Producer process dies between prepare() and commit()
+    auto const pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        auto childProducer = queue.createProducer();
+        [[maybe_unused]] auto const buffer = childProducer.prepare(sizeof(std::uint64_t));
+        ::_exit(0);
+    }
+    int status = 0;
+    REQUIRE(::waitpid(pid, &status, 0) == pid);
+
+    REQUIRE(enqueue(producer, std::uint64_t(2)));
+
+    // Live producer slot is never skipped
+    auto buffer = producer.prepare(sizeof(std::uint64_t));
+    REQUIRE(!buffer.empty());
+
+    std::uint64_t value = 0;
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 1);
+    REQUIRE(!dequeue(consumer, value));
+
+    REQUIRE(consumer.recover() == 1);
+    REQUIRE(observer.abandoned() == 1);
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 2);
+
+    REQUIRE(!dequeue(consumer, value));
+    REQUIRE(consumer.recover(std::chrono::nanoseconds(0)) == 0);
+
+    *std::bit_cast<std::uint64_t*>(buffer.data()) = 3;
+    producer.commit();
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 3);
+    REQUIRE(observer.occupancy() == 0);
+}
+
+TEST_CASE("BoundedMPSCRawQueue: commit after reset") {
+    BoundedMPSCRawQueue queue(
+        "test", BoundedMPSCRawQueue::CreationOptions(sizeof(std::uint64_t), 2), AnonymousMemorySource());
+    auto consumer = queue.createConsumer();
+    auto producer = queue.createProducer();
+
+    REQUIRE(enqueue(producer, std::uint64_t(1)));
+    auto buffer = producer.prepare(sizeof(std::uint64_t));
+    REQUIRE(!buffer.empty());
+    std::uint64_t value = 0;
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 1);
+    consumer.reset();
+
+    // Reserved message is dropped by reset, late commit doesn't mark the slot of the next lap
+    *std::bit_cast<std::uint64_t*>(buffer.data()) = 2;
+    producer.commit();
+    REQUIRE(!dequeue(consumer, value));
+
+    REQUIRE(enqueue(producer, std::uint64_t(3)));
+    buffer = producer.prepare(sizeof(std::uint64_t));
+    REQUIRE(!buffer.empty());
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 3);
+    REQUIRE(!dequeue(consumer, value));
+    *std::bit_cast<std::uint64_t*>(buffer.data()) = 4;
+    producer.commit();
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 4);
+
+    for (std::uint64_t i = 5; i < 9; ++i) {
+        REQUIRE(enqueue(producer, i));
+        REQUIRE(dequeue(consumer, value));
+        REQUIRE(value == i);
+        REQUIRE(!dequeue(consumer, value));
+    }
+}
+
 } // namespace rocket::testing
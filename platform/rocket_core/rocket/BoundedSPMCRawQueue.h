@@ -3,24 +3,103 @@
 
 #pragma once
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <atomic>
 #include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <span>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include "MappedRegion.h"
 #include "MemorySource.h"
 #include "Platform.h"
+#include "QueueStatistics.h"
+#include "ThreadUtils.h"
 #include "detail/math.h"
 #include "detail/memory.h"
 
 namespace rocket {
 namespace detail {
 
+/// Number of SPMC consumer groups (Traits::kConsumerGroups), zero on groups disabled
+template <typename Traits>
+[[nodiscard]] constexpr auto getSPMCConsumerGroups() noexcept -> std::size_t {
+    if constexpr (requires { Traits::kConsumerGroups; }) {
+        return Traits::kConsumerGroups;
+    } else {
+        return 0;
+    }
+}
+
+/// Claim cursor shared by members of SPMC consumer group, placed into own cache line
+/// Claim sequence is packed above data offset, so cursor value is not repeated by laps of the ring (ABA)
+struct alignas(kHardwareDestructiveInterferenceSize) SPMCConsumerGroupCursor {
+    static constexpr unsigned kOffsetBits = 40;
+    static constexpr std::uint64_t kOffsetMask = (std::uint64_t(1) << kOffsetBits) - 1;
+
+    std::uint64_t value;
+
+    static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+
+    /// Data offset of cursor value
+    [[nodiscard]] static constexpr auto offset(std::uint64_t value) noexcept -> std::size_t {
+        return value & kOffsetMask;
+    }
+
+    /// Cursor value following the value claimed up to the offset
+    [[nodiscard]] static constexpr auto next(std::uint64_t value, std::size_t offset) noexcept -> std::uint64_t {
+        return (((value >> kOffsetBits) + 1) << kOffsetBits) | offset;
+    }
+};
+
+/// Consumer group cursors of queue memory header
+template <std::size_t Count>
+struct SPMCConsumerGroupCursors {
+    SPMCConsumerGroupCursor cursors[Count];
+};
+
+template <>
+struct SPMCConsumerGroupCursors<0> {};
+
+/// Number of SPMC consumer registration slots (Traits::kConsumerSlots), zero on backpressure disabled
+template <typename Traits>
+[[nodiscard]] constexpr auto getSPMCConsumerSlots() noexcept -> std::size_t {
+    if constexpr (requires { Traits::kConsumerSlots; }) {
+        return Traits::kConsumerSlots;
+    } else {
+        return 0;
+    }
+}
+
+/// Registered SPMC consumer position, placed into own cache line
+/// Written by the consumer on consume, read by the producer on rescan only
+struct alignas(kHardwareDestructiveInterferenceSize) SPMCConsumerSlot {
+    /// Consumer position
+    std::size_t pos;
+    /// Pid of consumer process, zero on slot is free
+    std::int32_t owner;
+
+    static_assert(std::atomic_ref<std::int32_t>::is_always_lock_free);
+};
+
+/// Consumer registration table of queue memory header
+template <std::size_t Count>
+struct SPMCConsumerSlots {
+    SPMCConsumerSlot slots[Count];
+};
+
+template <>
+struct SPMCConsumerSlots<0> {};
+
 /// SPMC queue detail
 template <typename Traits>
 struct BoundedSPMCRawQueueDetail {
@@ -30,13 +109,27 @@ struct BoundedSPMCRawQueueDetail {
     static constexpr std::size_t kSegmentSize = Traits::kSegmentSize;
     /// Alignment
     static constexpr std::size_t kAlign = Traits::kAlign;
+    /// Statistics enabled (messages and bytes only, producer never blocks)
+    static constexpr bool kStatistics = QueueStatisticsTraits<Traits>;
+    /// Producer events between statistics publications
+    static constexpr std::size_t kStatisticsInterval = getQueueStatisticsInterval<Traits>();
+    /// Consumer groups count
+    static constexpr std::size_t kConsumerGroups = getSPMCConsumerGroups<Traits>();
+    /// Consumer registration slots count, producer never overwrites registered consumers on nonzero
+    static constexpr std::size_t kConsumerSlots = getSPMCConsumerSlots<Traits>();
 
     /// Control struct for queue buffer
     struct MemoryHeader {
-        /// Placeholder for queue tag
-        char tag[kTag.size()];
+        /// Placeholder for queue tag, NUL-terminated so a tag never matches a longer one sharing its prefix
+        char tag[kTag.size() + 1];
         /// Producer position
         alignas(kAlign) std::size_t producerPos;
+        /// Statistics (own cache line, empty on disabled)
+        [[no_unique_address]] QueueStatisticsStorage<kStatistics> statistics;
+        /// Consumer group cursors (own cache line each, empty on disabled)
+        [[no_unique_address]] SPMCConsumerGroupCursors<kConsumerGroups> groups;
+        /// Registered consumers (own cache line each, empty on disabled)
+        [[no_unique_address]] SPMCConsumerSlots<kConsumerSlots> consumers;
 
         static_assert(std::atomic_ref<std::size_t>::is_always_lock_free);
     };
@@ -61,6 +154,11 @@ struct BoundedSPMCRawQueueDetail {
     /// Min buffer size
     static constexpr std::size_t kMinBufferSize = kDataStartPos + 2 * kSegmentSize;
 
+    /// Return true on header tagged with the queue tag (full tag field compared)
+    [[nodiscard]] static auto checkTag(MemoryHeader const* header) noexcept -> bool {
+        return std::equal(kTag.begin(), kTag.end(), header->tag) && header->tag[kTag.size()] == '\0';
+    }
+
     /// Check buffer points to valid SPMC queue region
     /// Return true on success and false otherwise.
     [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
@@ -68,9 +166,14 @@ struct BoundedSPMCRawQueueDetail {
             return false;
         }
         auto const header = std::bit_cast<MemoryHeader const*>(buffer.data());
-        if (!std::equal(kTag.begin(), kTag.end(), header->tag)) {
+        if (!checkTag(header)) {
             return false;
         }
+        if constexpr (kConsumerGroups > 0) {
+            if (buffer.size() - kDataStartPos > SPMCConsumerGroupCursor::kOffsetMask) {
+                return false;
+            }
+        }
         return true;
     }
 
@@ -78,6 +181,22 @@ struct BoundedSPMCRawQueueDetail {
     static void init(std::span<std::byte> buffer) noexcept {
         auto header = std::bit_cast<MemoryHeader*>(buffer.data());
         std::copy(kTag.begin(), kTag.end(), header->tag);
+        header->tag[kTag.size()] = '\0';
+        if constexpr (kStatistics) {
+            header->statistics = QueueStatisticsBlock{};
+        }
+        if constexpr (kConsumerGroups > 0) {
+            header->groups = SPMCConsumerGroupCursors<kConsumerGroups>{};
+        }
+        if constexpr (kConsumerSlots > 0) {
+            header->consumers = SPMCConsumerSlots<kConsumerSlots>{};
+        }
+    }
+
+    /// Bytes written by producer and not consumed yet by the consumer
+    [[nodiscard]] static constexpr auto occupancy(
+        std::size_t producerPos, std::size_t consumerPos, std::size_t dataSize) noexcept -> std::size_t {
+        return (producerPos >= consumerPos) ? (producerPos - consumerPos) : (dataSize - consumerPos + producerPos);
     }
 };
 
@@ -89,15 +208,24 @@ class BoundedSPMCRawQueueProducer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     std::span<std::byte> data_;
     MemoryHeader* header_ = nullptr;
     std::size_t producerPosCache_ = 0;
     MessageHeader* lastMessageHeader_ = nullptr;
+    /// Space available up to the slowest registered consumer (backpressure)
+    std::size_t minFreeSpace_ = 0;
+    std::size_t fullEvents_ = 0;
+    [[no_unique_address]] QueueStatisticsCounter<QueueDetail::kStatistics, QueueDetail::kStatisticsInterval>
+        statistics_;
 
   public:
     BoundedSPMCRawQueueProducer() = default;
-    ~BoundedSPMCRawQueueProducer() = default;
+
+    /// Destructor. Publish pending statistics
+    ~BoundedSPMCRawQueueProducer() {
+        publishStatistics();
+    }
 
     BoundedSPMCRawQueueProducer(BoundedSPMCRawQueueProducer&& that) noexcept {
         swap(that);
@@ -108,30 +236,39 @@ class BoundedSPMCRawQueueProducer {
         return *this;
     }
 
-    BoundedSPMCRawQueueProducer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPMCRawQueueProducer(MappedRegion&& storage)
+        : BoundedSPMCRawQueueProducer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPMCRawQueueProducer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
         }
 
-        header_ = std::bit_cast<MemoryHeader*>(storage_.data());
+        header_ = std::bit_cast<MemoryHeader*>(storage_->data());
         data_ = content.subspan(QueueDetail::kDataStartPos);
         producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
     }
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return queue capacity (bytes)
     [[nodiscard]] ROCKET_FORCE_INLINE auto capacity() const noexcept -> std::size_t {
-        return storage_.size();
+        return storage_->size();
     }
 
     /// Reserve contiguous space for writing without making it visible to the consumers
+    /// Return empty buffer on the slowest registered consumer has no space for the message (kConsumerSlots)
     [[nodiscard]] ROCKET_FORCE_INLINE auto prepare(std::size_t size) noexcept -> std::span<std::byte> {
+        if constexpr (QueueDetail::kConsumerSlots > 0) {
+            return prepareBounded(size);
+        }
+
         std::size_t const alignedSize = QueueDetail::alignBufferSize(size + sizeof(MessageHeader));
 
         lastMessageHeader_ = std::bit_cast<MessageHeader*>(data_.data() + producerPosCache_);
@@ -156,6 +293,9 @@ class BoundedSPMCRawQueueProducer {
     /// Make reserved buffer visible for consumers
     ROCKET_FORCE_INLINE void commit() noexcept {
         std::atomic_ref(header_->producerPos).store(producerPosCache_, std::memory_order_release);
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onCommit(header_->statistics, lastMessageHeader_->payloadSize);
+        }
     }
 
     /// \overload
@@ -169,6 +309,15 @@ class BoundedSPMCRawQueueProducer {
         commit();
     }
 
+    /// Publish pending statistics (Traits::kStatistics), otherwise they are published each kStatisticsInterval events
+    void publishStatistics() noexcept {
+        if constexpr (QueueDetail::kStatistics) {
+            if (header_) {
+                statistics_.publish(header_->statistics);
+            }
+        }
+    }
+
     /// Swap resources with other producer
     void swap(BoundedSPMCRawQueueProducer& that) noexcept {
         using std::swap;
@@ -177,12 +326,113 @@ class BoundedSPMCRawQueueProducer {
         swap(header_, that.header_);
         swap(producerPosCache_, that.producerPosCache_);
         swap(lastMessageHeader_, that.lastMessageHeader_);
+        swap(minFreeSpace_, that.minFreeSpace_);
+        swap(fullEvents_, that.fullEvents_);
+        swap(statistics_, that.statistics_);
     }
 
     /// \see BoundedSPMCRawQueueProducer::swap
     friend void swap(BoundedSPMCRawQueueProducer& a, BoundedSPMCRawQueueProducer& b) noexcept {
         a.swap(b);
     }
+
+  private:
+    /// Full events in a row between liveness checks of registered consumers
+    static constexpr std::size_t kLivenessCheckInterval = 1024;
+
+    /// Reserve space not overwriting registered consumers, consumers are rescanned on cached free space exhausted
+    ROCKET_FORCE_INLINE auto prepareBounded(std::size_t size) noexcept -> std::span<std::byte> {
+        std::size_t const alignedSize = QueueDetail::alignBufferSize(size + sizeof(MessageHeader));
+        if (alignedSize <= minFreeSpace_) [[likely]] {
+            return place(size, alignedSize);
+        }
+
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            auto const slowestPos = getSlowestConsumerPos();
+            if (slowestPos && *slowestPos > producerPosCache_) {
+                // queue is empty in case of consumerPos == producerPos
+                minFreeSpace_ = *slowestPos - producerPosCache_ - 1;
+            } else {
+                minFreeSpace_ = data_.size() - producerPosCache_ - sizeof(MessageHeader);
+            }
+            if (alignedSize <= minFreeSpace_) [[likely]] {
+                fullEvents_ = 0;
+                return place(size, alignedSize);
+            }
+
+            // Payload from beginning, message header stays at the end
+            if (!slowestPos || *slowestPos <= producerPosCache_) {
+                std::size_t const alignedSize2 = QueueDetail::alignBufferSize(size);
+                auto const limit = slowestPos ? *slowestPos : data_.size() - sizeof(MessageHeader) + 1;
+                if (alignedSize2 < limit) {
+                    lastMessageHeader_ = std::bit_cast<MessageHeader*>(data_.data() + producerPosCache_);
+                    lastMessageHeader_->size = alignedSize2;
+                    lastMessageHeader_->payloadSize = size;
+                    lastMessageHeader_->payloadOffset = 0;
+                    producerPosCache_ = alignedSize2;
+                    minFreeSpace_ = limit - producerPosCache_ - 1;
+                    fullEvents_ = 0;
+                    return data_.subspan(0, size);
+                }
+            }
+
+            // Consumer died without detaching keeps the queue full, checked on stall and each interval of it
+            if (attempt > 0 || fullEvents_++ % kLivenessCheckInterval != 0 || !releaseDeadConsumers()) {
+                break;
+            }
+        }
+
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onFull(header_->statistics);
+        }
+        return {};
+    }
+
+    ROCKET_FORCE_INLINE auto place(std::size_t size, std::size_t alignedSize) noexcept -> std::span<std::byte> {
+        lastMessageHeader_ = std::bit_cast<MessageHeader*>(data_.data() + producerPosCache_);
+        lastMessageHeader_->size = alignedSize - sizeof(MessageHeader);
+        lastMessageHeader_->payloadSize = size;
+        lastMessageHeader_->payloadOffset = producerPosCache_ + sizeof(MessageHeader);
+        producerPosCache_ += alignedSize;
+        minFreeSpace_ -= alignedSize;
+        return data_.subspan(lastMessageHeader_->payloadOffset, lastMessageHeader_->payloadSize);
+    }
+
+    /// Position of registered consumer with max occupancy, std::nullopt on no consumers registered
+    auto getSlowestConsumerPos() noexcept -> std::optional<std::size_t> {
+        // Pairs with consumer attach: either consumer sees producer position or producer sees consumer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::optional<std::size_t> result;
+        std::size_t maxOccupancy = 0;
+        for (auto& slot : header_->consumers.slots) {
+            if (std::atomic_ref(slot.owner).load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            auto const pos = std::atomic_ref(slot.pos).load(std::memory_order_acquire);
+            auto const occupancy = QueueDetail::occupancy(producerPosCache_, pos, data_.size());
+            if (!result || occupancy > maxOccupancy) {
+                result = pos;
+                maxOccupancy = occupancy;
+            }
+        }
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onOccupancy(maxOccupancy);
+        }
+        return result;
+    }
+
+    /// Detach consumers of dead processes, return true on any detached
+    auto releaseDeadConsumers() noexcept -> bool {
+        bool released = false;
+        for (auto& slot : header_->consumers.slots) {
+            auto owner = std::atomic_ref(slot.owner).load(std::memory_order_acquire);
+            if (owner != 0 && !isProcessAlive(owner)) {
+                released |= std::atomic_ref(slot.owner).compare_exchange_strong(owner, 0, std::memory_order_acq_rel);
+            }
+        }
+        return released;
+    }
 };
 
 /// Implements a SPMC queue consumer
@@ -193,16 +443,23 @@ class BoundedSPMCRawQueueConsumer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     std::span<std::byte> data_;
     MemoryHeader* header_ = nullptr;
     std::size_t consumerPosCache_ = 0;
     std::size_t producerPosCache_ = 0;
     MessageHeader* lastMessageHeader_ = nullptr;
+    SPMCConsumerSlot* slot_ = nullptr;
 
   public:
     BoundedSPMCRawQueueConsumer() = default;
-    ~BoundedSPMCRawQueueConsumer() = default;
+
+    /// Destructor. Detach from producer (kConsumerSlots)
+    ~BoundedSPMCRawQueueConsumer() {
+        if (slot_) {
+            std::atomic_ref(slot_->owner).store(0, std::memory_order_release);
+        }
+    }
 
     BoundedSPMCRawQueueConsumer(BoundedSPMCRawQueueConsumer&& that) noexcept {
         swap(that);
@@ -213,8 +470,12 @@ class BoundedSPMCRawQueueConsumer {
         return *this;
     }
 
-    BoundedSPMCRawQueueConsumer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPMCRawQueueConsumer(MappedRegion&& storage)
+        : BoundedSPMCRawQueueConsumer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPMCRawQueueConsumer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
@@ -222,18 +483,22 @@ class BoundedSPMCRawQueueConsumer {
 
         header_ = std::bit_cast<MemoryHeader*>(content.data());
         data_ = content.subspan(QueueDetail::kDataStartPos);
-        consumerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_relaxed);
-        producerPosCache_ = consumerPosCache_;
+        if constexpr (QueueDetail::kConsumerSlots > 0) {
+            attach();
+        } else {
+            consumerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_relaxed);
+            producerPosCache_ = consumerPosCache_;
+        }
     }
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return queue capacity
     [[nodiscard]] ROCKET_FORCE_INLINE auto capacity() const noexcept -> std::size_t {
-        return storage_.size();
+        return storage_->size();
     }
 
     /// Get next buffer for reading. Return empty buffer in case of no data.
@@ -252,12 +517,18 @@ class BoundedSPMCRawQueueConsumer {
     /// pre: fetch() -> non empty buffer
     ROCKET_FORCE_INLINE void consume() noexcept {
         consumerPosCache_ = lastMessageHeader_->payloadOffset + lastMessageHeader_->size;
+        if constexpr (QueueDetail::kConsumerSlots > 0) {
+            std::atomic_ref(slot_->pos).store(consumerPosCache_, std::memory_order_release);
+        }
     }
 
     /// Reset queue
     ROCKET_FORCE_INLINE void reset() noexcept {
         consumerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_relaxed);
         producerPosCache_ = consumerPosCache_;
+        if constexpr (QueueDetail::kConsumerSlots > 0) {
+            std::atomic_ref(slot_->pos).store(consumerPosCache_, std::memory_order_release);
+        }
     }
 
     /// Swap resources with other object
@@ -269,12 +540,245 @@ class BoundedSPMCRawQueueConsumer {
         swap(consumerPosCache_, that.consumerPosCache_);
         swap(producerPosCache_, that.producerPosCache_);
         swap(lastMessageHeader_, that.lastMessageHeader_);
+        swap(slot_, that.slot_);
     }
 
     /// \see BoundedSPMCRawQueueConsumer::swap
     friend void swap(BoundedSPMCRawQueueConsumer& a, BoundedSPMCRawQueueConsumer& b) noexcept {
         a.swap(b);
     }
+
+  private:
+    /// Register consumer position, so producer never overwrites messages not consumed yet
+    void attach() {
+        auto const pid = static_cast<std::int32_t>(::getpid());
+        for (auto& slot : header_->consumers.slots) {
+            std::int32_t expected = 0;
+            if (std::atomic_ref(slot.owner).load(std::memory_order_relaxed) == 0 &&
+                std::atomic_ref(slot.owner).compare_exchange_strong(expected, pid, std::memory_order_acq_rel)) {
+                slot_ = &slot;
+                break;
+            }
+        }
+        if (!slot_) {
+            throw std::runtime_error("can't create consumer (no free consumer slot)");
+        }
+
+        // Producer rescanning consumers later sees the slot, producer position read after is protected
+        std::atomic_ref(slot_->pos).store(
+            std::atomic_ref(header_->producerPos).load(std::memory_order_acquire), std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        consumerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
+        producerPosCache_ = consumerPosCache_;
+        std::atomic_ref(slot_->pos).store(consumerPosCache_, std::memory_order_release);
+    }
+};
+
+/// Implements a SPMC consumer group member
+/// Members of the group share one claim cursor, so each message is delivered to exactly one of them
+template <typename Traits>
+class BoundedSPMCRawQueueGroupConsumer {
+  private:
+    using QueueDetail = BoundedSPMCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+    using MessageHeader = typename QueueDetail::MessageHeader;
+    using Cursor = SPMCConsumerGroupCursor;
+
+    std::shared_ptr<MappedRegion> storage_;
+    std::span<std::byte> data_;
+    MemoryHeader* header_ = nullptr;
+    std::uint64_t* cursor_ = nullptr;
+    std::uint64_t cursorCache_ = 0;
+    std::size_t producerPosCache_ = 0;
+    MessageHeader* lastMessageHeader_ = nullptr;
+
+  public:
+    BoundedSPMCRawQueueGroupConsumer() = default;
+    ~BoundedSPMCRawQueueGroupConsumer() = default;
+
+    BoundedSPMCRawQueueGroupConsumer(BoundedSPMCRawQueueGroupConsumer&& that) noexcept {
+        swap(that);
+    }
+
+    BoundedSPMCRawQueueGroupConsumer& operator=(BoundedSPMCRawQueueGroupConsumer&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Construct group member over a region shared with other queue handles of the process
+    /// The first member of the group starts at producer position like broadcast consumers, the others continue the
+    /// group cursor
+    BoundedSPMCRawQueueGroupConsumer(std::shared_ptr<MappedRegion> storage, std::size_t group)
+        : storage_(std::move(storage)) {
+        auto content = storage_->content();
+
+        if (!QueueDetail::check(content)) {
+            throw std::runtime_error("invalid queue");
+        }
+        if (group >= QueueDetail::kConsumerGroups) {
+            throw std::runtime_error("invalid argument (group)");
+        }
+
+        header_ = std::bit_cast<MemoryHeader*>(content.data());
+        data_ = content.subspan(QueueDetail::kDataStartPos);
+        cursor_ = &header_->groups.cursors[group].value;
+        cursorCache_ = std::atomic_ref(*cursor_).load(std::memory_order_acquire);
+        producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
+        // Cursor with zero claim sequence was never used, offset zero isn't a message boundary after the ring wrapped
+        if (cursorCache_ == 0) {
+            auto const start = Cursor::next(0, producerPosCache_);
+            if (std::atomic_ref(*cursor_).compare_exchange_strong(
+                    cursorCache_, start, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                cursorCache_ = start;
+            }
+        }
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Return queue capacity
+    [[nodiscard]] ROCKET_FORCE_INLINE auto capacity() const noexcept -> std::size_t {
+        return storage_->size();
+    }
+
+    /// Claim next buffer of the group for reading. Return empty buffer in case of no data.
+    /// Claimed buffer is returned again until consumed.
+    [[nodiscard]] ROCKET_FORCE_INLINE auto fetch() noexcept -> std::span<std::byte const> {
+        if (lastMessageHeader_) {
+            return data_.subspan(lastMessageHeader_->payloadOffset, lastMessageHeader_->payloadSize);
+        }
+
+        auto current = std::atomic_ref(*cursor_).load(std::memory_order_acquire);
+        while (true) {
+            auto const offset = Cursor::offset(current);
+            // Cached producer position bounds the cursor only while no other member moved it
+            if ((current != cursorCache_ || offset == producerPosCache_) &&
+                (producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire)) ==
+                    offset) {
+                cursorCache_ = current;
+                return {};
+            }
+
+            auto const message = std::bit_cast<MessageHeader*>(data_.data() + offset);
+            auto const next = Cursor::next(current, message->payloadOffset + message->size);
+            if (std::atomic_ref(*cursor_).compare_exchange_weak(
+                    current, next, std::memory_order_acq_rel, std::memory_order_acquire)) [[likely]] {
+                cursorCache_ = next;
+                lastMessageHeader_ = message;
+                return data_.subspan(lastMessageHeader_->payloadOffset, lastMessageHeader_->payloadSize);
+            }
+        }
+    }
+
+    /// Release claimed buffer
+    /// pre: fetch() -> non empty buffer
+    ROCKET_FORCE_INLINE void consume() noexcept {
+        lastMessageHeader_ = nullptr;
+    }
+
+    /// Move group cursor to producer position, messages not claimed yet are dropped for all members
+    ROCKET_FORCE_INLINE void reset() noexcept {
+        lastMessageHeader_ = nullptr;
+        auto current = std::atomic_ref(*cursor_).load(std::memory_order_acquire);
+        do {
+            producerPosCache_ = std::atomic_ref(header_->producerPos).load(std::memory_order_acquire);
+            cursorCache_ = Cursor::next(current, producerPosCache_);
+        } while (!std::atomic_ref(*cursor_).compare_exchange_weak(
+            current, cursorCache_, std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    /// Swap resources with other object
+    void swap(BoundedSPMCRawQueueGroupConsumer& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(data_, that.data_);
+        swap(header_, that.header_);
+        swap(cursor_, that.cursor_);
+        swap(cursorCache_, that.cursorCache_);
+        swap(producerPosCache_, that.producerPosCache_);
+        swap(lastMessageHeader_, that.lastMessageHeader_);
+    }
+
+    /// \see BoundedSPMCRawQueueGroupConsumer::swap
+    friend void swap(BoundedSPMCRawQueueGroupConsumer& a, BoundedSPMCRawQueueGroupConsumer& b) noexcept {
+        a.swap(b);
+    }
+};
+
+/// Read-only SPMC queue observer
+/// Maps memory header only and never writes, so producer and consumers are not disturbed beyond cache line sharing
+/// on sampling
+template <typename Traits>
+class BoundedSPMCRawQueueObserver {
+  private:
+    using QueueDetail = BoundedSPMCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+
+    MappedRegion storage_;
+    MemoryHeader const* header_ = nullptr;
+    std::size_t capacity_ = 0;
+
+  public:
+    BoundedSPMCRawQueueObserver() = default;
+
+    /// Construct over mapped memory header
+    /// \param[in] fileSize is queue memory size
+    BoundedSPMCRawQueueObserver(MappedRegion&& storage, std::size_t fileSize)
+        : storage_(std::move(storage)), capacity_(fileSize - QueueDetail::kDataStartPos) {
+        if (storage_.size() < sizeof(MemoryHeader) || fileSize < QueueDetail::kMinBufferSize) {
+            throw std::runtime_error("invalid queue");
+        }
+        header_ = std::bit_cast<MemoryHeader const*>(storage_.data());
+        if (!QueueDetail::checkTag(header_)) {
+            throw std::runtime_error("invalid queue");
+        }
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return static_cast<bool>(storage_);
+    }
+
+    /// Data capacity (bytes)
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+        return capacity_;
+    }
+
+    /// Producer position
+    [[nodiscard]] auto producerPos() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->producerPos)).load(std::memory_order_acquire);
+    }
+
+    /// Statistics published by producer
+    [[nodiscard]] auto statistics() const noexcept -> QueueStatistics
+        requires(QueueDetail::kStatistics)
+    {
+        return header_->statistics.load();
+    }
+
+    /// Registered consumer position and pid, std::nullopt on slot is free
+    [[nodiscard]] auto registeredConsumer(std::size_t slot) const noexcept
+        -> std::optional<std::pair<std::size_t, std::int32_t>>
+        requires(QueueDetail::kConsumerSlots > 0)
+    {
+        auto& value = const_cast<SPMCConsumerSlot&>(header_->consumers.slots[slot]);
+        auto const owner = std::atomic_ref(value.owner).load(std::memory_order_acquire);
+        if (owner == 0) {
+            return std::nullopt;
+        }
+        return std::pair(std::atomic_ref(value.pos).load(std::memory_order_acquire), owner);
+    }
+
+    /// Consumer group cursor position
+    [[nodiscard]] auto groupPos(std::size_t group) const noexcept -> std::size_t
+        requires(QueueDetail::kConsumerGroups > 0)
+    {
+        auto& value = const_cast<std::uint64_t&>(header_->groups.cursors[group].value);
+        return SPMCConsumerGroupCursor::offset(std::atomic_ref(value).load(std::memory_order_acquire));
+    }
 };
 
 } // namespace detail
@@ -299,6 +803,33 @@ struct BoundedSPMCRawQueueDefaultTraits {
 
 using BoundedSPMCRawQueue = BoundedSPMCRawQueueImpl<BoundedSPMCRawQueueDefaultTraits>;
 
+/// Default traits with statistics enabled
+/// Tag differs from the default one at non-prefix position, queues of different layout never match each other
+struct BoundedSPMCRawQueueStatisticsTraits : BoundedSPMCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/stats/SPMC";
+    static constexpr bool kStatistics = true;
+};
+
+using BoundedSPMCRawQueueWithStatistics = BoundedSPMCRawQueueImpl<BoundedSPMCRawQueueStatisticsTraits>;
+
+/// Default traits with consumer groups enabled
+struct BoundedSPMCRawQueueGroupTraits : BoundedSPMCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/group/SPMC";
+    static constexpr std::size_t kConsumerGroups = 4;
+};
+
+using BoundedSPMCRawQueueWithGroups = BoundedSPMCRawQueueImpl<BoundedSPMCRawQueueGroupTraits>;
+
+/// Default traits with slow consumer backpressure enabled
+/// Producer reports full instead of overwriting messages not consumed by registered consumers (consumer groups are
+/// not taken into account)
+struct BoundedSPMCRawQueueBackpressureTraits : BoundedSPMCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/bp/SPMC";
+    static constexpr std::size_t kConsumerSlots = 16;
+};
+
+using BoundedSPMCRawQueueWithBackpressure = BoundedSPMCRawQueueImpl<BoundedSPMCRawQueueBackpressureTraits>;
+
 template <typename Traits>
 class BoundedSPMCRawQueueImpl {
   private:
@@ -307,10 +838,15 @@ class BoundedSPMCRawQueueImpl {
     using MessageHeader = typename QueueDetail::MessageHeader;
 
     File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
 
   public:
     using Producer = detail::BoundedSPMCRawQueueProducer<Traits>;
     using Consumer = detail::BoundedSPMCRawQueueConsumer<Traits>;
+    using GroupConsumer = detail::BoundedSPMCRawQueueGroupConsumer<Traits>;
+    using Observer = detail::BoundedSPMCRawQueueObserver<Traits>;
 
     struct CreationOptions {
         std::size_t capacityHint;
@@ -330,7 +866,9 @@ class BoundedSPMCRawQueueImpl {
     }
 
     /// Open only queue. Throws on error.
-    BoundedSPMCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) {
+    BoundedSPMCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         auto result = memorySource.open(name, MemorySource::OpenOnly);
         if (!result) {
             throw std::runtime_error("failed to open memory source");
@@ -339,14 +877,16 @@ class BoundedSPMCRawQueueImpl {
         std::size_t pageSize;
         std::tie(file_, pageSize) = std::move(result).value();
 
-        if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!QueueDetail::check(storage_->content())) {
             throw std::runtime_error("failed to open queue (invalid)");
         }
     }
 
     /// Open or create queue. Throws on error.
     BoundedSPMCRawQueueImpl(std::string_view name, CreationOptions const& options,
-        MemorySource const& memorySource = DefaultMemorySource()) {
+        MemorySource const& memorySource = DefaultMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         auto result = memorySource.open(name, MemorySource::OpenOrCreate);
         if (!result) {
             throw std::runtime_error("failed to open memory source");
@@ -363,12 +903,14 @@ class BoundedSPMCRawQueueImpl {
             if (fileSize != capacity) {
                 throw std::runtime_error("size mismatch");
             }
-            if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!QueueDetail::check(storage_->content())) {
                 throw std::runtime_error("failed to open queue (invalid)");
             }
         } else {
             file_.truncate(capacity);
-            QueueDetail::init(detail::mapFile(file_, capacity).content());
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            QueueDetail::init(storage_->content());
         }
     }
 
@@ -377,6 +919,11 @@ class BoundedSPMCRawQueueImpl {
         return static_cast<bool>(file_);
     }
 
+    /// Result of applying mapping options to the queue mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
     /// Create producer for the queue. Throws on error.
     [[nodiscard]] ROCKET_FORCE_INLINE auto createProducer() -> Producer {
         if (!operator bool()) {
@@ -385,21 +932,58 @@ class BoundedSPMCRawQueueImpl {
         if (!file_.tryLock()) {
             throw std::runtime_error("can't create producer (already exists?)");
         }
-        return Producer(detail::mapFile(file_));
+        return Producer(storage_);
     }
 
-    /// Create consumer for the queue. Throws on error.
+    /// Create consumer for the queue, consumer is registered with producer on backpressure enabled. Throws on error.
     [[nodiscard]] ROCKET_FORCE_INLINE auto createConsumer() -> Consumer {
         if (!operator bool()) {
             throw std::runtime_error("queue not initialized");
         }
-        return Consumer(detail::mapFile(file_));
+        return Consumer(storage_);
+    }
+
+    /// Create member of consumer group, each message is delivered to one member of the group. Throws on error.
+    [[nodiscard]] ROCKET_FORCE_INLINE auto createGroupConsumer(std::size_t group) -> GroupConsumer
+        requires(QueueDetail::kConsumerGroups > 0)
+    {
+        if (!operator bool()) {
+            throw std::runtime_error("queue not initialized");
+        }
+        return GroupConsumer(storage_, group);
+    }
+
+    /// Create read-only observer for the queue. Throws on error.
+    [[nodiscard]] auto createObserver() const -> Observer {
+        if (!operator bool()) {
+            throw std::runtime_error("queue not initialized");
+        }
+        return Observer(detail::mapReadOnly(file_, sizeof(MemoryHeader)), storage_->size());
+    }
+
+    /// Open read-only observer of existing queue without opening the queue itself (e.g. by monitoring process)
+    /// Maps memory header only, read-only and without prefault. Throws on error.
+    [[nodiscard]] static auto openObserver(
+        std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) -> Observer {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+        auto const [file, pageSize] = std::move(result).value();
+        auto const fileSize = file.getFileSize();
+        if (fileSize < sizeof(MemoryHeader)) {
+            throw std::runtime_error("invalid queue");
+        }
+        return Observer(detail::mapReadOnly(file, sizeof(MemoryHeader)), fileSize);
     }
 
     /// Swap resources with other queue.
     void swap(BoundedSPMCRawQueueImpl& that) noexcept {
         using std::swap;
         swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
     }
 
     /// \see BoundedSPMCRawQueueImpl::swap
@@ -0,0 +1,72 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BoundedSPMCRawQueue.h"
+#include "MemorySource.h"
+#include "Platform.h"
+#include "TestUtils.h"
+
+namespace rocket::testing {
+
+/// Messages consumed by group member, own cache line
+struct alignas(kHardwareDestructiveInterferenceSize) MemberCounter {
+    std::atomic<std::uint64_t> value{0};
+};
+
+/// Producer publishes to one consumer group of the first argument members, each message is consumed once
+/// Producer never blocks on SPMC queue, so it's throttled to keep members within the ring
+static void BM_SPMC_ConsumerGroup(::benchmark::State& state) {
+    constexpr std::uint64_t kWindow = 4096;
+    auto const membersCount = static_cast<std::size_t>(state.range(0));
+
+    auto queue = BoundedSPMCRawQueueWithGroups("bm-group", {std::size_t(1) << 20}, AnonymousMemorySource());
+    auto producer = queue.createProducer();
+
+    std::vector<MemberCounter> consumed(membersCount);
+    std::atomic<bool> stop{false};
+    std::vector<std::jthread> members;
+    for (std::size_t index = 0; index < membersCount; ++index) {
+        members.emplace_back([&, index, consumer = queue.createGroupConsumer(0)]() mutable {
+            std::uint64_t value = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (dequeue(consumer, value)) {
+                    benchmark::DoNotOptimize(value);
+                    consumed[index].value.store(
+                        consumed[index].value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                }
+            }
+        });
+    }
+
+    auto const totalConsumed = [&] {
+        std::uint64_t total = 0;
+        for (auto const& counter : consumed) {
+            total += counter.value.load(std::memory_order_acquire);
+        }
+        return total;
+    };
+
+    std::uint64_t produced = 0;
+    std::uint64_t consumedCache = 0;
+    for (auto _ : state) {
+        while (produced - consumedCache >= kWindow) {
+            consumedCache = totalConsumed();
+        }
+        [[maybe_unused]] auto const rc = enqueue(producer, produced++);
+    }
+    while (totalConsumed() != produced) {}
+
+    stop.store(true, std::memory_order_relaxed);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SPMC_ConsumerGroup)->DenseRange(1, 8)->UseRealTime();
+
+} // namespace rocket::testing
@@ -1,8 +1,18 @@
 // Copyright (c) Sergey Kovalevich <inndie@gmail.com>
 // SPDX-License-Identifier: AGPL-3.0
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include <doctest/doctest.h>
 
@@ -47,4 +57,231 @@ TEST_CASE("BoundedSPMCRawQueue: basic") {
     REQUIRE(value == std::uint64_t(-1));
 }
 
+struct StatisticsTraits : BoundedSPMCRawQueueStatisticsTraits {
+    static constexpr std::size_t kStatisticsInterval = 1;
+};
+
+TEST_CASE("BoundedSPMCRawQueue: standalone observer") {
+    using Queue = BoundedSPMCRawQueueWithStatistics;
+    auto const name = "rocket-spmc-observer-test-" + std::to_string(::getpid());
+    auto const memorySource = DefaultMemorySource();
+
+    {
+        Queue queue(name, Queue::CreationOptions(1 << 16), memorySource);
+        auto producer = queue.createProducer();
+        REQUIRE(enqueue(producer, std::uint64_t(1)));
+
+        auto observer = Queue::openObserver(name, memorySource);
+        REQUIRE(observer.producerPos() != 0);
+
+        REQUIRE_THROWS(BoundedSPMCRawQueue(name, memorySource));
+        REQUIRE_THROWS(BoundedSPMCRawQueue::openObserver(name, memorySource));
+    }
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("BoundedSPMCRawQueue: statistics") {
+    using Queue = BoundedSPMCRawQueueImpl<StatisticsTraits>;
+    Queue queue("test", Queue::CreationOptions(4096), AnonymousMemorySource());
+
+    auto observer = queue.createObserver();
+    auto producer = queue.createProducer();
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        REQUIRE(enqueue(producer, i));
+    }
+
+    REQUIRE(observer.producerPos() != 0);
+    auto const statistics = observer.statistics();
+    REQUIRE(statistics.messages == 10);
+    REQUIRE(statistics.bytes == 10 * sizeof(std::uint64_t));
+    REQUIRE(statistics.fullEvents == 0);
+}
+
+TEST_CASE("BoundedSPMCRawQueue: consumer groups") {
+    using Queue = BoundedSPMCRawQueueWithGroups;
+    Queue queue("test", Queue::CreationOptions(1 << 16), AnonymousMemorySource());
+
+    REQUIRE_THROWS(queue.createGroupConsumer(BoundedSPMCRawQueueGroupTraits::kConsumerGroups));
+
+    auto producer = queue.createProducer();
+    auto broadcast = queue.createConsumer();
+    auto first = queue.createGroupConsumer(0);
+    auto second = queue.createGroupConsumer(0);
+    auto other = queue.createGroupConsumer(1);
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(enqueue(producer, i));
+    }
+
+    // Members of a group split messages, claimed message is kept until consumed
+    std::vector<std::uint64_t> values;
+    std::uint64_t value = 0;
+    while (true) {
+        if (fetch(first, value)) {
+            std::uint64_t again = 0;
+            REQUIRE(fetch(first, again));
+            REQUIRE(again == value);
+            first.consume();
+            values.push_back(value);
+        }
+        if (!dequeue(second, value)) {
+            break;
+        }
+        values.push_back(value);
+    }
+    REQUIRE(!dequeue(first, value));
+    REQUIRE(values.size() == 100);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(values[i] == i);
+    }
+
+    // Other group and broadcast consumers see all messages
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(dequeue(other, value));
+        REQUIRE(value == i);
+        REQUIRE(dequeue(broadcast, value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(!dequeue(other, value));
+
+    auto observer = queue.createObserver();
+    REQUIRE(observer.groupPos(0) == observer.producerPos());
+    REQUIRE(observer.groupPos(2) == 0);
+
+    // Reset skips messages not claimed yet
+    REQUIRE(enqueue(producer, std::uint64_t(100)));
+    other.reset();
+    REQUIRE(!dequeue(other, value));
+    REQUIRE(dequeue(first, value));
+    REQUIRE(value == 100);
+}
+
+TEST_CASE("BoundedSPMCRawQueue: consumer group threads") {
+    using Queue = BoundedSPMCRawQueueWithGroups;
+    constexpr std::uint64_t kMessages = 10000;
+    constexpr std::size_t kMembers = 4;
+
+    // Queue is never wrapped
+    Queue queue("test", Queue::CreationOptions(1 << 20), AnonymousMemorySource());
+    auto producer = queue.createProducer();
+
+    std::atomic<std::uint64_t> received{0};
+    std::vector<std::atomic<int>> seen(kMessages);
+    {
+        std::vector<std::jthread> members;
+        for (std::size_t i = 0; i < kMembers; ++i) {
+            members.emplace_back([&, consumer = queue.createGroupConsumer(0)]() mutable {
+                std::uint64_t value = 0;
+                while (received.load() < kMessages) {
+                    if (dequeue(consumer, value)) {
+                        seen[value].fetch_add(1);
+                        received.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (std::uint64_t i = 0; i < kMessages; ++i) {
+            REQUIRE(enqueue(producer, i));
+        }
+    }
+
+    REQUIRE(received.load() == kMessages);
+    REQUIRE(std::ranges::all_of(seen, [](auto const& count) { return count.load() == 1; }));
+}
+
+TEST_CASE("BoundedSPMCRawQueue: consumer group created after wrap") {
+    using Queue = BoundedSPMCRawQueueWithGroups;
+    Queue queue("test", Queue::CreationOptions(4096), AnonymousMemorySource());
+    auto producer = queue.createProducer();
+
+    // Messages of odd size, so the ring wraps in the middle of a message
+    std::uint64_t const capacity = queue.createObserver().capacity();
+    std::array<char, 100> payload;
+    payload.fill('x');
+    for (std::uint64_t written = 0; written < 3 * capacity; written += payload.size()) {
+        REQUIRE(enqueue(producer, payload));
+    }
+
+    // Group starts at producer position, history of the ring is not replayed
+    auto first = queue.createGroupConsumer(0);
+    auto second = queue.createGroupConsumer(0);
+    std::uint64_t value = 0;
+    REQUIRE(!dequeue(first, value));
+    REQUIRE(!dequeue(second, value));
+
+    REQUIRE(enqueue(producer, std::uint64_t(42)));
+    REQUIRE(dequeue(second, value));
+    REQUIRE(value == 42);
+    REQUIRE(!dequeue(first, value));
+}
+
+TEST_CASE("BoundedSPMCRawQueue: backpressure") {
+    using Queue = BoundedSPMCRawQueueWithBackpressure;
+    Queue queue("test", Queue::CreationOptions(4096), AnonymousMemorySource());
+    auto observer = queue.createObserver();
+    auto producer = queue.createProducer();
+
+    // No registered consumers, producer overwrites
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        REQUIRE(enqueue(producer, i));
+    }
+
+    auto fast = queue.createConsumer();
+    std::uint64_t count = 0;
+    {
+        auto slow = queue.createConsumer();
+        REQUIRE(observer.registeredConsumer(0));
+        REQUIRE(observer.registeredConsumer(1));
+        REQUIRE(!observer.registeredConsumer(2));
+
+        while (enqueue(producer, count)) {
+            ++count;
+        }
+        REQUIRE(count > 0);
+
+        // Slowest consumer limits producer
+        std::uint64_t value = 0;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            REQUIRE(dequeue(fast, value));
+            REQUIRE(value == i);
+        }
+        REQUIRE(!enqueue(producer, count));
+
+        REQUIRE(dequeue(slow, value));
+        REQUIRE(value == 0);
+        REQUIRE(enqueue(producer, count++));
+        REQUIRE(!enqueue(producer, count));
+    }
+
+    // Detached consumer is not waited
+    REQUIRE(!observer.registeredConsumer(1));
+    std::uint64_t value = 0;
+    REQUIRE(dequeue(fast, value));
+    REQUIRE(value == count - 1);
+    while (enqueue(producer, count)) {
+        ++count;
+    }
+
+    // Consumer of dead process is released
+    auto const pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        [[maybe_unused]] auto consumer = queue.createConsumer();
+        ::_exit(0);
+    }
+    int status = 0;
+    REQUIRE(::waitpid(pid, &status, 0) == pid);
+    REQUIRE(observer.registeredConsumer(1));
+
+    while (dequeue(fast, value)) {}
+    REQUIRE(value == count - 1);
+    REQUIRE(enqueue(producer, count++));
+    while (enqueue(producer, count)) {
+        ++count;
+    }
+    REQUIRE(!observer.registeredConsumer(1));
+    REQUIRE(dequeue(fast, value));
+}
+
 } // namespace rocket::testing
@@ -8,6 +8,7 @@
 #include <bit>
 #include <cassert>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string_view>
 #include <type_traits>
@@ -15,6 +16,7 @@
 #include "MappedRegion.h"
 #include "MemorySource.h"
 #include "Platform.h"
+#include "QueueStatistics.h"
 #include "detail/math.h"
 #include "detail/memory.h"
 
@@ -30,15 +32,21 @@ struct BoundedSPSCRawQueueDetail {
     static constexpr std::size_t kSegmentSize = Traits::kSegmentSize;
     /// Alignment
     static constexpr std::size_t kAlign = Traits::kAlign;
+    /// Statistics enabled
+    static constexpr bool kStatistics = QueueStatisticsTraits<Traits>;
+    /// Producer events between statistics publications
+    static constexpr std::size_t kStatisticsInterval = getQueueStatisticsInterval<Traits>();
 
     /// Control struct for queue buffer
     struct MemoryHeader {
-        /// Placeholder for queue tag
-        char tag[kTag.size()];
+        /// Placeholder for queue tag, NUL-terminated so a tag never matches a longer one sharing its prefix
+        char tag[kTag.size() + 1];
         /// Producer position
         alignas(kAlign) std::size_t producerPos;
         /// Consumer position
         alignas(kAlign) std::size_t consumerPos;
+        /// Statistics (own cache line, empty on disabled)
+        [[no_unique_address]] QueueStatisticsStorage<kStatistics> statistics;
 
         static_assert(std::atomic_ref<std::size_t>::is_always_lock_free);
     };
@@ -63,6 +71,11 @@ struct BoundedSPSCRawQueueDetail {
     /// Min buffer size
     static constexpr std::size_t kMinBufferSize = kDataStartPos + 2 * kSegmentSize;
 
+    /// Return true on header tagged with the queue tag (full tag field compared)
+    [[nodiscard]] static auto checkTag(MemoryHeader const* header) noexcept -> bool {
+        return std::equal(kTag.begin(), kTag.end(), header->tag) && header->tag[kTag.size()] == '\0';
+    }
+
     /// Check buffer points to valid SPMC queue region
     /// Return true on success and false otherwise.
     [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
@@ -70,7 +83,7 @@ struct BoundedSPSCRawQueueDetail {
             return false;
         }
         auto const header = std::bit_cast<MemoryHeader const*>(buffer.data());
-        if (!std::equal(kTag.begin(), kTag.end(), header->tag)) {
+        if (!checkTag(header)) {
             return false;
         }
         return true;
@@ -80,8 +93,18 @@ struct BoundedSPSCRawQueueDetail {
     static void init(std::span<std::byte> buffer) noexcept {
         auto header = std::bit_cast<MemoryHeader*>(buffer.data());
         std::copy(kTag.begin(), kTag.end(), header->tag);
+        header->tag[kTag.size()] = '\0';
         std::atomic_ref(header->producerPos).store(0, std::memory_order_relaxed);
         std::atomic_ref(header->consumerPos).store(0, std::memory_order_relaxed);
+        if constexpr (kStatistics) {
+            header->statistics = QueueStatisticsBlock{};
+        }
+    }
+
+    /// Bytes occupied between consumer and producer positions
+    [[nodiscard]] static constexpr auto occupancy(
+        std::size_t producerPos, std::size_t consumerPos, std::size_t dataSize) noexcept -> std::size_t {
+        return (producerPos >= consumerPos) ? (producerPos - consumerPos) : (dataSize - consumerPos + producerPos);
     }
 };
 
@@ -93,16 +116,22 @@ class BoundedSPSCRawQueueProducer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::size_t producerPosCache_ = 0;
     std::size_t minFreeSpace_ = 0;
     MessageHeader* lastMessageHeader_ = nullptr;
+    [[no_unique_address]] QueueStatisticsCounter<QueueDetail::kStatistics, QueueDetail::kStatisticsInterval>
+        statistics_;
 
   public:
     BoundedSPSCRawQueueProducer() = default;
-    ~BoundedSPSCRawQueueProducer() = default;
+
+    /// Destructor. Publish pending statistics
+    ~BoundedSPSCRawQueueProducer() {
+        publishStatistics();
+    }
 
     BoundedSPSCRawQueueProducer(BoundedSPSCRawQueueProducer&& that) noexcept {
         swap(that);
@@ -113,8 +142,12 @@ class BoundedSPSCRawQueueProducer {
         return *this;
     }
 
-    BoundedSPSCRawQueueProducer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPSCRawQueueProducer(MappedRegion&& storage)
+        : BoundedSPSCRawQueueProducer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPSCRawQueueProducer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
@@ -136,7 +169,7 @@ class BoundedSPSCRawQueueProducer {
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Reserve contiguous space for writing without making it visible to the
@@ -156,6 +189,9 @@ class BoundedSPSCRawQueueProducer {
         }
 
         auto const consumerPosCache = std::atomic_ref(header_->consumerPos).load(std::memory_order_acquire);
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onOccupancy(QueueDetail::occupancy(producerPosCache_, consumerPosCache, data_.size()));
+        }
 
         if (consumerPosCache > producerPosCache_) {
             // queue is empty in case of consumerPos == producerPos
@@ -201,12 +237,18 @@ class BoundedSPSCRawQueueProducer {
             }
         }
 
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onFull(header_->statistics);
+        }
         return {};
     }
 
     /// Make reserved buffer visible for consumers
     ROCKET_FORCE_INLINE void commit() noexcept {
         std::atomic_ref(header_->producerPos).store(producerPosCache_, std::memory_order_release);
+        if constexpr (QueueDetail::kStatistics) {
+            statistics_.onCommit(header_->statistics, lastMessageHeader_->payloadSize);
+        }
     }
 
     /// \overload
@@ -220,6 +262,15 @@ class BoundedSPSCRawQueueProducer {
         commit();
     }
 
+    /// Publish pending statistics (Traits::kStatistics), otherwise they are published each kStatisticsInterval events
+    void publishStatistics() noexcept {
+        if constexpr (QueueDetail::kStatistics) {
+            if (header_) {
+                statistics_.publish(header_->statistics);
+            }
+        }
+    }
+
     /// Swap resources with other producer
     void swap(BoundedSPSCRawQueueProducer& that) noexcept {
         using std::swap;
@@ -230,6 +281,7 @@ class BoundedSPSCRawQueueProducer {
         swap(producerPosCache_, that.producerPosCache_);
         swap(minFreeSpace_, that.minFreeSpace_);
         swap(lastMessageHeader_, that.lastMessageHeader_);
+        swap(statistics_, that.statistics_);
     }
 
     /// \see BoundedSPSCRawQueueProducer::swap
@@ -246,7 +298,7 @@ class BoundedSPSCRawQueueConsumer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::size_t consumerPosCache_ = 0;
@@ -266,8 +318,12 @@ class BoundedSPSCRawQueueConsumer {
         return *this;
     }
 
-    BoundedSPSCRawQueueConsumer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPSCRawQueueConsumer(MappedRegion&& storage)
+        : BoundedSPSCRawQueueConsumer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPSCRawQueueConsumer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error("invalid queue");
@@ -281,7 +337,7 @@ class BoundedSPSCRawQueueConsumer {
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Get next buffer for reading. Return empty buffer in case of no data.
@@ -328,6 +384,69 @@ class BoundedSPSCRawQueueConsumer {
     }
 };
 
+/// Read-only SPSC queue observer
+/// Maps memory header only and never writes, so producer and consumer are not disturbed beyond cache line sharing
+/// on sampling
+template <typename Traits>
+class BoundedSPSCRawQueueObserver {
+  private:
+    using QueueDetail = BoundedSPSCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+
+    MappedRegion storage_;
+    MemoryHeader const* header_ = nullptr;
+    std::size_t capacity_ = 0;
+
+  public:
+    BoundedSPSCRawQueueObserver() = default;
+
+    /// Construct over mapped memory header
+    /// \param[in] fileSize is queue memory size
+    BoundedSPSCRawQueueObserver(MappedRegion&& storage, std::size_t fileSize)
+        : storage_(std::move(storage)), capacity_(fileSize - QueueDetail::kDataStartPos) {
+        if (storage_.size() < sizeof(MemoryHeader) || fileSize < QueueDetail::kMinBufferSize) {
+            throw std::runtime_error("invalid queue");
+        }
+        header_ = std::bit_cast<MemoryHeader const*>(storage_.data());
+        if (!QueueDetail::checkTag(header_)) {
+            throw std::runtime_error("invalid queue");
+        }
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return static_cast<bool>(storage_);
+    }
+
+    /// Data capacity (bytes)
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+        return capacity_;
+    }
+
+    /// Producer position
+    [[nodiscard]] auto producerPos() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->producerPos)).load(std::memory_order_acquire);
+    }
+
+    /// Consumer position
+    [[nodiscard]] auto consumerPos() const noexcept -> std::size_t {
+        return std::atomic_ref(const_cast<std::size_t&>(header_->consumerPos)).load(std::memory_order_acquire);
+    }
+
+    /// Bytes published by producer and not consumed yet
+    [[nodiscard]] auto occupancy() const noexcept -> std::size_t {
+        auto const consumerPos = this->consumerPos();
+        return QueueDetail::occupancy(this->producerPos(), consumerPos, capacity_);
+    }
+
+    /// Statistics published by producer
+    [[nodiscard]] auto statistics() const noexcept -> QueueStatistics
+        requires(QueueDetail::kStatistics)
+    {
+        return header_->statistics.load();
+    }
+};
+
 } // namespace detail
 
 /// Queue layout:
@@ -350,6 +469,15 @@ struct BoundedSPSCRawQueueDefaultTraits {
 
 using BoundedSPSCRawQueue = BoundedSPSCRawQueueImpl<BoundedSPSCRawQueueDefaultTraits>;
 
+/// Default traits with statistics enabled
+/// Tag differs from the default one at non-prefix position, queues of different layout never match each other
+struct BoundedSPSCRawQueueStatisticsTraits : BoundedSPSCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/stats/SPSC";
+    static constexpr bool kStatistics = true;
+};
+
+using BoundedSPSCRawQueueWithStatistics = BoundedSPSCRawQueueImpl<BoundedSPSCRawQueueStatisticsTraits>;
+
 template <typename Traits>
 class BoundedSPSCRawQueueImpl {
   private:
@@ -358,10 +486,14 @@ class BoundedSPSCRawQueueImpl {
     using MessageHeader = typename QueueDetail::MessageHeader;
 
     File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
 
   public:
     using Producer = detail::BoundedSPSCRawQueueProducer<Traits>;
     using Consumer = detail::BoundedSPSCRawQueueConsumer<Traits>;
+    using Observer = detail::BoundedSPSCRawQueueObserver<Traits>;
 
     struct CreationOptions {
         std::size_t capacityHint;
@@ -381,7 +513,9 @@ class BoundedSPSCRawQueueImpl {
     }
 
     /// Open only queue. Throws on error.
-    BoundedSPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) {
+    BoundedSPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         auto result = memorySource.open(name, MemorySource::OpenOnly);
         if (!result) {
             throw std::runtime_error("failed to open memory source");
@@ -389,14 +523,16 @@ class BoundedSPSCRawQueueImpl {
         std::size_t pageSize;
         std::tie(file_, pageSize) = std::move(result).value();
 
-        if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!QueueDetail::check(storage_->content())) {
             throw std::runtime_error("failed to open queue (invalid)");
         }
     }
 
     /// Open or create queue. Throws on error.
     BoundedSPSCRawQueueImpl(std::string_view name, CreationOptions const& options,
-        MemorySource const& memorySource = DefaultMemorySource()) {
+        MemorySource const& memorySource = DefaultMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
         auto result = memorySource.open(name, MemorySource::OpenOrCreate);
         if (!result) {
             throw std::runtime_error("failed to open memory source");
@@ -413,12 +549,14 @@ class BoundedSPSCRawQueueImpl {
             if (fileSize != capacity) {
                 throw std::runtime_error("size mismatch");
             }
-            if (auto storage = detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!QueueDetail::check(storage_->content())) {
                 throw std::runtime_error("failed to open queue (invalid)");
             }
         } else {
             file_.truncate(capacity);
-            QueueDetail::init(detail::mapFile(file_, capacity).content());
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            QueueDetail::init(storage_->content());
         }
     }
 
@@ -427,12 +565,17 @@ class BoundedSPSCRawQueueImpl {
         return static_cast<bool>(file_);
     }
 
+    /// Result of applying mapping options to the queue mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
     /// Create producer for the queue. Throws on error.
     [[nodiscard]] ROCKET_FORCE_INLINE auto createProducer() -> Producer {
         if (!operator bool()) {
             throw std::runtime_error("queue not initialized");
         }
-        return Producer(detail::mapFile(file_));
+        return Producer(storage_);
     }
 
     /// Create consumer for the queue. Throws on error.
@@ -443,13 +586,40 @@ class BoundedSPSCRawQueueImpl {
         if (!file_.tryLock()) {
             throw std::runtime_error("can't create consumer (already exists?)");
         }
-        return Consumer(detail::mapFile(file_));
+        return Consumer(storage_);
+    }
+
+    /// Create read-only observer for the queue. Throws on error.
+    [[nodiscard]] auto createObserver() const -> Observer {
+        if (!operator bool()) {
+            throw std::runtime_error("queue not initialized");
+        }
+        return Observer(detail::mapReadOnly(file_, sizeof(MemoryHeader)), storage_->size());
+    }
+
+    /// Open read-only observer of existing queue without opening the queue itself (e.g. by monitoring process)
+    /// Maps memory header only, read-only and without prefault. Throws on error.
+    [[nodiscard]] static auto openObserver(
+        std::string_view name, MemorySource const& memorySource = DefaultMemorySource()) -> Observer {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+        auto const [file, pageSize] = std::move(result).value();
+        auto const fileSize = file.getFileSize();
+        if (fileSize < sizeof(MemoryHeader)) {
+            throw std::runtime_error("invalid queue");
+        }
+        return Observer(detail::mapReadOnly(file, sizeof(MemoryHeader)), fileSize);
     }
 
     /// Swap resources with other queue.
     void swap(BoundedSPSCRawQueueImpl& that) noexcept {
         using std::swap;
         swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
     }
 
     /// \see BoundedSPSCRawQueueImpl::swap
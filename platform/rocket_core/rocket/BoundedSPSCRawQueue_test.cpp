@@ -2,7 +2,11 @@
 // SPDX-License-Identifier: AGPL-3.0
 
 #include <algorithm>
+#include <filesystem>
 #include <string>
+#include <string_view>
+
+#include <unistd.h>
 
 #include <doctest/doctest.h>
 
@@ -48,6 +52,154 @@ TEST_CASE("BoundedSPSCRawQueue: basic") {
     REQUIRE(value == std::uint64_t(-1));
 }
 
+TEST_CASE("BoundedSPSCRawQueue: mapping options") {
+    auto const mappingOptions = MappingOptions{.populate = true, .lock = true, .hugePages = true, .dontDump = true};
+    BoundedSPSCRawQueue queue("test", BoundedSPSCRawQueue::CreationOptions(1 << 20), AnonymousMemorySource(),
+        mappingOptions);
+
+    auto producer = queue.createProducer();
+    REQUIRE(producer);
+    REQUIRE(!queue.mappingStatus().dontDump);
+    REQUIRE(!queue.mappingStatus().populate);
+    // Depends on RLIMIT_MEMLOCK and kernel config
+    auto const& lock = queue.mappingStatus().lock;
+    REQUIRE((!lock || lock.value() == ENOMEM || lock.value() == EPERM || lock.value() == EAGAIN));
+    auto const& hugePages = queue.mappingStatus().hugePages;
+    REQUIRE((!hugePages || hugePages.value() == EINVAL));
+
+    auto consumer = queue.createConsumer();
+    REQUIRE(consumer);
+
+    REQUIRE(enqueue(producer, std::uint64_t(42)));
+    std::uint64_t value = 0;
+    REQUIRE(dequeue(consumer, value));
+    REQUIRE(value == 42);
+}
+
+TEST_CASE("BoundedSPSCRawQueue: shared mapping") {
+    auto const name = "rocket-spsc-test-" + std::to_string(::getpid());
+    auto const memorySource = DefaultMemorySource();
+
+    {
+        BoundedSPSCRawQueue first(name, BoundedSPSCRawQueue::CreationOptions(1 << 20), memorySource);
+        BoundedSPSCRawQueue second(name, memorySource);
+
+        // Both handles of the process use the same mapping
+        auto [firstFile, firstPageSize] = memorySource.open(name, MemorySource::OpenOnly).value();
+        auto [secondFile, secondPageSize] = memorySource.open(name, MemorySource::OpenOnly).value();
+        auto const firstRegion = detail::mapShared(firstFile);
+        auto const secondRegion = detail::mapShared(secondFile);
+        REQUIRE(firstRegion == secondRegion);
+
+        // Options of a handle are applied to the shared mapping, status reports options of the handle
+        BoundedSPSCRawQueue third(name, memorySource, MappingOptions{.populate = false, .lock = true});
+        auto const& lock = third.mappingStatus().lock;
+        REQUIRE((!lock || lock.value() == ENOMEM || lock.value() == EPERM || lock.value() == EAGAIN));
+        REQUIRE(!third.mappingStatus().populate);
+        REQUIRE(!second.mappingStatus().lock);
+
+        auto producer = first.createProducer();
+        auto consumer = second.createConsumer();
+        REQUIRE(enqueue(producer, std::uint64_t(42)));
+        std::uint64_t value = 0;
+        REQUIRE(dequeue(consumer, value));
+        REQUIRE(value == 42);
+    }
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+struct StatisticsTraits : BoundedSPSCRawQueueStatisticsTraits {
+    static constexpr std::size_t kStatisticsInterval = 4;
+};
+
+// Statistics disabled keeps memory layout
+static_assert(detail::BoundedSPSCRawQueueDetail<BoundedSPSCRawQueueDefaultTraits>::kDataStartPos ==
+              3 * kHardwareDestructiveInterferenceSize);
+static_assert(detail::BoundedSPSCRawQueueDetail<StatisticsTraits>::kDataStartPos ==
+              4 * kHardwareDestructiveInterferenceSize);
+
+TEST_CASE("BoundedSPSCRawQueue: statistics") {
+    using Queue = BoundedSPSCRawQueueImpl<StatisticsTraits>;
+    Queue queue("test", Queue::CreationOptions(4096), AnonymousMemorySource());
+
+    auto observer = queue.createObserver();
+    REQUIRE(observer);
+    REQUIRE(observer.capacity() == 4096 - detail::BoundedSPSCRawQueueDetail<StatisticsTraits>::kDataStartPos);
+
+    auto consumer = queue.createConsumer();
+    std::uint64_t value = 0;
+
+    {
+        auto producer = queue.createProducer();
+        for (std::uint64_t i = 0; i < 3; ++i) {
+            REQUIRE(enqueue(producer, i));
+        }
+        // Not published yet
+        REQUIRE(observer.statistics().messages == 0);
+        REQUIRE(observer.occupancy() == 3 * kHardwareDestructiveInterferenceSize);
+
+        REQUIRE(enqueue(producer, std::uint64_t(3)));
+        REQUIRE(observer.statistics().messages == 4);
+        REQUIRE(observer.statistics().bytes == 4 * sizeof(std::uint64_t));
+
+        // Fill up the queue
+        while (enqueue(producer, value)) {}
+        producer.publishStatistics();
+
+        auto const statistics = observer.statistics();
+        REQUIRE(statistics.fullEvents == 1);
+        REQUIRE(statistics.highWaterMark > 0);
+        REQUIRE(statistics.highWaterMark <= observer.capacity());
+        REQUIRE(observer.producerPos() != observer.consumerPos());
+
+        REQUIRE(enqueue(producer, std::uint64_t(0)) == false);
+    }
+
+    // Pending statistics published by producer destructor
+    REQUIRE(observer.statistics().fullEvents == 2);
+
+    while (dequeue(consumer, value)) {}
+    REQUIRE(observer.occupancy() == 0);
+}
+
+/// Tag of the default traits is its prefix
+struct PrefixTagTraits : BoundedSPSCRawQueueDefaultTraits {
+    static constexpr std::string_view kTag = "rocket/SPSC+";
+};
+
+TEST_CASE("BoundedSPSCRawQueue: standalone observer") {
+    using Queue = BoundedSPSCRawQueueWithStatistics;
+    auto const name = "rocket-spsc-observer-test-" + std::to_string(::getpid());
+    auto const memorySource = DefaultMemorySource();
+
+    {
+        Queue queue(name, Queue::CreationOptions(1 << 16), memorySource);
+        auto producer = queue.createProducer();
+        REQUIRE(enqueue(producer, std::uint64_t(42)));
+        producer.publishStatistics();
+
+        // Queue is not opened by the observer
+        auto observer = Queue::openObserver(name, memorySource);
+        REQUIRE(observer.capacity() == queue.createObserver().capacity());
+        REQUIRE(observer.occupancy() == kHardwareDestructiveInterferenceSize);
+        REQUIRE(observer.statistics().messages == 1);
+
+        // Queues of different layout never match each other
+        REQUIRE_THROWS(BoundedSPSCRawQueue(name, memorySource));
+        REQUIRE_THROWS(BoundedSPSCRawQueue::openObserver(name, memorySource));
+    }
+    REQUIRE_THROWS(Queue::openObserver(name + "-missing", memorySource));
+
+    std::filesystem::remove(memorySource.path() / name);
+
+    {
+        BoundedSPSCRawQueueImpl<PrefixTagTraits> queue(name, {1 << 16}, memorySource);
+        REQUIRE_THROWS(BoundedSPSCRawQueue(name, memorySource));
+    }
+    std::filesystem::remove(memorySource.path() / name);
+}
+
 #if 0
 
 TEST_CASE("BoundedSPSCRawQueue: multipleMessages0") {
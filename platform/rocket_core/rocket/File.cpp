@@ -139,8 +139,8 @@ auto File::temporary(std::filesystem::path const& path) noexcept -> std::expecte
     return {File(fd, true)};
 }
 
-auto File::anonymous(char const* name) noexcept -> std::expected<File, std::error_code> {
-    int fd = ::memfd_create(name, MFD_CLOEXEC);
+auto File::anonymous(char const* name, unsigned int flags) noexcept -> std::expected<File, std::error_code> {
+    int fd = ::memfd_create(name, MFD_CLOEXEC | flags);
     if (fd == -1) {
         return std::unexpected(makePosixErrorCode(errno));
     }
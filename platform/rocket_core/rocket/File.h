@@ -98,7 +98,9 @@ class File {
         -> std::expected<File, std::error_code>;
 
     /// Create an anonymous file.
-    [[nodiscard]] static auto anonymous(char const* name = "") noexcept -> std::expected<File, std::error_code>;
+    /// \param[in] flags are extra memfd_create flags (e.g. MFD_HUGETLB)
+    [[nodiscard]] static auto anonymous(char const* name = "", unsigned int flags = 0) noexcept
+        -> std::expected<File, std::error_code>;
 
     /// Lock file.
     void lock();
@@ -6,6 +6,9 @@
 #include <print>
 
 #include <sys/mman.h>
+#include <unistd.h>
+
+#include "PosixError.h"
 
 namespace rocket {
 
@@ -17,4 +20,56 @@ MappedRegion::~MappedRegion() noexcept {
     }
 }
 
+auto MappedRegion::lock() noexcept -> std::expected<void, std::error_code> {
+    if (::mlock(data_, size_) != 0) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+    return {};
+}
+
+auto MappedRegion::advise(int advice) noexcept -> std::expected<void, std::error_code> {
+    if (::madvise(data_, size_, advice) != 0) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+    return {};
+}
+
+auto MappedRegion::populate() noexcept -> std::expected<void, std::error_code> {
+#ifdef MADV_POPULATE_WRITE
+    if (auto const rc = advise(MADV_POPULATE_WRITE); rc || rc.error().value() != EINVAL) {
+        return rc;
+    }
+#endif
+    // Kernel before 5.14, read fault allocates shared memory pages as well
+    static std::size_t const pageSize = ::sysconf(_SC_PAGESIZE);
+    for (std::size_t offset = 0; offset < size_; offset += pageSize) {
+        [[maybe_unused]] auto const value = *static_cast<std::byte const volatile*>(data_ + offset);
+    }
+    return {};
+}
+
+auto MappedRegion::apply(MappingOptions const& options) noexcept -> MappingStatus {
+    MappingStatus status;
+    auto const apply = [](std::error_code& ec, std::expected<void, std::error_code> const& rc) {
+        if (!rc) {
+            ec = rc.error();
+        }
+    };
+
+    if (options.hugePages) {
+        apply(status.hugePages, advise(MADV_HUGEPAGE));
+    }
+    if (options.dontDump) {
+        apply(status.dontDump, advise(MADV_DONTDUMP));
+    }
+    // mlock faults in all pages
+    if (options.lock) {
+        apply(status.lock, lock());
+    }
+    if (options.populate && (!options.lock || status.lock)) {
+        apply(status.populate, populate());
+    }
+    return status;
+}
+
 } // namespace rocket
@@ -4,12 +4,40 @@
 #pragma once
 
 #include <cstddef>
+#include <expected>
 #include <span>
+#include <system_error>
 
 #include "File.h"
 
 namespace rocket {
 
+/// Memory mapping options
+struct MappingOptions {
+    /// Prefault pages on mapping
+    bool populate = true;
+    /// Lock pages in memory (mlock), prevents swapout
+    bool lock = false;
+    /// Transparent huge pages (MADV_HUGEPAGE), effective for tmpfs mounted with huge=advise
+    bool hugePages = false;
+    /// Exclude from core dumps (MADV_DONTDUMP)
+    bool dontDump = false;
+};
+
+/// Result of applying mapping options
+/// Error code is empty on option applied or not requested
+struct MappingStatus {
+    std::error_code populate;
+    std::error_code lock;
+    std::error_code hugePages;
+    std::error_code dontDump;
+
+    /// Return true on all requested options applied
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return !populate && !lock && !hugePages && !dontDump;
+    }
+};
+
 class MappedRegion {
   private:
     std::byte* data_ = nullptr;
@@ -70,6 +98,18 @@ class MappedRegion {
         return {data_, size_};
     }
 
+    /// Lock pages in memory (mlock)
+    auto lock() noexcept -> std::expected<void, std::error_code>;
+
+    /// Give advice about use of memory (madvise)
+    auto advise(int advice) noexcept -> std::expected<void, std::error_code>;
+
+    /// Fault in all pages without modifying content
+    auto populate() noexcept -> std::expected<void, std::error_code>;
+
+    /// Apply options to mapped region (populate option applied last)
+    auto apply(MappingOptions const& options) noexcept -> MappingStatus;
+
     /// Swap resources with other MappedRegion object.
     void swap(MappedRegion& that) noexcept {
         using std::swap;
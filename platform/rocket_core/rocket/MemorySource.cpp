@@ -3,7 +3,9 @@
 
 #include "MemorySource.h"
 
+#include <linux/memfd.h>
 #include <mntent.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -11,9 +13,11 @@
 #include <bit>
 #include <cassert>
 #include <charconv>
+#include <cstdio>
 #include <print>
 #include <ranges>
 #include <regex>
+#include <string>
 #include <string_view>
 #include <system_error>
 #include <vector>
@@ -188,6 +192,25 @@ auto getMountEntryDefault(std::vector<MemoryMountPoint> const& mounts) noexcept
     return {*found};
 }
 
+/// Number of free huge pages of a size
+auto getFreeHugePages(std::size_t pageSize) noexcept -> std::size_t {
+    auto const path = "/sys/kernel/mm/hugepages/hugepages-" + std::to_string(pageSize / 1024) + "kB/free_hugepages";
+    auto handle = ::fopen(path.c_str(), "r");
+    if (!handle) {
+        return 0;
+    }
+
+    ScopeGuard guard([&]() noexcept {
+        ::fclose(handle);
+    });
+
+    std::size_t count = 0;
+    if (std::fscanf(handle, "%zu", &count) != 1) {
+        return 0;
+    }
+    return count;
+}
+
 auto getMountEntryAuto(std::vector<MemoryMountPoint> const& mounts) noexcept
     -> std::expected<MemoryMountPoint, std::error_code> {
     HugePagesOption type = HugePagesOption::HugePages1G;
@@ -275,13 +298,94 @@ auto DefaultMemorySource::open(std::string_view name, OpenFlags flags) const noe
     }
 }
 
+auto DefaultMemorySource::remove(std::string_view name) const noexcept -> std::expected<void, std::error_code> {
+    try {
+        auto const filePath = path_ / name;
+        if (::unlink(filePath.c_str()) != 0 && errno != ENOENT) {
+            return std::unexpected(makePosixErrorCode(errno));
+        }
+        return {};
+    } catch (...) {
+        return std::unexpected(makePosixErrorCode(EFAULT));
+    }
+}
+
+AnonymousMemorySource::AnonymousMemorySource(HugePagesOption hugePagesOpt) : pageSize_(gDefaultPageSize) {
+    switch (hugePagesOpt) {
+    case HugePagesOption::Auto: {
+        // 1G pages are too large for per thread queues
+        if (getFreeHugePages(gPageSize2M) > 0) {
+            flags_ = MFD_HUGETLB | MFD_HUGE_2MB;
+            pageSize_ = gPageSize2M;
+        }
+    } break;
+    case HugePagesOption::None: {
+    } break;
+    case HugePagesOption::HugePages2M: {
+        flags_ = MFD_HUGETLB | MFD_HUGE_2MB;
+        pageSize_ = gPageSize2M;
+    } break;
+    case HugePagesOption::HugePages1G: {
+        flags_ = MFD_HUGETLB | MFD_HUGE_1GB;
+        pageSize_ = gPageSize1G;
+    } break;
+    default: {
+        throw std::system_error(EINVAL, getPosixErrorCategory(), "Invalid hugePagesOpt value");
+    } break;
+    }
+}
+
 auto AnonymousMemorySource::open(std::string_view name, [[maybe_unused]] OpenFlags flags) const noexcept
     -> std::expected<std::tuple<File, std::size_t>, std::error_code> {
-    auto result = File::anonymous(std::string(name).c_str());
+    auto result = File::anonymous(std::string(name).c_str(), flags_);
     if (!result) {
         return std::unexpected(makePosixErrorCode(result.error().value()));
     }
-    return {std::make_tuple(std::move(result).value(), gDefaultPageSize)};
+    return {std::make_tuple(std::move(result).value(), pageSize_)};
+}
+
+NumaMemorySource::NumaMemorySource(std::shared_ptr<MemorySource const> memorySource, int node, NumaPolicy policy)
+    : memorySource_(std::move(memorySource)), node_(node), policy_(policy) {
+    if (!memorySource_) {
+        throw std::system_error(EINVAL, getPosixErrorCategory(), "Memory source is null");
+    }
+    if (node < 0 || node >= getNumaNodesCount()) {
+        throw std::system_error(EINVAL, getPosixErrorCategory(), "Invalid NUMA node");
+    }
+}
+
+auto NumaMemorySource::open(std::string_view name, OpenFlags flags) const noexcept
+    -> std::expected<std::tuple<File, std::size_t>, std::error_code> {
+    auto result = memorySource_->open(name, flags);
+    if (!result) {
+        return result;
+    }
+
+    auto const& [file, pageSize] = result.value();
+    if (pageSize != gDefaultPageSize) {
+        return std::unexpected(makePosixErrorCode(EOPNOTSUPP));
+    }
+
+    // Policy set through any mapping is attached to the file range, so the mapping is not kept
+    auto const data = ::mmap(nullptr, kPolicyRangeSize, PROT_NONE, MAP_SHARED | MAP_NORESERVE, file.get(), 0);
+    if (data == MAP_FAILED) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+
+    ScopeGuard guard([&]() noexcept {
+        ::munmap(data, kPolicyRangeSize);
+    });
+
+    auto const content = std::span<std::byte>(static_cast<std::byte*>(data), kPolicyRangeSize);
+    if (auto const rc = bindToNumaNode(content, node_, policy_); !rc) {
+        return std::unexpected(rc.error());
+    }
+
+    return result;
+}
+
+auto NumaMemorySource::remove(std::string_view name) const noexcept -> std::expected<void, std::error_code> {
+    return memorySource_->remove(name);
 }
 
 } // namespace rocket
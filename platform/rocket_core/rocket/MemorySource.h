@@ -5,10 +5,12 @@
 
 #include <expected>
 #include <filesystem>
+#include <memory>
 #include <string_view>
 #include <tuple>
 
 #include "File.h"
+#include "Numa.h"
 #include "PosixError.h"
 
 namespace rocket {
@@ -26,6 +28,13 @@ struct MemorySource {
         -> std::expected<std::tuple<File, std::size_t>, std::error_code> {
         return std::unexpected(makePosixErrorCode(ENOSYS));
     }
+
+    /// Remove memory source name, memory opened already stays valid
+    /// Sources creating a new memory on each open have nothing to remove
+    /// \param[in] name is memory source name
+    virtual auto remove([[maybe_unused]] std::string_view name) const noexcept -> std::expected<void, std::error_code> {
+        return {};
+    }
 };
 
 /// HugePages option selector
@@ -47,16 +56,78 @@ class DefaultMemorySource final : public MemorySource {
     /// Throws on error
     DefaultMemorySource(std::filesystem::path const& path, std::size_t pageSize);
 
+    /// Directory where files are created
+    [[nodiscard]] auto path() const noexcept -> std::filesystem::path const& {
+        return path_;
+    }
+
     /// \see MemorySource::open
     [[nodiscard]] auto open(std::string_view name, OpenFlags flags) const noexcept
         -> std::expected<std::tuple<File, std::size_t>, std::error_code> override;
+
+    /// Unlink the file, missing file is not an error
+    /// \see MemorySource::remove
+    auto remove(std::string_view name) const noexcept -> std::expected<void, std::error_code> override;
 };
 
 /// Anonymous memory source
-struct AnonymousMemorySource final : public MemorySource {
+/// Each open creates a new memory (memfd), name is used for debugging purposes only
+class AnonymousMemorySource final : public MemorySource {
+  private:
+    unsigned int flags_ = 0;
+    std::size_t pageSize_;
+
+  public:
+    /// Construct memory source
+    /// \param[in] hugePagesOpt is huge pages option, Auto selects 2M huge pages on free pages are available
+    /// Mapping fails on there are no free huge pages of the requested size
+    /// Throws on error
+    explicit AnonymousMemorySource(HugePagesOption hugePagesOpt = HugePagesOption::None);
+
+    /// Page size
+    [[nodiscard]] auto pageSize() const noexcept -> std::size_t {
+        return pageSize_;
+    }
+
+    /// \see MemorySource::open
+    [[nodiscard]] auto open(std::string_view name, OpenFlags flags) const noexcept
+        -> std::expected<std::tuple<File, std::size_t>, std::error_code> override;
+};
+
+/// NUMA memory source
+/// Memory of the underlying source is bound to a NUMA node with shared memory policy, so pages are allocated on the
+/// node no matter which thread or process faults them in. Pass the node of consumer core (see getNumaNodeOfCoreNo)
+/// to keep queue memory local to the consumer. The underlying source must provide shared memory files (tmpfs or
+/// memfd without huge pages), policy is not attached to hugetlbfs files and open fails with EOPNOTSUPP.
+class NumaMemorySource final : public MemorySource {
+  public:
+    /// Max file size covered by policy
+    static constexpr std::size_t kPolicyRangeSize = std::size_t(64) << 30;
+
+  private:
+    std::shared_ptr<MemorySource const> memorySource_;
+    int node_;
+    NumaPolicy policy_;
+
+  public:
+    /// Construct memory source
+    /// \param[in] memorySource is underlying memory source
+    /// \param[in] node is NUMA node to allocate memory on
+    /// \param[in] policy is NUMA policy
+    /// Throws on error
+    NumaMemorySource(std::shared_ptr<MemorySource const> memorySource, int node, NumaPolicy policy = NumaPolicy::Bind);
+
+    /// NUMA node
+    [[nodiscard]] auto node() const noexcept -> int {
+        return node_;
+    }
+
     /// \see MemorySource::open
     [[nodiscard]] auto open(std::string_view name, OpenFlags flags) const noexcept
         -> std::expected<std::tuple<File, std::size_t>, std::error_code> override;
+
+    /// \see MemorySource::remove
+    auto remove(std::string_view name) const noexcept -> std::expected<void, std::error_code> override;
 };
 
 } // namespace rocket
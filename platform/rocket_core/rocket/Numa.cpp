@@ -0,0 +1,151 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "Numa.h"
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace rocket {
+namespace {
+
+constexpr std::size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+
+/// Parse node number from directory entry name "nodeN"
+[[nodiscard]] auto parseNodeEntry(std::string_view name) noexcept -> std::expected<int, std::error_code> {
+    using namespace std::string_view_literals;
+
+    if (!name.starts_with("node"sv)) {
+        return std::unexpected(makePosixErrorCode(ENOENT));
+    }
+    name.remove_prefix("node"sv.size());
+
+    int node = 0;
+    auto const rc = std::from_chars(name.data(), name.data() + name.size(), node);
+    if (rc.ec != std::errc() || rc.ptr != name.data() + name.size()) {
+        return std::unexpected(makePosixErrorCode(ENOENT));
+    }
+    return {node};
+}
+
+} // namespace
+
+auto isNumaAvailable() noexcept -> bool {
+    int mode = 0;
+    return ::syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0) == 0 || errno != ENOSYS;
+}
+
+auto getNumaNodesCount() noexcept -> int {
+    std::error_code ec;
+    auto iterator = std::filesystem::directory_iterator("/sys/devices/system/node", ec);
+    if (ec) {
+        return 1;
+    }
+
+    int count = 1;
+    for (; iterator != std::filesystem::directory_iterator(); iterator.increment(ec)) {
+        if (auto const node = parseNodeEntry(iterator->path().filename().native()); node) {
+            count = std::max(count, node.value() + 1);
+        }
+    }
+    return count;
+}
+
+auto getCurrentNumaNode() noexcept -> std::expected<int, std::error_code> {
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+    return {static_cast<int>(node)};
+}
+
+auto getNumaNodeOfCoreNo(std::uint16_t coreNo) noexcept -> std::expected<int, std::error_code> {
+    std::error_code ec;
+    auto iterator = std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu" + std::to_string(coreNo), ec);
+    if (ec) {
+        return std::unexpected(makePosixErrorCode(ec.value()));
+    }
+
+    for (; iterator != std::filesystem::directory_iterator(); iterator.increment(ec)) {
+        if (auto const node = parseNodeEntry(iterator->path().filename().native()); node) {
+            return node;
+        }
+    }
+
+    // Kernel without NUMA support
+    return {0};
+}
+
+auto bindToNumaNode(std::span<std::byte> content, int node, NumaPolicy policy) noexcept
+    -> std::expected<void, std::error_code> {
+    if (node < 0) {
+        return std::unexpected(makePosixErrorCode(EINVAL));
+    }
+
+    std::vector<unsigned long> nodeMask;
+    try {
+        nodeMask.resize(static_cast<std::size_t>(node) / kBitsPerWord + 1);
+    } catch (...) {
+        return std::unexpected(makePosixErrorCode(ENOMEM));
+    }
+    nodeMask[static_cast<std::size_t>(node) / kBitsPerWord] |= 1ul << (static_cast<std::size_t>(node) % kBitsPerWord);
+
+    // Kernel takes one bit less than maxnode
+    auto const maxNode = nodeMask.size() * kBitsPerWord + 1;
+    auto const mode = (policy == NumaPolicy::Bind) ? MPOL_BIND : MPOL_PREFERRED;
+
+    // Pages already faulted in are moved to the node
+    if (::syscall(SYS_mbind, content.data(), content.size(), mode, nodeMask.data(), maxNode, MPOL_MF_MOVE) != 0) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+    return {};
+}
+
+auto getNumaNodes(std::span<std::byte const> content, std::size_t pageSize) noexcept
+    -> std::expected<std::vector<int>, std::error_code> {
+    if (pageSize == 0) {
+        return std::unexpected(makePosixErrorCode(EINVAL));
+    }
+
+    std::vector<void*> pages;
+    std::vector<int> status;
+    try {
+        auto const count = (content.size() + pageSize - 1) / pageSize;
+        pages.reserve(count);
+        for (std::size_t offset = 0; offset < content.size(); offset += pageSize) {
+            pages.push_back(const_cast<std::byte*>(content.data() + offset));
+        }
+        status.resize(count);
+    } catch (...) {
+        return std::unexpected(makePosixErrorCode(ENOMEM));
+    }
+
+    // Without target nodes move_pages only reports current placement
+    if (::syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) {
+        return std::unexpected(makePosixErrorCode(errno));
+    }
+    return {std::move(status)};
+}
+
+auto isPlacedOnNumaNode(std::span<std::byte const> content, std::size_t pageSize, int node) noexcept
+    -> std::expected<bool, std::error_code> {
+    auto const nodes = getNumaNodes(content, pageSize);
+    if (!nodes) {
+        return std::unexpected(nodes.error());
+    }
+    return {std::ranges::all_of(nodes.value(), [node](int value) {
+        return value == node;
+    })};
+}
+
+} // namespace rocket
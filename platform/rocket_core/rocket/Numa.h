@@ -0,0 +1,51 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+#include "PosixError.h"
+
+namespace rocket {
+
+/// NUMA memory policy
+enum class NumaPolicy {
+    /// Allocate strictly on the node, fails on the node is out of memory
+    Bind,
+    /// Allocate on the node if possible, fall back to other nodes
+    Preferred
+};
+
+/// Return true on kernel supports NUMA memory policies (get_mempolicy doesn't fail with ENOSYS)
+[[nodiscard]] auto isNumaAvailable() noexcept -> bool;
+
+/// Number of NUMA nodes configured (1 on non-NUMA host)
+[[nodiscard]] auto getNumaNodesCount() noexcept -> int;
+
+/// NUMA node of the core current thread running on
+[[nodiscard]] auto getCurrentNumaNode() noexcept -> std::expected<int, std::error_code>;
+
+/// NUMA node of the core
+[[nodiscard]] auto getNumaNodeOfCoreNo(std::uint16_t coreNo) noexcept -> std::expected<int, std::error_code>;
+
+/// Set memory policy for the range (mbind), pages faulted in later are allocated on the node
+/// For shared memory (tmpfs, memfd) policy is attached to the file and applied to all mappings
+/// \param[in] content is page aligned range
+auto bindToNumaNode(std::span<std::byte> content, int node, NumaPolicy policy = NumaPolicy::Bind) noexcept
+    -> std::expected<void, std::error_code>;
+
+/// NUMA node of each page of the range (move_pages), negative errno for pages not faulted in
+/// \param[in] pageSize is page size of the range
+[[nodiscard]] auto getNumaNodes(std::span<std::byte const> content, std::size_t pageSize) noexcept
+    -> std::expected<std::vector<int>, std::error_code>;
+
+/// Return true on all pages of the range placed on the node
+[[nodiscard]] auto isPlacedOnNumaNode(std::span<std::byte const> content, std::size_t pageSize, int node) noexcept
+    -> std::expected<bool, std::error_code>;
+
+} // namespace rocket
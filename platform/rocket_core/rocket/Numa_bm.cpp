@@ -0,0 +1,86 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BoundedSPSCRawQueue.h"
+#include "MemorySource.h"
+#include "Numa.h"
+#include "TestUtils.h"
+#include "ThreadUtils.h"
+
+namespace rocket::testing {
+
+/// Cores of the NUMA node
+static auto getCoresOfNumaNode(int node) -> std::vector<std::uint16_t> {
+    std::vector<std::uint16_t> cores;
+    auto const coresCount = std::thread::hardware_concurrency();
+    for (unsigned int coreNo = 0; coreNo < coresCount; ++coreNo) {
+        if (auto const coreNode = getNumaNodeOfCoreNo(coreNo); coreNode && coreNode.value() == node) {
+            cores.push_back(static_cast<std::uint16_t>(coreNo));
+        }
+    }
+    return cores;
+}
+
+/// SPSC round trip: producer and echo threads run on node 0, queue memory is on node of the first argument
+static void BM_SPSC_RoundTrip(::benchmark::State& state) {
+    constexpr int kThreadsNode = 0;
+    auto const memoryNode = static_cast<int>(state.range(0));
+    if (memoryNode >= getNumaNodesCount()) {
+        state.SkipWithError("NUMA node is not available");
+        return;
+    }
+
+    auto const cores = getCoresOfNumaNode(kThreadsNode);
+    auto const pin = [&](std::size_t index) {
+        if (index < cores.size()) {
+            [[maybe_unused]] auto const rc = pinCurrentThreadToCoreNo(cores[index]);
+        }
+    };
+
+    auto const memorySource = NumaMemorySource(std::make_shared<AnonymousMemorySource>(), memoryNode);
+    auto ping = BoundedSPSCRawQueue("bm-ping", {std::size_t(1) << 20}, memorySource);
+    auto pong = BoundedSPSCRawQueue("bm-pong", {std::size_t(1) << 20}, memorySource);
+
+    std::atomic<bool> stop{false};
+    auto echo = std::jthread([&] {
+        pin(1);
+        auto consumer = ping.createConsumer();
+        auto producer = pong.createProducer();
+        std::uint64_t value = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (dequeue(consumer, value)) {
+                while (!enqueue(producer, value)) {}
+            }
+        }
+    });
+
+    pin(0);
+    auto producer = ping.createProducer();
+    auto consumer = pong.createConsumer();
+
+    std::uint64_t counter = 0;
+    std::uint64_t value = 0;
+
+    for (auto _ : state) {
+        while (!enqueue(producer, counter++)) {}
+        while (!dequeue(consumer, value)) {}
+        benchmark::DoNotOptimize(value);
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(memoryNode == kThreadsNode ? "local" : "remote");
+}
+
+BENCHMARK(BM_SPSC_RoundTrip)->Arg(0)->Arg(1)->UseRealTime();
+
+} // namespace rocket::testing
@@ -0,0 +1,80 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include <doctest/doctest.h>
+
+#include "BoundedSPSCRawQueue.h"
+#include "MemorySource.h"
+#include "Numa.h"
+#include "TestUtils.h"
+#include "detail/memory.h"
+
+namespace rocket {
+
+TEST_CASE("NUMA nodes") {
+    REQUIRE(getNumaNodesCount() >= 1);
+
+    auto const node = getCurrentNumaNode();
+    REQUIRE(node.has_value());
+    REQUIRE(node.value() >= 0);
+    REQUIRE(node.value() < getNumaNodesCount());
+
+    auto const coreNode = getNumaNodeOfCoreNo(0);
+    REQUIRE(coreNode.has_value());
+    REQUIRE(coreNode.value() < getNumaNodesCount());
+}
+
+TEST_CASE("NUMA memory source") {
+    constexpr std::size_t kSize = 1 << 20;
+
+    if (!isNumaAvailable()) {
+        MESSAGE("kernel without NUMA support, skipped");
+        return;
+    }
+
+    auto const node = getNumaNodesCount() - 1;
+    auto const memorySource = NumaMemorySource(std::make_shared<AnonymousMemorySource>(), node);
+    REQUIRE(memorySource.node() == node);
+
+    SUBCASE("placement") {
+        auto result = memorySource.open("numa-test", MemorySource::OpenOrCreate);
+        REQUIRE(result.has_value());
+        auto [file, pageSize] = std::move(result).value();
+
+        file.truncate(kSize);
+        auto region = detail::mapFile(file, kSize);
+        std::ranges::fill(region.content(), std::byte{0x5a});
+
+        auto const placed = isPlacedOnNumaNode(region.content(), pageSize, node);
+        REQUIRE(placed.has_value());
+        REQUIRE(placed.value());
+    }
+
+    SUBCASE("queue") {
+        auto queue = BoundedSPSCRawQueue("numa-test", {kSize}, memorySource);
+        auto producer = queue.createProducer();
+        auto consumer = queue.createConsumer();
+
+        std::uint64_t value = 0;
+        REQUIRE(testing::enqueue(producer, std::uint64_t(42)));
+        REQUIRE(testing::dequeue(consumer, value));
+        REQUIRE(value == 42);
+    }
+
+    SUBCASE("huge pages are not supported") {
+        auto const hugePages =
+            NumaMemorySource(std::make_shared<AnonymousMemorySource>(HugePagesOption::HugePages2M), node);
+        REQUIRE_FALSE(hugePages.open("numa-test", MemorySource::OpenOrCreate).has_value());
+    }
+}
+
+TEST_CASE("NUMA memory source invalid node") {
+    REQUIRE_THROWS(NumaMemorySource(std::make_shared<AnonymousMemorySource>(), getNumaNodesCount()));
+    REQUIRE_THROWS(NumaMemorySource(nullptr, 0));
+}
+
+} // namespace rocket
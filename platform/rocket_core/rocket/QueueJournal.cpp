@@ -0,0 +1,241 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "QueueJournal.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <format>
+#include <print>
+#include <system_error>
+
+#include "detail/memory.h"
+
+namespace rocket {
+namespace detail {
+namespace {
+
+constexpr std::string_view kSegmentSuffix = ".journal";
+
+} // namespace
+
+auto QueueJournalDetail::segmentFileName(std::string_view name, std::uint64_t index) -> std::string {
+    return std::format("{}.{:08}{}", name, index, kSegmentSuffix);
+}
+
+auto QueueJournalDetail::listSegments(std::filesystem::path const& directory, std::string_view name)
+    -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> result;
+    for (auto const& entry : std::filesystem::directory_iterator(directory)) {
+        auto const fileName = entry.path().filename().string();
+        std::string_view view = fileName;
+        if (!view.starts_with(name) || !view.ends_with(kSegmentSuffix)) {
+            continue;
+        }
+        view.remove_prefix(name.size());
+        view.remove_suffix(kSegmentSuffix.size());
+        if (view.size() < 2 || view.front() != '.') {
+            continue;
+        }
+        view.remove_prefix(1);
+
+        std::uint64_t index = 0;
+        auto const [end, ec] = std::from_chars(view.data(), view.data() + view.size(), index);
+        if (ec == std::errc() && end == view.data() + view.size()) {
+            result.push_back(index);
+        }
+    }
+    std::ranges::sort(result);
+    return result;
+}
+
+} // namespace detail
+
+QueueJournalWriter::QueueJournalWriter(QueueJournalOptions options) : options_(std::move(options)) {
+    using Detail = detail::QueueJournalDetail;
+
+    if (options_.name.empty()) {
+        throw std::runtime_error("invalid argument (name)");
+    }
+    if (options_.writeBufferSize < Detail::recordSize(0)) {
+        throw std::runtime_error("invalid argument (write buffer size)");
+    }
+    if (options_.segmentSize < sizeof(Detail::SegmentHeader) + Detail::recordSize(0)) {
+        throw std::runtime_error("invalid argument (segment size)");
+    }
+
+    buffer_ = std::make_unique<std::byte[]>(options_.writeBufferSize);
+
+    auto const segments = Detail::listSegments(options_.directory, options_.name);
+    openSegment(segments.empty() ? 0 : segments.back() + 1);
+}
+
+QueueJournalWriter::~QueueJournalWriter() noexcept {
+    try {
+        flush();
+    } catch (std::exception const& e) {
+        std::print(stderr, "failed to flush queue journal: {}\n", e.what());
+    }
+}
+
+void QueueJournalWriter::flush() {
+    if (bufferBytes_ > 0) {
+        write({buffer_.get(), bufferBytes_});
+        bufferBytes_ = 0;
+    }
+    if (options_.sync && unsynced_) {
+        sync();
+    }
+}
+
+void QueueJournalWriter::appendSlow(std::int64_t timestamp, std::span<std::byte const> payload) {
+    using Detail = detail::QueueJournalDetail;
+
+    if (payload.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("invalid argument (payload size)");
+    }
+
+    auto const size = Detail::recordSize(payload.size());
+    flush();
+
+    // Record larger than segment limit takes own segment
+    if (segmentBytes_ + size > options_.segmentSize && segmentBytes_ > sizeof(Detail::SegmentHeader)) {
+        openSegment(segmentIndex_ + 1);
+    }
+
+    if (size <= options_.writeBufferSize && segmentBytes_ + size <= options_.segmentSize) {
+        append(timestamp, payload);
+        return;
+    }
+
+    // Record larger than write buffer (or segment limit) is written directly
+    auto const header = Detail::RecordHeader{
+        .timestamp = timestamp,
+        .size = static_cast<std::uint32_t>(payload.size()),
+        .magic = Detail::kRecordMagic,
+    };
+    std::byte const padding[Detail::kAlign] = {};
+    write(std::as_bytes(std::span(&header, 1)));
+    write(payload);
+    write({padding, size - sizeof(header) - payload.size()});
+    segmentBytes_ += size;
+}
+
+void QueueJournalWriter::openSegment(std::uint64_t index) {
+    using Detail = detail::QueueJournalDetail;
+
+    auto const path = options_.directory / Detail::segmentFileName(options_.name, index);
+    file_ = File(kCreateOnly, path, OpenMode::ReadWrite, 0644);
+    segmentIndex_ = index;
+    segmentBytes_ = 0;
+
+    auto header = Detail::SegmentHeader{};
+    std::copy(Detail::kTag.begin(), Detail::kTag.end(), header.tag);
+    header.version = Detail::kVersion;
+    header.index = index;
+    header.createdAt = detail::journalClockNow();
+    write(std::as_bytes(std::span(&header, 1)));
+    segmentBytes_ = sizeof(header);
+
+    if (options_.sync) {
+        sync();
+        // Directory entry of the new segment
+        auto const directory = File(kOpenOnly, options_.directory.empty() ? "." : options_.directory);
+        if (::fsync(directory.get()) == -1) {
+            throw std::system_error(errno, getPosixErrorCategory(), "fsync(...)");
+        }
+    }
+}
+
+void QueueJournalWriter::write(std::span<std::byte const> data) {
+    while (!data.empty()) {
+        auto const rc = ::write(file_.get(), data.data(), data.size());
+        if (rc == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, getPosixErrorCategory(), "write(...)");
+        }
+        data = data.subspan(static_cast<std::size_t>(rc));
+        unsynced_ = true;
+    }
+}
+
+void QueueJournalWriter::sync() {
+    if (::fdatasync(file_.get()) == -1) {
+        throw std::system_error(errno, getPosixErrorCategory(), "fdatasync(...)");
+    }
+    unsynced_ = false;
+}
+
+QueueJournalReader::QueueJournalReader(std::filesystem::path directory, std::string name)
+    : directory_(std::move(directory)), name_(std::move(name)) {
+    segments_ = detail::QueueJournalDetail::listSegments(directory_, name_);
+}
+
+QueueJournalReader::QueueJournalReader(std::filesystem::path directory, std::string name, std::uint64_t segmentIndex)
+    : directory_(std::move(directory)), name_(std::move(name)), segments_{segmentIndex} {
+    if (!std::filesystem::exists(directory_ / detail::QueueJournalDetail::segmentFileName(name_, segmentIndex))) {
+        throw std::runtime_error("failed to open journal segment (not found)");
+    }
+}
+
+auto QueueJournalReader::next() -> std::optional<QueueJournalRecord> {
+    using Detail = detail::QueueJournalDetail;
+
+    while (true) {
+        if (storage_) {
+            auto const content = storage_.content();
+            if (pos_ + sizeof(Detail::RecordHeader) <= content.size()) {
+                auto const header = std::bit_cast<Detail::RecordHeader const*>(content.data() + pos_);
+                auto const size = Detail::recordSize(header->size);
+                // Segment tail of crashed recorder is incomplete
+                if (header->magic == Detail::kRecordMagic && pos_ + size <= content.size()) {
+                    auto record = QueueJournalRecord{
+                        .timestamp = header->timestamp,
+                        .payload = content.subspan(pos_ + sizeof(Detail::RecordHeader), header->size),
+                    };
+                    pos_ += size;
+                    return record;
+                }
+            }
+        }
+        if (!openNextSegment()) {
+            return std::nullopt;
+        }
+    }
+}
+
+auto QueueJournalReader::openNextSegment() -> bool {
+    using Detail = detail::QueueJournalDetail;
+
+    storage_ = MappedRegion();
+    pos_ = 0;
+
+    while (nextSegment_ < segments_.size()) {
+        auto const index = segments_[nextSegment_++];
+        auto const file = File(kOpenOnly, directory_ / Detail::segmentFileName(name_, index), OpenMode::ReadOnly);
+        auto const fileSize = file.getFileSize();
+        if (fileSize < sizeof(Detail::SegmentHeader)) {
+            continue;
+        }
+
+        auto storage = detail::mapReadOnly(file, fileSize);
+        auto const header = std::bit_cast<Detail::SegmentHeader const*>(storage.data());
+        if (!std::equal(Detail::kTag.begin(), Detail::kTag.end(), header->tag) || header->version != Detail::kVersion) {
+            throw std::runtime_error("invalid journal segment");
+        }
+        [[maybe_unused]] auto const rc = storage.advise(MADV_SEQUENTIAL);
+
+        storage_ = std::move(storage);
+        pos_ = sizeof(Detail::SegmentHeader);
+        return true;
+    }
+    return false;
+}
+
+} // namespace rocket
@@ -0,0 +1,408 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BoundedSPMCRawQueue.h"
+#include "File.h"
+#include "MappedRegion.h"
+#include "Platform.h"
+
+namespace rocket {
+namespace detail {
+
+/// Journal segment file layout
+///
+/// Segment is append-only sequence of records following the segment header, records are 8-byte aligned.
+/// Record with zero-filled header (or truncated record) marks the end of segment written by crashed recorder.
+struct QueueJournalDetail {
+    static constexpr std::string_view kTag = "rocket/journal";
+    static constexpr std::uint64_t kVersion = 1;
+    static constexpr std::size_t kAlign = 8;
+
+    /// Segment file header
+    struct SegmentHeader {
+        char tag[16];
+        std::uint64_t version;
+        /// Segment index in journal
+        std::uint64_t index;
+        /// Wall clock (ns since epoch) of segment creation
+        std::int64_t createdAt;
+        std::uint64_t reserved[3];
+    };
+    static_assert(sizeof(SegmentHeader) == 64);
+
+    /// Record header
+    struct RecordHeader {
+        /// Wall clock (ns since epoch) of message capture
+        std::int64_t timestamp;
+        /// Payload size
+        std::uint32_t size;
+        /// Nonzero for valid record
+        std::uint32_t magic;
+    };
+    static_assert(sizeof(RecordHeader) == 16);
+
+    static constexpr std::uint32_t kRecordMagic = 0x6c6e726a;
+
+    /// Record size including header and padding
+    [[nodiscard]] static constexpr auto recordSize(std::size_t payloadSize) noexcept -> std::size_t {
+        return sizeof(RecordHeader) + ((payloadSize + kAlign - 1) & ~(kAlign - 1));
+    }
+
+    /// Segment file name
+    [[nodiscard]] static auto segmentFileName(std::string_view name, std::uint64_t index) -> std::string;
+
+    /// Segment indices of journal in the directory in ascending order
+    [[nodiscard]] static auto listSegments(std::filesystem::path const& directory, std::string_view name)
+        -> std::vector<std::uint64_t>;
+};
+
+/// Wall clock (ns since epoch) used for journal timestamps
+[[nodiscard]] ROCKET_FORCE_INLINE auto journalClockNow() noexcept -> std::int64_t {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+/// Monotonic clock (ns) used for replay pacing
+[[nodiscard]] ROCKET_FORCE_INLINE auto replayClockNow() noexcept -> std::int64_t {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+} // namespace detail
+
+/// Queue journal options
+struct QueueJournalOptions {
+    /// Directory of segment files
+    std::filesystem::path directory;
+    /// Journal name, segments are named "<name>.<index>.journal"
+    std::string name;
+    /// Segment size limit, segment is rolled over on next record exceeds it
+    std::size_t segmentSize = std::size_t(1) << 30;
+    /// Write buffer size, records are written by buffer sized writes
+    std::size_t writeBufferSize = std::size_t(1) << 20;
+    /// Sync written records to disk (fdatasync) on flush() and segment roll, new segments are made durable with
+    /// directory fsync. Records survive power loss up to the last flush, each flush waits for the disk.
+    bool sync = false;
+};
+
+/// Journal record
+struct QueueJournalRecord {
+    /// Wall clock (ns since epoch) of message capture
+    std::int64_t timestamp = 0;
+    /// Message payload, valid until next record read
+    std::span<std::byte const> payload;
+};
+
+/// Append-only journal writer
+/// Records are accumulated in write buffer and written to current segment file with large sequential writes.
+/// New segment is started after the last existing one, so journal is never overwritten.
+class QueueJournalWriter {
+  private:
+    QueueJournalOptions options_;
+    File file_;
+    std::uint64_t segmentIndex_ = 0;
+    std::size_t segmentBytes_ = 0;
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t bufferBytes_ = 0;
+    bool unsynced_ = false;
+
+  public:
+    QueueJournalWriter(QueueJournalWriter const&) = delete;
+    QueueJournalWriter& operator=(QueueJournalWriter const&) = delete;
+
+    QueueJournalWriter(QueueJournalWriter&& that) noexcept {
+        swap(that);
+    }
+
+    QueueJournalWriter& operator=(QueueJournalWriter&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    QueueJournalWriter() = default;
+
+    /// Open journal for appending
+    /// Throws on error
+    explicit QueueJournalWriter(QueueJournalOptions options);
+
+    /// Destructor. Flush write buffer
+    ~QueueJournalWriter() noexcept;
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return file_.valid();
+    }
+
+    /// Current segment index
+    [[nodiscard]] auto segmentIndex() const noexcept -> std::uint64_t {
+        return segmentIndex_;
+    }
+
+    /// Append record
+    /// Throws on error
+    ROCKET_FORCE_INLINE void append(std::int64_t timestamp, std::span<std::byte const> payload) {
+        auto const size = detail::QueueJournalDetail::recordSize(payload.size());
+        if (bufferBytes_ + size <= options_.writeBufferSize && segmentBytes_ + size <= options_.segmentSize)
+            [[likely]] {
+            auto const header = std::bit_cast<detail::QueueJournalDetail::RecordHeader*>(buffer_.get() + bufferBytes_);
+            header->timestamp = timestamp;
+            header->size = static_cast<std::uint32_t>(payload.size());
+            header->magic = detail::QueueJournalDetail::kRecordMagic;
+            std::copy(payload.begin(), payload.end(), buffer_.get() + bufferBytes_ + sizeof(*header));
+            bufferBytes_ += size;
+            segmentBytes_ += size;
+            return;
+        }
+        appendSlow(timestamp, payload);
+    }
+
+    /// Write buffered records to segment file, sync it on QueueJournalOptions::sync set
+    /// Throws on error
+    void flush();
+
+    /// Swap resources with other writer
+    void swap(QueueJournalWriter& that) noexcept {
+        using std::swap;
+        swap(options_, that.options_);
+        swap(file_, that.file_);
+        swap(segmentIndex_, that.segmentIndex_);
+        swap(segmentBytes_, that.segmentBytes_);
+        swap(buffer_, that.buffer_);
+        swap(bufferBytes_, that.bufferBytes_);
+        swap(unsynced_, that.unsynced_);
+    }
+
+    /// \see QueueJournalWriter::swap
+    friend void swap(QueueJournalWriter& a, QueueJournalWriter& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    void appendSlow(std::int64_t timestamp, std::span<std::byte const> payload);
+    void openSegment(std::uint64_t index);
+    void write(std::span<std::byte const> data);
+    void sync();
+};
+
+/// Sequential journal reader
+/// Segments are mapped read-only one at a time in index order.
+class QueueJournalReader {
+  private:
+    std::filesystem::path directory_;
+    std::string name_;
+    std::vector<std::uint64_t> segments_;
+    std::size_t nextSegment_ = 0;
+    MappedRegion storage_;
+    std::size_t pos_ = 0;
+
+  public:
+    QueueJournalReader(QueueJournalReader const&) = delete;
+    QueueJournalReader& operator=(QueueJournalReader const&) = delete;
+
+    QueueJournalReader(QueueJournalReader&&) noexcept = default;
+    QueueJournalReader& operator=(QueueJournalReader&&) noexcept = default;
+
+    QueueJournalReader() = default;
+
+    /// Open all segments of journal existing in the directory
+    /// Throws on error
+    QueueJournalReader(std::filesystem::path directory, std::string name);
+
+    /// Open single segment
+    /// Throws on error
+    QueueJournalReader(std::filesystem::path directory, std::string name, std::uint64_t segmentIndex);
+
+    /// Read next record, std::nullopt on end of journal
+    /// Throws on invalid segment
+    [[nodiscard]] auto next() -> std::optional<QueueJournalRecord>;
+
+  private:
+    auto openNextSegment() -> bool;
+};
+
+/// SPMC queue recorder
+/// Consumes queue as a regular consumer and appends messages to journal with capture timestamps.
+/// Recorder have to keep up with the producer, messages overwritten before being polled are lost.
+template <typename Traits = BoundedSPMCRawQueueDefaultTraits>
+class BoundedSPMCRawQueueRecorder {
+  private:
+    detail::BoundedSPMCRawQueueConsumer<Traits> consumer_;
+    QueueJournalWriter writer_;
+
+  public:
+    BoundedSPMCRawQueueRecorder() = default;
+
+    /// Construct recorder over queue consumer
+    BoundedSPMCRawQueueRecorder(detail::BoundedSPMCRawQueueConsumer<Traits>&& consumer, QueueJournalWriter&& writer)
+        : consumer_(std::move(consumer)), writer_(std::move(writer)) {}
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return static_cast<bool>(consumer_) && static_cast<bool>(writer_);
+    }
+
+    /// Append available messages (up to limit) to journal, return number of messages recorded
+    /// Throws on write error
+    auto poll(std::size_t limit = std::numeric_limits<std::size_t>::max()) -> std::size_t {
+        std::size_t count = 0;
+        for (; count < limit; ++count) {
+            auto const buffer = consumer_.fetch();
+            if (buffer.empty()) {
+                break;
+            }
+            writer_.append(detail::journalClockNow(), buffer);
+            consumer_.consume();
+        }
+        return count;
+    }
+
+    /// Write buffered records to journal
+    void flush() {
+        writer_.flush();
+    }
+};
+
+/// SPMC queue replayer
+/// Publishes journal records into queue keeping recorded intervals divided by speed.
+template <typename Traits = BoundedSPMCRawQueueDefaultTraits>
+class BoundedSPMCRawQueueReplayer {
+  private:
+    using QueueDetail = detail::BoundedSPMCRawQueueDetail<Traits>;
+    using MessageHeader = typename QueueDetail::MessageHeader;
+
+    detail::BoundedSPMCRawQueueProducer<Traits> producer_;
+    QueueJournalReader reader_;
+    double speed_ = 1.0;
+    std::optional<QueueJournalRecord> next_;
+    std::int64_t firstTimestamp_ = 0;
+    std::int64_t startedAt_ = 0;
+    std::int64_t timestamp_ = 0;
+
+  public:
+    BoundedSPMCRawQueueReplayer() = default;
+
+    /// Construct replayer over queue producer
+    /// \param[in] speed is pace multiplier: 1 is original pace, 10 is ten times faster, 0 is as fast as possible
+    BoundedSPMCRawQueueReplayer(
+        detail::BoundedSPMCRawQueueProducer<Traits>&& producer, QueueJournalReader&& reader, double speed = 1.0)
+        : producer_(std::move(producer)), reader_(std::move(reader)), speed_(speed) {
+        if (speed < 0.0) {
+            throw std::runtime_error("invalid argument (speed)");
+        }
+        next_ = reader_.next();
+        if (next_) {
+            firstTimestamp_ = next_->timestamp;
+        }
+    }
+
+    /// Return true on all records replayed
+    [[nodiscard]] auto done() const noexcept -> bool {
+        return !next_;
+    }
+
+    /// Recorded timestamp of the last published record, replay clock for backtests
+    [[nodiscard]] auto timestamp() const noexcept -> std::int64_t {
+        return timestamp_;
+    }
+
+    /// Publish records due by now, return number of records published
+    /// Replay starts on the first call. Stops on queue is full (slow consumer backpressure), the record is published
+    /// by the next call, records delayed by full queue are published back to back.
+    /// Throws on message exceeds queue capacity or invalid journal
+    auto poll() -> std::size_t {
+        auto const now = detail::replayClockNow();
+        if (startedAt_ == 0) {
+            startedAt_ = now;
+        }
+        std::size_t count = 0;
+        while (next_ && dueAt(next_->timestamp) <= now) {
+            if (!publish()) {
+                break;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    /// Publish all records, sleeping between them, return number of records published
+    /// Waits for consumers on queue is full
+    /// Throws on message exceeds queue capacity or invalid journal
+    auto run() -> std::size_t {
+        std::size_t count = 0;
+        while (next_) {
+            count += poll();
+            if (!next_) {
+                break;
+            }
+            if (auto const deadline = dueAt(next_->timestamp); deadline > detail::replayClockNow()) {
+                sleepUntil(deadline);
+            } else {
+                // Queue is full
+                std::this_thread::yield();
+            }
+        }
+        return count;
+    }
+
+  private:
+    [[nodiscard]] auto dueAt(std::int64_t timestamp) const noexcept -> std::int64_t {
+        if (speed_ == 0.0) {
+            return startedAt_;
+        }
+        return startedAt_ + static_cast<std::int64_t>(static_cast<double>(timestamp - firstTimestamp_) / speed_);
+    }
+
+    static void sleepUntil(std::int64_t deadline) noexcept {
+        // Sleep is coarse, spin last 50us to keep intervals precise
+        constexpr std::int64_t kSpinThreshold = 50000;
+        for (auto now = detail::replayClockNow(); now < deadline; now = detail::replayClockNow()) {
+            if (deadline - now > kSpinThreshold) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(deadline - now - kSpinThreshold));
+            }
+        }
+    }
+
+    /// Publish the next record, return false on queue is full
+    [[nodiscard]] auto publish() -> bool {
+        auto const payload = next_->payload;
+        // Wrapped message has to fit data buffer
+        if (QueueDetail::alignBufferSize(payload.size() + sizeof(MessageHeader)) + sizeof(MessageHeader) +
+                QueueDetail::kDataStartPos >
+            producer_.capacity()) {
+            throw std::runtime_error("message exceeds queue capacity");
+        }
+        auto buffer = producer_.prepare(payload.size());
+        if (buffer.empty()) [[unlikely]] {
+            return false;
+        }
+        std::copy(payload.begin(), payload.end(), buffer.begin());
+        producer_.commit();
+        timestamp_ = next_->timestamp;
+        next_ = reader_.next();
+        return true;
+    }
+};
+
+} // namespace rocket
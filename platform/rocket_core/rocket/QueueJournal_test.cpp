@@ -0,0 +1,227 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "QueueJournal.h"
+#include "TestUtils.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Temporary journal directory removed on scope exit
+struct JournalDirectory {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("rocket-journal-test-" + std::to_string(::getpid()));
+
+    JournalDirectory() {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+
+    ~JournalDirectory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+auto makePayload(std::size_t size, std::uint8_t seed) -> std::vector<std::byte> {
+    std::vector<std::byte> payload(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        payload[i] = std::byte(seed + i);
+    }
+    return payload;
+}
+
+} // namespace
+
+TEST_CASE("QueueJournal: record and replay") {
+    JournalDirectory directory;
+
+    BoundedSPMCRawQueue queue("test", BoundedSPMCRawQueue::CreationOptions(1 << 16), AnonymousMemorySource());
+    auto producer = queue.createProducer();
+    auto recorder = BoundedSPMCRawQueueRecorder(
+        queue.createConsumer(), QueueJournalWriter({.directory = directory.path, .name = "test"}));
+    REQUIRE(recorder);
+
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        REQUIRE(enqueue(producer, i));
+        if (i % 100 == 99) {
+            REQUIRE(recorder.poll() == 100);
+        }
+    }
+    REQUIRE(recorder.poll() == 0);
+    recorder.flush();
+
+    // Records keep order and capture timestamps
+    {
+        auto reader = QueueJournalReader(directory.path, "test");
+        std::int64_t timestamp = 0;
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            auto const record = reader.next();
+            REQUIRE(record);
+            REQUIRE(record->payload.size() == sizeof(std::uint64_t));
+            REQUIRE(*std::bit_cast<std::uint64_t const*>(record->payload.data()) == i);
+            REQUIRE(record->timestamp >= timestamp);
+            timestamp = record->timestamp;
+        }
+        REQUIRE(!reader.next());
+    }
+
+    // Replay into other queue as fast as possible
+    BoundedSPMCRawQueue replayQueue(
+        "replay", BoundedSPMCRawQueue::CreationOptions(1 << 16), AnonymousMemorySource());
+    auto consumer = replayQueue.createConsumer();
+    auto replayer =
+        BoundedSPMCRawQueueReplayer(replayQueue.createProducer(), QueueJournalReader(directory.path, "test"), 0.0);
+
+    std::uint64_t expected = 0;
+    while (!replayer.done()) {
+        REQUIRE(replayer.poll() > 0);
+        std::uint64_t value;
+        while (dequeue(consumer, value)) {
+            REQUIRE(value == expected++);
+        }
+    }
+    REQUIRE(expected == 1000);
+}
+
+TEST_CASE("QueueJournal: segments") {
+    JournalDirectory directory;
+
+    auto const options = QueueJournalOptions{
+        .directory = directory.path,
+        .name = "test",
+        .segmentSize = 4096,
+        .writeBufferSize = 256,
+    };
+
+    // Sizes fit write buffer, exceed it and exceed segment limit
+    std::vector<std::size_t> const sizes = {1, 8, 100, 200, 300, 1000, 5000, 7, 0, 4000, 64};
+    {
+        auto writer = QueueJournalWriter(options);
+        REQUIRE(writer.segmentIndex() == 0);
+        for (std::int64_t round = 0; round < 4; ++round) {
+            for (std::size_t i = 0; i < sizes.size(); ++i) {
+                auto const payload = makePayload(sizes[i], std::uint8_t(i));
+                writer.append(round * 100 + std::int64_t(i), payload);
+            }
+        }
+        REQUIRE(writer.segmentIndex() > 0);
+    }
+
+    auto const segments = detail::QueueJournalDetail::listSegments(directory.path, "test");
+    REQUIRE(segments.size() > 1);
+    for (auto const index : segments) {
+        auto const path = directory.path / detail::QueueJournalDetail::segmentFileName("test", index);
+        REQUIRE(std::filesystem::file_size(path) > 0);
+    }
+
+    auto reader = QueueJournalReader(directory.path, "test");
+    for (std::int64_t round = 0; round < 4; ++round) {
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            auto const record = reader.next();
+            REQUIRE(record);
+            REQUIRE(record->timestamp == round * 100 + std::int64_t(i));
+            auto const payload = makePayload(sizes[i], std::uint8_t(i));
+            REQUIRE(std::equal(record->payload.begin(), record->payload.end(), payload.begin(), payload.end()));
+        }
+    }
+    REQUIRE(!reader.next());
+
+    // Reopened journal is appended with new segments
+    {
+        auto writer = QueueJournalWriter(options);
+        REQUIRE(writer.segmentIndex() == segments.back() + 1);
+    }
+
+    // Synced writer
+    {
+        auto syncOptions = options;
+        syncOptions.sync = true;
+        auto writer = QueueJournalWriter(syncOptions);
+        auto const payload = makePayload(100, 1);
+        for (std::int64_t i = 0; i < 100; ++i) {
+            writer.append(i, payload);
+        }
+        writer.flush();
+        REQUIRE(writer.segmentIndex() > segments.back() + 2);
+    }
+}
+
+TEST_CASE("QueueJournal: replay pace") {
+    using namespace std::chrono_literals;
+
+    JournalDirectory directory;
+    {
+        auto writer = QueueJournalWriter({.directory = directory.path, .name = "test"});
+        for (std::uint64_t i = 0; i < 3; ++i) {
+            writer.append(std::int64_t(i) * 20000000, std::as_bytes(std::span(&i, 1)));
+        }
+    }
+
+    BoundedSPMCRawQueue queue("test", BoundedSPMCRawQueue::CreationOptions(1 << 16), AnonymousMemorySource());
+    auto consumer = queue.createConsumer();
+
+    // Recorded 40ms replayed twice faster
+    auto replayer =
+        BoundedSPMCRawQueueReplayer(queue.createProducer(), QueueJournalReader(directory.path, "test"), 2.0);
+    auto const startedAt = std::chrono::steady_clock::now();
+    REQUIRE(replayer.run() == 3);
+    auto const elapsed = std::chrono::steady_clock::now() - startedAt;
+    REQUIRE(elapsed >= 19ms);
+    REQUIRE(replayer.done());
+    REQUIRE(replayer.timestamp() == 40000000);
+
+    std::uint64_t value;
+    for (std::uint64_t i = 0; i < 3; ++i) {
+        REQUIRE(dequeue(consumer, value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(!dequeue(consumer, value));
+}
+
+TEST_CASE("QueueJournal: replay into full queue") {
+    JournalDirectory directory;
+    {
+        auto writer = QueueJournalWriter({.directory = directory.path, .name = "test"});
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            writer.append(0, std::as_bytes(std::span(&i, 1)));
+        }
+    }
+
+    // Slow consumer holds the producer back
+    using Queue = BoundedSPMCRawQueueWithBackpressure;
+    Queue queue("test", Queue::CreationOptions(4096), AnonymousMemorySource());
+    auto consumer = queue.createConsumer();
+    auto replayer = BoundedSPMCRawQueueReplayer<BoundedSPMCRawQueueBackpressureTraits>(
+        queue.createProducer(), QueueJournalReader(directory.path, "test"), 0.0);
+
+    auto const published = replayer.poll();
+    REQUIRE(published > 0);
+    REQUIRE(published < 1000);
+    REQUIRE(!replayer.done());
+    REQUIRE(replayer.poll() == 0);
+
+    std::uint64_t expected = 0;
+    std::uint64_t value;
+    while (!replayer.done()) {
+        replayer.poll();
+        while (dequeue(consumer, value)) {
+            REQUIRE(value == expected++);
+        }
+    }
+    while (dequeue(consumer, value)) {
+        REQUIRE(value == expected++);
+    }
+    REQUIRE(expected == 1000);
+}
+
+} // namespace rocket::testing
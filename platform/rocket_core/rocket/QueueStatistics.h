@@ -0,0 +1,133 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Platform.h"
+
+namespace rocket {
+
+/// Queue statistics snapshot
+struct QueueStatistics {
+    /// Messages committed
+    std::uint64_t messages = 0;
+    /// Payload bytes committed
+    std::uint64_t bytes = 0;
+    /// Failed prepare calls on queue is full
+    std::uint64_t fullEvents = 0;
+    /// Max queue occupancy (bytes) seen by producers when they refresh consumer position
+    std::uint64_t highWaterMark = 0;
+};
+
+/// Checks queue traits enable statistics (Traits::kStatistics is true)
+template <typename Traits>
+concept QueueStatisticsTraits = requires { requires Traits::kStatistics; };
+
+namespace detail {
+
+/// Default number of producer events between statistics publications
+constexpr std::size_t kDefaultQueueStatisticsInterval = 64;
+
+/// Number of producer events between statistics publications (Traits::kStatisticsInterval)
+template <typename Traits>
+[[nodiscard]] constexpr auto getQueueStatisticsInterval() noexcept -> std::size_t {
+    if constexpr (requires { Traits::kStatisticsInterval; }) {
+        return Traits::kStatisticsInterval;
+    } else {
+        return kDefaultQueueStatisticsInterval;
+    }
+}
+
+/// Statistics counters of queue memory header, placed into own cache line
+/// Updated by producers only, so consumer never shares cache line with them
+struct alignas(kHardwareDestructiveInterferenceSize) QueueStatisticsBlock {
+    std::uint64_t messages;
+    std::uint64_t bytes;
+    std::uint64_t fullEvents;
+    std::uint64_t highWaterMark;
+
+    static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+
+    /// Add counters and raise high-water mark
+    void publish(QueueStatistics const& delta) noexcept {
+        std::atomic_ref(messages).fetch_add(delta.messages, std::memory_order_relaxed);
+        std::atomic_ref(bytes).fetch_add(delta.bytes, std::memory_order_relaxed);
+        std::atomic_ref(fullEvents).fetch_add(delta.fullEvents, std::memory_order_relaxed);
+
+        auto current = std::atomic_ref(highWaterMark).load(std::memory_order_relaxed);
+        while (current < delta.highWaterMark &&
+               !std::atomic_ref(highWaterMark)
+                    .compare_exchange_weak(current, delta.highWaterMark, std::memory_order_relaxed)) {}
+    }
+
+    /// Read counters (each counter is consistent, snapshot as a whole is not)
+    [[nodiscard]] auto load() const noexcept -> QueueStatistics {
+        auto const read = [](std::uint64_t const& value) {
+            return std::atomic_ref(const_cast<std::uint64_t&>(value)).load(std::memory_order_relaxed);
+        };
+        return QueueStatistics{
+            .messages = read(messages),
+            .bytes = read(bytes),
+            .fullEvents = read(fullEvents),
+            .highWaterMark = read(highWaterMark),
+        };
+    }
+};
+
+/// Statistics placeholder of queue memory header on statistics disabled
+struct QueueStatisticsNone {};
+
+/// Statistics member type of queue memory header
+template <bool Enabled>
+using QueueStatisticsStorage = std::conditional_t<Enabled, QueueStatisticsBlock, QueueStatisticsNone>;
+
+/// Producer local statistics, published into queue memory header each Interval events
+template <bool Enabled, std::size_t Interval>
+class QueueStatisticsCounter {};
+
+template <std::size_t Interval>
+class QueueStatisticsCounter<true, Interval> {
+  private:
+    QueueStatistics pending_;
+    std::size_t events_ = 0;
+
+  public:
+    /// Count committed message
+    ROCKET_FORCE_INLINE void onCommit(QueueStatisticsBlock& block, std::size_t bytes) noexcept {
+        ++pending_.messages;
+        pending_.bytes += bytes;
+        if (++events_ >= Interval) [[unlikely]] {
+            publish(block);
+        }
+    }
+
+    /// Count failed prepare
+    ROCKET_FORCE_INLINE void onFull(QueueStatisticsBlock& block) noexcept {
+        ++pending_.fullEvents;
+        if (++events_ >= Interval) [[unlikely]] {
+            publish(block);
+        }
+    }
+
+    /// Track occupancy seen by producer
+    ROCKET_FORCE_INLINE void onOccupancy(std::size_t bytes) noexcept {
+        pending_.highWaterMark = std::max<std::uint64_t>(pending_.highWaterMark, bytes);
+    }
+
+    /// Publish pending counters
+    void publish(QueueStatisticsBlock& block) noexcept {
+        block.publish(pending_);
+        // High-water mark is kept to skip publishing it until exceeded
+        pending_ = QueueStatistics{.highWaterMark = pending_.highWaterMark};
+        events_ = 0;
+    }
+};
+
+} // namespace detail
+} // namespace rocket
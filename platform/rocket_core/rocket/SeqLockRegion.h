@@ -0,0 +1,378 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "File.h"
+#include "MappedRegion.h"
+#include "MemorySource.h"
+#include "Platform.h"
+#include "detail/math.h"
+#include "detail/memory.h"
+
+namespace rocket {
+namespace detail {
+
+/// Seqlock region detail
+/// Value of version V is written to slot (V - 1) % HistorySize, slot sequence is 2V - 1 while the value is being
+/// written and 2V on it's complete. Readers copy the slot and retry on sequence changed (torn read).
+template <typename T, std::size_t HistorySize>
+    requires std::is_trivially_copyable_v<T> && (HistorySize > 0)
+struct SeqLockRegionDetail {
+    /// Region tag
+    static constexpr std::string_view kTag = "rocket/seqlock";
+    /// Max attempts of reading the latest value
+    static constexpr std::size_t kMaxLoadAttempts = 64;
+
+    /// Control struct for region
+    struct MemoryHeader {
+        /// Placeholder for region tag
+        char tag[kTag.size()];
+        /// Size of value
+        std::uint64_t valueSize;
+        /// Slots count
+        std::uint64_t historySize;
+        /// Latest published version, zero on nothing published, own cache line
+        alignas(kHardwareDestructiveInterferenceSize) std::uint64_t version;
+
+        static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+    };
+
+    /// Value slot
+    struct alignas(kHardwareDestructiveInterferenceSize) Slot {
+        /// Sequence of the slot
+        std::uint64_t sequence;
+        /// Value
+        T value;
+    };
+
+    /// Offset for the first slot from region start
+    static constexpr std::size_t kDataStartPos = align_up(sizeof(MemoryHeader), kHardwareDestructiveInterferenceSize);
+
+    /// Region size
+    static constexpr std::size_t kSize = kDataStartPos + sizeof(Slot) * HistorySize;
+
+    /// Check buffer points to valid region
+    [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
+        if (buffer.size() < kSize) {
+            return false;
+        }
+        auto const header = std::bit_cast<MemoryHeader const*>(buffer.data());
+        return std::equal(kTag.begin(), kTag.end(), header->tag) && header->valueSize == sizeof(T) &&
+               header->historySize == HistorySize;
+    }
+
+    /// Init region
+    static void init(std::span<std::byte> buffer) noexcept {
+        auto const header = std::bit_cast<MemoryHeader*>(buffer.data());
+        std::copy(kTag.begin(), kTag.end(), header->tag);
+        header->valueSize = sizeof(T);
+        header->historySize = HistorySize;
+        std::atomic_ref(header->version).store(0, std::memory_order_release);
+    }
+
+    /// Slot of version
+    [[nodiscard]] static ROCKET_FORCE_INLINE auto slot(std::byte* base, std::uint64_t version) noexcept -> Slot* {
+        return std::bit_cast<Slot*>(base + kDataStartPos) + (version - 1) % HistorySize;
+    }
+};
+
+/// Single writer of seqlock region
+template <typename T, std::size_t HistorySize>
+class SeqLockRegionWriter {
+  private:
+    using Detail = SeqLockRegionDetail<T, HistorySize>;
+    using MemoryHeader = typename Detail::MemoryHeader;
+
+    std::shared_ptr<MappedRegion> storage_;
+    std::byte* base_ = nullptr;
+    MemoryHeader* header_ = nullptr;
+    std::uint64_t version_ = 0;
+
+  public:
+    SeqLockRegionWriter() = default;
+
+    SeqLockRegionWriter(SeqLockRegionWriter&& that) noexcept {
+        swap(that);
+    }
+
+    SeqLockRegionWriter& operator=(SeqLockRegionWriter&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Construct writer continuing versions of the region
+    explicit SeqLockRegionWriter(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("invalid seqlock region");
+        }
+        base_ = storage_->data();
+        header_ = std::bit_cast<MemoryHeader*>(base_);
+        version_ = std::atomic_ref(header_->version).load(std::memory_order_acquire);
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Latest published version
+    [[nodiscard]] ROCKET_FORCE_INLINE auto version() const noexcept -> std::uint64_t {
+        return version_;
+    }
+
+    /// Publish value, return it's version
+    ROCKET_FORCE_INLINE auto store(T const& value) noexcept -> std::uint64_t {
+        auto const version = version_ + 1;
+        auto const slot = Detail::slot(base_, version);
+        std::atomic_ref sequence(slot->sequence);
+        sequence.store(2 * version - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot->value, &value, sizeof(T));
+        sequence.store(2 * version, std::memory_order_release);
+        std::atomic_ref(header_->version).store(version, std::memory_order_release);
+        version_ = version;
+        return version;
+    }
+
+    /// Swap resources with other writer
+    void swap(SeqLockRegionWriter& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(base_, that.base_);
+        swap(header_, that.header_);
+        swap(version_, that.version_);
+    }
+
+    /// \see SeqLockRegionWriter::swap
+    friend void swap(SeqLockRegionWriter& a, SeqLockRegionWriter& b) noexcept {
+        a.swap(b);
+    }
+};
+
+/// Reader of seqlock region, any number of readers is allowed
+template <typename T, std::size_t HistorySize>
+class SeqLockRegionReader {
+  private:
+    using Detail = SeqLockRegionDetail<T, HistorySize>;
+    using MemoryHeader = typename Detail::MemoryHeader;
+
+    std::shared_ptr<MappedRegion> storage_;
+    std::byte* base_ = nullptr;
+    MemoryHeader* header_ = nullptr;
+
+  public:
+    SeqLockRegionReader() = default;
+
+    SeqLockRegionReader(SeqLockRegionReader&& that) noexcept {
+        swap(that);
+    }
+
+    SeqLockRegionReader& operator=(SeqLockRegionReader&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    explicit SeqLockRegionReader(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("invalid seqlock region");
+        }
+        base_ = storage_->data();
+        header_ = std::bit_cast<MemoryHeader*>(base_);
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Latest published version, zero on nothing published
+    [[nodiscard]] ROCKET_FORCE_INLINE auto version() const noexcept -> std::uint64_t {
+        return std::atomic_ref(header_->version).load(std::memory_order_acquire);
+    }
+
+    /// Read latest value, retry on value is being overwritten
+    /// Retries are bounded: writer died in the middle of store() leaves the slot of the next version odd forever, with
+    /// HistorySize = 1 it's the slot of the latest version too
+    /// \return version of value read, zero on nothing published or value was being overwritten for all
+    /// kMaxLoadAttempts attempts
+    [[nodiscard]] ROCKET_FORCE_INLINE auto load(T& value) const noexcept -> std::uint64_t {
+        for (std::size_t attempt = 0; attempt < Detail::kMaxLoadAttempts; ++attempt) {
+            auto const version = this->version();
+            if (version == 0 || load(version, value)) [[likely]] {
+                return version;
+            }
+        }
+        return 0;
+    }
+
+    /// Read value of version from history
+    /// \return false on version isn't published yet or overwritten by newer versions
+    [[nodiscard]] ROCKET_FORCE_INLINE auto load(std::uint64_t version, T& value) const noexcept -> bool {
+        auto const slot = Detail::slot(base_, version);
+        std::atomic_ref sequence(slot->sequence);
+        auto const expected = 2 * version;
+        if (sequence.load(std::memory_order_acquire) != expected) {
+            return false;
+        }
+        std::memcpy(&value, &slot->value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == expected;
+    }
+
+    /// Swap resources with other reader
+    void swap(SeqLockRegionReader& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(base_, that.base_);
+        swap(header_, that.header_);
+    }
+
+    /// \see SeqLockRegionReader::swap
+    friend void swap(SeqLockRegionReader& a, SeqLockRegionReader& b) noexcept {
+        a.swap(b);
+    }
+};
+
+} // namespace detail
+
+/// Shared memory "latest value" publisher (seqlock)
+/// One writer publishes trivially copyable values, readers never block the writer and retry on torn reads. The last
+/// HistorySize versions are kept and could be read back by version.
+///
+/// Region layout:
+/// +--------------+--------+--------+-----
+/// | MemoryHeader | slot 0 | slot 1 | ...
+/// +--------------+--------+--------+-----
+template <typename T, std::size_t HistorySize = 1>
+class SeqLockRegion {
+  private:
+    using Detail = detail::SeqLockRegionDetail<T, HistorySize>;
+
+    File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
+
+  public:
+    using Writer = detail::SeqLockRegionWriter<T, HistorySize>;
+    using Reader = detail::SeqLockRegionReader<T, HistorySize>;
+
+    SeqLockRegion(SeqLockRegion const&) = delete;
+    SeqLockRegion& operator=(SeqLockRegion const&) = delete;
+    SeqLockRegion() = default;
+
+    SeqLockRegion(SeqLockRegion&& that) noexcept {
+        swap(that);
+    }
+
+    SeqLockRegion& operator=(SeqLockRegion&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Open only region. Throws on error.
+    explicit SeqLockRegion(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("failed to open seqlock region (invalid)");
+        }
+    }
+
+    /// Open or create region. Throws on error.
+    SeqLockRegion(std::string_view name, OpenOrCreate, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        std::size_t const size = detail::align_up(Detail::kSize, pageSize);
+
+        // init region or check region's layout is the same as requested
+        if (auto const fileSize = file_.getFileSize(); fileSize != 0) {
+            if (fileSize != size) {
+                throw std::runtime_error("size mismatch");
+            }
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!Detail::check(storage_->content())) {
+                throw std::runtime_error("failed to open seqlock region (invalid)");
+            }
+        } else {
+            file_.truncate(size);
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            Detail::init(storage_->content());
+        }
+    }
+
+    /// Return true on region initialized.
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return static_cast<bool>(file_);
+    }
+
+    /// Result of applying mapping options to the region mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
+    /// Create writer for the region. Throws on error.
+    [[nodiscard]] auto createWriter() -> Writer {
+        if (!operator bool()) {
+            throw std::runtime_error("seqlock region not initialized");
+        }
+        if (!file_.tryLock()) {
+            throw std::runtime_error("can't create writer (already exists?)");
+        }
+        return Writer(storage_);
+    }
+
+    /// Create reader for the region. Throws on error.
+    [[nodiscard]] auto createReader() const -> Reader {
+        if (!operator bool()) {
+            throw std::runtime_error("seqlock region not initialized");
+        }
+        return Reader(storage_);
+    }
+
+    /// Swap resources with other region.
+    void swap(SeqLockRegion& that) noexcept {
+        using std::swap;
+        swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
+    }
+
+    /// \see SeqLockRegion::swap
+    friend void swap(SeqLockRegion& a, SeqLockRegion& b) noexcept {
+        a.swap(b);
+    }
+};
+
+} // namespace rocket
@@ -0,0 +1,62 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "SeqLockRegion.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Top-of-book sized value (two cache lines with sequence)
+struct Quote {
+    std::uint64_t values[12];
+};
+
+} // namespace
+
+/// Reader latency of the latest value, the first argument is writer updates per second (zero on no writer)
+/// Writer spins on steady clock to keep the requested rate
+static void BM_SeqLockRegion_Load(::benchmark::State& state) {
+    auto const rate = state.range(0);
+
+    SeqLockRegion<Quote> region("bm-seqlock", kOpenOrCreate, AnonymousMemorySource());
+    auto reader = region.createReader();
+
+    std::atomic<bool> stop{false};
+    std::jthread writerThread;
+    if (rate > 0) {
+        writerThread = std::jthread([&, writer = region.createWriter()]() mutable {
+            auto const period = std::chrono::nanoseconds(1000000000 / rate);
+            auto deadline = std::chrono::steady_clock::now();
+            Quote quote{};
+            while (!stop.load(std::memory_order_relaxed)) {
+                while (std::chrono::steady_clock::now() < deadline) {}
+                deadline += period;
+                ++quote.values[0];
+                writer.store(quote);
+            }
+        });
+    } else {
+        region.createWriter().store(Quote{});
+    }
+
+    Quote quote;
+    for (auto _ : state) {
+        auto const version = reader.load(quote);
+        benchmark::DoNotOptimize(version);
+        benchmark::DoNotOptimize(quote);
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SeqLockRegion_Load)->Arg(0)->Arg(1000000)->Arg(10000000)->UseRealTime();
+
+} // namespace rocket::testing
@@ -0,0 +1,192 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include <doctest/doctest.h>
+
+#include "SeqLockRegion.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Value with all fields equal, torn read mixes fields of different versions
+struct TopOfBook {
+    std::uint64_t bidPrice;
+    std::uint64_t bidSize;
+    std::uint64_t askPrice;
+    std::uint64_t askSize;
+    std::uint64_t padding[12];
+
+    [[nodiscard]] static auto make(std::uint64_t value) noexcept -> TopOfBook {
+        TopOfBook result;
+        result.bidPrice = result.bidSize = result.askPrice = result.askSize = value;
+        for (auto& entry : result.padding) {
+            entry = value;
+        }
+        return result;
+    }
+
+    [[nodiscard]] auto consistent() const noexcept -> bool {
+        for (auto const entry : padding) {
+            if (entry != bidPrice) {
+                return false;
+            }
+        }
+        return bidSize == bidPrice && askPrice == bidPrice && askSize == bidPrice;
+    }
+};
+
+} // namespace
+
+TEST_CASE("SeqLockRegion: basic") {
+    SeqLockRegion<TopOfBook> region("test", kOpenOrCreate, AnonymousMemorySource());
+    REQUIRE(region);
+
+    auto writer = region.createWriter();
+    auto reader = region.createReader();
+
+    TopOfBook value;
+    REQUIRE(reader.version() == 0);
+    REQUIRE(reader.load(value) == 0);
+
+    REQUIRE(writer.store(TopOfBook::make(10)) == 1);
+    REQUIRE(reader.load(value) == 1);
+    REQUIRE(value.bidPrice == 10);
+    REQUIRE(value.consistent());
+
+    REQUIRE(writer.store(TopOfBook::make(20)) == 2);
+    REQUIRE(reader.load(value) == 2);
+    REQUIRE(value.bidPrice == 20);
+
+    // Single slot keeps the latest version only
+    REQUIRE(!reader.load(1, value));
+    REQUIRE(reader.load(2, value));
+    REQUIRE(!reader.load(3, value));
+}
+
+TEST_CASE("SeqLockRegion: history") {
+    SeqLockRegion<TopOfBook, 4> region("test", kOpenOrCreate, AnonymousMemorySource());
+    auto writer = region.createWriter();
+    auto reader = region.createReader();
+
+    for (std::uint64_t i = 1; i <= 10; ++i) {
+        REQUIRE(writer.store(TopOfBook::make(i * 100)) == i);
+    }
+
+    TopOfBook value;
+    REQUIRE(reader.load(value) == 10);
+    for (std::uint64_t version = 1; version <= 6; ++version) {
+        REQUIRE(!reader.load(version, value));
+    }
+    for (std::uint64_t version = 7; version <= 10; ++version) {
+        REQUIRE(reader.load(version, value));
+        REQUIRE(value.bidPrice == version * 100);
+    }
+}
+
+TEST_CASE("SeqLockRegion: reopen") {
+    auto const name = "test-seqlock-" + std::to_string(::getpid());
+    auto memorySource = DefaultMemorySource();
+    {
+        SeqLockRegion<TopOfBook> region(name, kOpenOrCreate, memorySource);
+        auto writer = region.createWriter();
+        REQUIRE(writer.store(TopOfBook::make(1)) == 1);
+        REQUIRE(writer.store(TopOfBook::make(2)) == 2);
+    }
+    {
+        SeqLockRegion<TopOfBook> region(name, memorySource);
+        TopOfBook value;
+        REQUIRE(region.createReader().load(value) == 2);
+        REQUIRE(value.bidPrice == 2);
+
+        // Writer continues versions
+        auto writer = region.createWriter();
+        REQUIRE(writer.store(TopOfBook::make(3)) == 3);
+    }
+
+    // Layout mismatch
+    REQUIRE_THROWS(SeqLockRegion<TopOfBook, 2>(name, memorySource));
+    REQUIRE_THROWS(SeqLockRegion<std::uint64_t>(name, memorySource));
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("SeqLockRegion: writer died in the middle of store") {
+    using Region = SeqLockRegion<TopOfBook>;
+
+    auto const name = "test-seqlock-" + std::to_string(::getpid());
+    auto memorySource = DefaultMemorySource();
+    {
+        Region region(name, kOpenOrCreate, memorySource);
+        REQUIRE(region.createWriter().store(TopOfBook::make(1)) == 1);
+    }
+
+    // Version 2 is being written to the only slot, header still points to version 1
+    {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        REQUIRE(result);
+        auto const storage = detail::mapShared(std::get<0>(result.value()));
+        detail::SeqLockRegionDetail<TopOfBook, 1>::slot(storage->data(), 2)->sequence = 3;
+    }
+
+    Region region(name, memorySource);
+    auto reader = region.createReader();
+    TopOfBook value;
+    REQUIRE(reader.version() == 1);
+    REQUIRE(reader.load(value) == 0);
+    REQUIRE(!reader.load(1, value));
+
+    // Next writer overwrites the slot
+    auto writer = region.createWriter();
+    REQUIRE(writer.store(TopOfBook::make(2)) == 2);
+    REQUIRE(reader.load(value) == 2);
+    REQUIRE(value.consistent());
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("SeqLockRegion: torn reads") {
+    SeqLockRegion<TopOfBook, 2> region("test", kOpenOrCreate, AnonymousMemorySource());
+
+    constexpr std::uint64_t kUpdates = 200000;
+    std::atomic<bool> done{false};
+
+    std::jthread writerThread([&, writer = region.createWriter()]() mutable {
+        for (std::uint64_t i = 1; i <= kUpdates; ++i) {
+            writer.store(TopOfBook::make(i));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    auto reader = region.createReader();
+    std::uint64_t last = 0;
+    bool consistent = true;
+    bool monotonic = true;
+    while (!done.load(std::memory_order_acquire)) {
+        TopOfBook value;
+        auto const version = reader.load(value);
+        if (version == 0) {
+            continue;
+        }
+        consistent = consistent && value.consistent() && value.bidPrice == version;
+        monotonic = monotonic && version >= last;
+        last = version;
+    }
+    writerThread.join();
+
+    REQUIRE(consistent);
+    REQUIRE(monotonic);
+
+    TopOfBook value;
+    REQUIRE(reader.load(value) == kUpdates);
+    REQUIRE(value.bidPrice == kUpdates);
+}
+
+} // namespace rocket::testing
@@ -0,0 +1,573 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "MappedRegion.h"
+#include "MemorySource.h"
+#include "Platform.h"
+#include "detail/math.h"
+#include "detail/memory.h"
+
+namespace rocket {
+namespace detail {
+
+/// Shared hash map detail
+///
+/// Bucket is a cache line aligned group of kBucketSlots entries with one byte tag per entry and seqlock sequence:
+/// tag is 0 on free slot and 0x80 | 7 high bits of hash on occupied. Key is placed to the first bucket of probe
+/// sequence (linear over buckets) with free slot, each full bucket passed counts the key in it's overflow. Lookup
+/// compares all 8 tags of a bucket at once and stops at the first bucket without overflow, erase decrements overflow
+/// of the buckets passed and frees the slot, so erased slots never leave tombstones degrading lookup of absent keys.
+template <typename Key, typename Value>
+    requires std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value> && std::equality_comparable<Key>
+struct SharedHashMapDetail {
+    /// Region tag
+    static constexpr std::string_view kTag = "rocket/hashmap";
+    /// Slots per bucket, tags of a bucket fit one word
+    static constexpr std::size_t kBucketSlots = 8;
+    /// Max attempts to read a bucket consistent
+    static constexpr std::size_t kMaxReadAttempts = 64;
+
+    static constexpr std::uint8_t kEmpty = 0;
+
+    static constexpr std::uint64_t kLowBits = 0x0101010101010101;
+    static constexpr std::uint64_t kHighBits = 0x8080808080808080;
+
+    static_assert(std::endian::native == std::endian::little);
+
+    /// Control struct for region
+    struct MemoryHeader {
+        /// Placeholder for region tag
+        char tag[kTag.size()];
+        /// Size of key
+        std::uint64_t keySize;
+        /// Size of value
+        std::uint64_t valueSize;
+        /// Buckets count (power of 2)
+        std::uint64_t bucketsCount;
+        /// Entries count, own cache line
+        alignas(kHardwareDestructiveInterferenceSize) std::uint64_t size;
+    };
+
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+    /// Bucket of entries
+    struct alignas(kHardwareDestructiveInterferenceSize) Bucket {
+        /// Sequence, odd while the bucket is being modified
+        std::uint64_t sequence;
+        /// Tags of slots
+        std::uint8_t tags[kBucketSlots];
+        /// Keys placed further in probe sequence on the bucket was full
+        std::uint64_t overflow;
+        /// Entries
+        Entry entries[kBucketSlots];
+
+        static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+    };
+
+    /// Offset for the first bucket from region start
+    static constexpr std::size_t kDataStartPos = align_up(sizeof(MemoryHeader), kHardwareDestructiveInterferenceSize);
+
+    /// Buckets count to keep capacity entries with load factor below 7/8
+    [[nodiscard]] static constexpr auto bucketsCount(std::size_t capacity) noexcept -> std::size_t {
+        auto const slots = capacity + capacity / 7;
+        return upper_pow_2(std::max<std::size_t>((slots + kBucketSlots - 1) / kBucketSlots, 1));
+    }
+
+    /// Region size
+    [[nodiscard]] static constexpr auto regionSize(std::size_t bucketsCount) noexcept -> std::size_t {
+        return kDataStartPos + sizeof(Bucket) * bucketsCount;
+    }
+
+    /// Check buffer points to valid region
+    [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
+        if (buffer.size() < kDataStartPos) {
+            return false;
+        }
+        auto const header = std::bit_cast<MemoryHeader const*>(buffer.data());
+        return std::equal(kTag.begin(), kTag.end(), header->tag) && header->keySize == sizeof(Key) &&
+               header->valueSize == sizeof(Value) && std::has_single_bit(header->bucketsCount) &&
+               regionSize(header->bucketsCount) <= buffer.size();
+    }
+
+    /// Init region
+    static void init(std::span<std::byte> buffer, std::size_t bucketsCount) noexcept {
+        auto const header = std::bit_cast<MemoryHeader*>(buffer.data());
+        std::copy(kTag.begin(), kTag.end(), header->tag);
+        header->keySize = sizeof(Key);
+        header->valueSize = sizeof(Value);
+        header->bucketsCount = bucketsCount;
+        header->size = 0;
+        // Buckets are zero filled by truncate: sequence 0, all slots free and no overflow
+    }
+
+    /// Mix hash, user hash might be identity (std::hash of integers)
+    [[nodiscard]] static ROCKET_FORCE_INLINE constexpr auto mix(std::uint64_t hash) noexcept -> std::uint64_t {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    /// Tag of occupied slot
+    [[nodiscard]] static ROCKET_FORCE_INLINE constexpr auto tagOf(std::uint64_t hash) noexcept -> std::uint8_t {
+        return std::uint8_t(0x80 | (hash >> 57));
+    }
+
+    /// Tags of bucket as one word
+    [[nodiscard]] static ROCKET_FORCE_INLINE auto tags(Bucket const* bucket) noexcept -> std::uint64_t {
+        std::uint64_t result;
+        std::memcpy(&result, bucket->tags, sizeof(result));
+        return result;
+    }
+
+    /// Mask with high bit set for each byte of tags equal to tag (SWAR compare)
+    /// False positives are possible above a true match only, keys are compared anyway
+    [[nodiscard]] static ROCKET_FORCE_INLINE constexpr auto match(std::uint64_t tags, std::uint8_t tag) noexcept
+        -> std::uint64_t {
+        auto const x = tags ^ (kLowBits * tag);
+        return (x - kLowBits) & ~x & kHighBits;
+    }
+
+    /// Slot index of the lowest match bit
+    [[nodiscard]] static ROCKET_FORCE_INLINE constexpr auto slotOf(std::uint64_t mask) noexcept -> std::size_t {
+        return std::size_t(std::countr_zero(mask)) / 8;
+    }
+};
+
+/// Single writer of shared hash map
+template <typename Key, typename Value, typename Hash>
+class SharedHashMapWriter {
+  private:
+    using Detail = SharedHashMapDetail<Key, Value>;
+    using MemoryHeader = typename Detail::MemoryHeader;
+    using Bucket = typename Detail::Bucket;
+
+    std::shared_ptr<MappedRegion> storage_;
+    MemoryHeader* header_ = nullptr;
+    Bucket* buckets_ = nullptr;
+    std::uint64_t mask_ = 0;
+    [[no_unique_address]] Hash hash_;
+
+  public:
+    SharedHashMapWriter() = default;
+
+    SharedHashMapWriter(SharedHashMapWriter&& that) noexcept {
+        swap(that);
+    }
+
+    SharedHashMapWriter& operator=(SharedHashMapWriter&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    explicit SharedHashMapWriter(std::shared_ptr<MappedRegion> storage, Hash hash = Hash())
+        : storage_(std::move(storage)), hash_(std::move(hash)) {
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("invalid hash map");
+        }
+        header_ = std::bit_cast<MemoryHeader*>(storage_->data());
+        buckets_ = std::bit_cast<Bucket*>(storage_->data() + Detail::kDataStartPos);
+        mask_ = header_->bucketsCount - 1;
+
+        // Finish modifications left by the writer died in the middle of them, bucket content is kept as is
+        for (std::uint64_t index = 0; index <= mask_; ++index) {
+            std::atomic_ref sequence(buckets_[index].sequence);
+            if (auto const value = sequence.load(std::memory_order_relaxed); value & 1) {
+                sequence.store(value + 1, std::memory_order_release);
+            }
+        }
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Entries count
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return header_->size;
+    }
+
+    /// Find value of key
+    [[nodiscard]] auto find(Key const& key) const noexcept -> Value const* {
+        auto const [bucket, slot] = lookup(key);
+        return bucket ? &bucket->entries[slot].value : nullptr;
+    }
+
+    /// Insert entry or assign value of existing one
+    /// \return false on no free slot for key
+    auto insertOrAssign(Key const& key, Value const& value) noexcept -> bool {
+        if (auto const [bucket, slot] = lookup(key); bucket) {
+            modify(bucket, [&] { bucket->entries[slot].value = value; });
+            return true;
+        }
+
+        auto const hash = Detail::mix(hash_(key));
+        auto const home = hash & mask_;
+        auto index = home;
+        std::uint64_t free = 0;
+        for (std::uint64_t probe = 0; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+            if ((free = Detail::match(Detail::tags(&buckets_[index]), Detail::kEmpty)) != 0) {
+                break;
+            }
+        }
+        if (free == 0) {
+            return false;
+        }
+
+        // Overflow is counted before the entry is visible, so readers never stop short of it
+        for (auto passed = home; passed != index; passed = (passed + 1) & mask_) {
+            auto const bucket = &buckets_[passed];
+            modify(bucket, [&] { bucket->overflow++; });
+        }
+        auto const bucket = &buckets_[index];
+        auto const slot = Detail::slotOf(free);
+        modify(bucket, [&] {
+            bucket->entries[slot] = {.key = key, .value = value};
+            bucket->tags[slot] = Detail::tagOf(hash);
+        });
+        std::atomic_ref(header_->size).store(header_->size + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Erase entry
+    /// \return false on key not found
+    auto erase(Key const& key) noexcept -> bool {
+        auto const [bucket, slot] = lookup(key);
+        if (!bucket) {
+            return false;
+        }
+        modify(bucket, [&] { bucket->tags[slot] = Detail::kEmpty; });
+        for (auto index = Detail::mix(hash_(key)) & mask_; &buckets_[index] != bucket; index = (index + 1) & mask_) {
+            auto const passed = &buckets_[index];
+            modify(passed, [&] { passed->overflow--; });
+        }
+        std::atomic_ref(header_->size).store(header_->size - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Swap resources with other writer
+    void swap(SharedHashMapWriter& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(header_, that.header_);
+        swap(buckets_, that.buckets_);
+        swap(mask_, that.mask_);
+        swap(hash_, that.hash_);
+    }
+
+    /// \see SharedHashMapWriter::swap
+    friend void swap(SharedHashMapWriter& a, SharedHashMapWriter& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    /// Bucket and slot of key, bucket is nullptr on key not found
+    [[nodiscard]] auto lookup(Key const& key) const noexcept -> std::tuple<Bucket*, std::size_t> {
+        auto const hash = Detail::mix(hash_(key));
+        auto const tag = Detail::tagOf(hash);
+
+        auto index = hash & mask_;
+        for (std::uint64_t probe = 0; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+            auto const bucket = &buckets_[index];
+            auto const tags = Detail::tags(bucket);
+            for (auto found = Detail::match(tags, tag); found != 0; found &= found - 1) {
+                auto const slot = Detail::slotOf(found);
+                if (bucket->tags[slot] == tag && bucket->entries[slot].key == key) {
+                    return {bucket, slot};
+                }
+            }
+            if (bucket->overflow == 0) {
+                break;
+            }
+        }
+        return {nullptr, 0};
+    }
+
+    /// Modify bucket under seqlock
+    /// Sequence parity is forced, so a modification left unfinished by the previous writer doesn't invert it
+    template <typename Fn>
+    ROCKET_FORCE_INLINE static void modify(Bucket* bucket, Fn&& fn) noexcept {
+        std::atomic_ref sequence(bucket->sequence);
+        auto const value = sequence.load(std::memory_order_relaxed) | 1;
+        sequence.store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fn();
+        sequence.store(value + 1, std::memory_order_release);
+    }
+};
+
+/// Lock-free reader of shared hash map, any number of readers is allowed
+template <typename Key, typename Value, typename Hash>
+class SharedHashMapReader {
+  private:
+    using Detail = SharedHashMapDetail<Key, Value>;
+    using MemoryHeader = typename Detail::MemoryHeader;
+    using Bucket = typename Detail::Bucket;
+
+    std::shared_ptr<MappedRegion> storage_;
+    MemoryHeader* header_ = nullptr;
+    Bucket* buckets_ = nullptr;
+    std::uint64_t mask_ = 0;
+    [[no_unique_address]] Hash hash_;
+
+  public:
+    SharedHashMapReader() = default;
+
+    SharedHashMapReader(SharedHashMapReader&& that) noexcept {
+        swap(that);
+    }
+
+    SharedHashMapReader& operator=(SharedHashMapReader&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    explicit SharedHashMapReader(std::shared_ptr<MappedRegion> storage, Hash hash = Hash())
+        : storage_(std::move(storage)), hash_(std::move(hash)) {
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("invalid hash map");
+        }
+        header_ = std::bit_cast<MemoryHeader*>(storage_->data());
+        buckets_ = std::bit_cast<Bucket*>(storage_->data() + Detail::kDataStartPos);
+        mask_ = header_->bucketsCount - 1;
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Entries count
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return std::atomic_ref(header_->size).load(std::memory_order_relaxed);
+    }
+
+    /// Copy value of key, bucket is re-read on it's modified concurrently
+    /// \return false on key not found or bucket was being modified for all kMaxReadAttempts attempts (e.g. writer died
+    /// in the middle of modification, until the next writer is created)
+    [[nodiscard]] ROCKET_FORCE_INLINE auto find(Key const& key, Value& value) const noexcept -> bool {
+        auto const hash = Detail::mix(hash_(key));
+        auto const tag = Detail::tagOf(hash);
+
+        auto index = hash & mask_;
+        for (std::uint64_t probe = 0; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+            auto const bucket = &buckets_[index];
+            std::atomic_ref sequence(bucket->sequence);
+            std::size_t attempt = 0;
+            while (true) {
+                if (++attempt > Detail::kMaxReadAttempts) [[unlikely]] {
+                    return false;
+                }
+                auto const before = sequence.load(std::memory_order_acquire);
+                if (before & 1) [[unlikely]] {
+                    continue;
+                }
+
+                auto const tags = Detail::tags(bucket);
+                bool found = false;
+                for (auto candidates = Detail::match(tags, tag); candidates != 0; candidates &= candidates - 1) {
+                    auto const slot = Detail::slotOf(candidates);
+                    alignas(Key) std::byte candidate[sizeof(Key)];
+                    std::memcpy(candidate, &bucket->entries[slot].key, sizeof(Key));
+                    if (std::uint8_t(tags >> (slot * 8)) == tag && *std::bit_cast<Key const*>(&candidate[0]) == key) {
+                        std::memcpy(&value, &bucket->entries[slot].value, sizeof(Value));
+                        found = true;
+                        break;
+                    }
+                }
+                auto const overflow = bucket->overflow;
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) != before) [[unlikely]] {
+                    continue;
+                }
+                if (found) {
+                    return true;
+                }
+                if (overflow == 0) {
+                    return false;
+                }
+                break;
+            }
+        }
+        return false;
+    }
+
+    /// Swap resources with other reader
+    void swap(SharedHashMapReader& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(header_, that.header_);
+        swap(buckets_, that.buckets_);
+        swap(mask_, that.mask_);
+        swap(hash_, that.hash_);
+    }
+
+    /// \see SharedHashMapReader::swap
+    friend void swap(SharedHashMapReader& a, SharedHashMapReader& b) noexcept {
+        a.swap(b);
+    }
+};
+
+} // namespace detail
+
+/// Fixed capacity open addressing hash map in shared memory
+/// One writer inserts, assigns and erases entries; readers look up entries lock-free with per bucket seqlock. Keys and
+/// values are trivially copyable, Hash must give the same result in all processes sharing the map.
+///
+/// Region layout:
+/// +--------------+----------+----------+-----
+/// | MemoryHeader | bucket 0 | bucket 1 | ...
+/// +--------------+----------+----------+-----
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SharedHashMap {
+  private:
+    using Detail = detail::SharedHashMapDetail<Key, Value>;
+
+    File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
+
+  public:
+    using Writer = detail::SharedHashMapWriter<Key, Value, Hash>;
+    using Reader = detail::SharedHashMapReader<Key, Value, Hash>;
+
+    struct CreationOptions {
+        /// Entries count map keeps without exceeding load factor (7/8)
+        std::size_t capacity;
+    };
+
+    SharedHashMap(SharedHashMap const&) = delete;
+    SharedHashMap& operator=(SharedHashMap const&) = delete;
+    SharedHashMap() = default;
+
+    SharedHashMap(SharedHashMap&& that) noexcept {
+        swap(that);
+    }
+
+    SharedHashMap& operator=(SharedHashMap&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Open only map. Throws on error.
+    explicit SharedHashMap(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("failed to open hash map (invalid)");
+        }
+    }
+
+    /// Open or create map. Throws on error.
+    SharedHashMap(std::string_view name, CreationOptions const& options,
+        MemorySource const& memorySource = DefaultMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        if (options.capacity == 0) {
+            throw std::runtime_error("invalid argument (capacity)");
+        }
+
+        auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        auto const bucketsCount = Detail::bucketsCount(options.capacity);
+        std::size_t const size = detail::align_up(Detail::regionSize(bucketsCount), pageSize);
+
+        // init map or check map's options is the same as requested
+        if (auto const fileSize = file_.getFileSize(); fileSize != 0) {
+            if (fileSize != size) {
+                throw std::runtime_error("size mismatch");
+            }
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!Detail::check(storage_->content())) {
+                throw std::runtime_error("failed to open hash map (invalid)");
+            }
+        } else {
+            file_.truncate(size);
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            Detail::init(storage_->content(), bucketsCount);
+        }
+    }
+
+    /// Return true on map initialized.
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return static_cast<bool>(file_);
+    }
+
+    /// Result of applying mapping options to the map mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
+    /// Create writer for the map. Throws on error.
+    [[nodiscard]] auto createWriter(Hash hash = Hash()) -> Writer {
+        if (!operator bool()) {
+            throw std::runtime_error("hash map not initialized");
+        }
+        if (!file_.tryLock()) {
+            throw std::runtime_error("can't create writer (already exists?)");
+        }
+        return Writer(storage_, std::move(hash));
+    }
+
+    /// Create reader for the map. Throws on error.
+    [[nodiscard]] auto createReader(Hash hash = Hash()) const -> Reader {
+        if (!operator bool()) {
+            throw std::runtime_error("hash map not initialized");
+        }
+        return Reader(storage_, std::move(hash));
+    }
+
+    /// Swap resources with other map.
+    void swap(SharedHashMap& that) noexcept {
+        using std::swap;
+        swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
+    }
+
+    /// \see SharedHashMap::swap
+    friend void swap(SharedHashMap& a, SharedHashMap& b) noexcept {
+        a.swap(b);
+    }
+};
+
+} // namespace rocket
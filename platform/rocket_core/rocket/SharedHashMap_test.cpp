@@ -0,0 +1,267 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <array>
+#include <bit>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <unistd.h>
+
+#include <doctest/doctest.h>
+
+#include "SharedHashMap.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Fixed size symbol key
+struct Symbol {
+    std::array<char, 16> value{};
+
+    explicit Symbol(std::string_view symbol) noexcept {
+        std::copy_n(symbol.begin(), std::min(symbol.size(), value.size()), value.begin());
+    }
+
+    [[nodiscard]] friend auto operator==(Symbol const&, Symbol const&) noexcept -> bool = default;
+};
+
+/// FNV-1a over symbol, stable across processes
+struct SymbolHash {
+    [[nodiscard]] auto operator()(Symbol const& symbol) const noexcept -> std::uint64_t {
+        std::uint64_t hash = 0xcbf29ce484222325;
+        for (auto const c : symbol.value) {
+            hash = (hash ^ std::uint8_t(c)) * 0x100000001b3;
+        }
+        return hash;
+    }
+};
+
+/// Value with all fields derived from key and version, torn read mixes them
+struct OrderState {
+    std::uint64_t orderID;
+    std::uint64_t version;
+    std::uint64_t check;
+};
+
+} // namespace
+
+TEST_CASE("SharedHashMap: basic") {
+    SharedHashMap<std::uint64_t, std::uint64_t> map("test", {.capacity = 100}, AnonymousMemorySource());
+    REQUIRE(map);
+
+    auto writer = map.createWriter();
+    auto reader = map.createReader();
+
+    std::uint64_t value = 0;
+    REQUIRE(!reader.find(1, value));
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(writer.insertOrAssign(i, i * 10));
+    }
+    REQUIRE(writer.size() == 100);
+    REQUIRE(reader.size() == 100);
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(reader.find(i, value));
+        REQUIRE(value == i * 10);
+        REQUIRE(writer.find(i));
+        REQUIRE(*writer.find(i) == i * 10);
+    }
+    REQUIRE(!reader.find(100, value));
+
+    // Assign keeps size
+    REQUIRE(writer.insertOrAssign(5, 555));
+    REQUIRE(writer.size() == 100);
+    REQUIRE(reader.find(5, value));
+    REQUIRE(value == 555);
+
+    // Erased slots are reused
+    for (std::uint64_t i = 0; i < 100; i += 2) {
+        REQUIRE(writer.erase(i));
+    }
+    REQUIRE(!writer.erase(0));
+    REQUIRE(writer.size() == 50);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(reader.find(i, value) == (i % 2 == 1));
+    }
+    for (std::uint64_t i = 1000; i < 1050; ++i) {
+        REQUIRE(writer.insertOrAssign(i, i));
+    }
+    REQUIRE(writer.size() == 100);
+    for (std::uint64_t i = 1000; i < 1050; ++i) {
+        REQUIRE(reader.find(i, value));
+        REQUIRE(value == i);
+    }
+}
+
+TEST_CASE("SharedHashMap: full") {
+    SharedHashMap<std::uint64_t, std::uint64_t> map("test", {.capacity = 1}, AnonymousMemorySource());
+    auto writer = map.createWriter();
+    auto reader = map.createReader();
+
+    // Single bucket
+    std::uint64_t count = 0;
+    while (writer.insertOrAssign(count, count)) {
+        ++count;
+    }
+    REQUIRE(count == detail::SharedHashMapDetail<std::uint64_t, std::uint64_t>::kBucketSlots);
+
+    // Lookup of absent key terminates on map without free slots
+    std::uint64_t value;
+    REQUIRE(!reader.find(count, value));
+    REQUIRE(writer.erase(3));
+    REQUIRE(!reader.find(3, value));
+    REQUIRE(writer.insertOrAssign(count, count));
+    REQUIRE(reader.find(count, value));
+}
+
+TEST_CASE("SharedHashMap: symbols across reopen") {
+    using Map = SharedHashMap<Symbol, std::uint32_t, SymbolHash>;
+
+    auto const name = "test-hashmap-" + std::to_string(::getpid());
+    auto memorySource = DefaultMemorySource();
+    {
+        Map map(name, {.capacity = 1000}, memorySource);
+        auto writer = map.createWriter();
+        REQUIRE(writer.insertOrAssign(Symbol("AAPL"), 1));
+        REQUIRE(writer.insertOrAssign(Symbol("MSFT"), 2));
+        REQUIRE(writer.insertOrAssign(Symbol("ESZ5"), 3));
+    }
+    {
+        Map map(name, memorySource);
+        auto reader = map.createReader();
+        std::uint32_t id = 0;
+        REQUIRE(reader.find(Symbol("MSFT"), id));
+        REQUIRE(id == 2);
+        REQUIRE(reader.find(Symbol("ESZ5"), id));
+        REQUIRE(id == 3);
+        REQUIRE(!reader.find(Symbol("GOOG"), id));
+    }
+
+    // Options mismatch
+    REQUIRE_THROWS(Map(name, {.capacity = 100000}, memorySource));
+    REQUIRE_THROWS(SharedHashMap<std::uint64_t, std::uint32_t>(name, memorySource));
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("SharedHashMap: erase frees slots") {
+    using Map = SharedHashMap<std::uint64_t, std::uint64_t>;
+    using Detail = detail::SharedHashMapDetail<std::uint64_t, std::uint64_t>;
+
+    auto const name = "test-hashmap-" + std::to_string(::getpid());
+    auto memorySource = DefaultMemorySource();
+    Map map(name, {.capacity = 64}, memorySource);
+    auto writer = map.createWriter();
+    auto reader = map.createReader();
+
+    // Churn of unique keys at full load overflows buckets over and over
+    std::uint64_t value = 0;
+    for (std::uint64_t round = 0; round < 100; ++round) {
+        for (std::uint64_t key = round * 64; key < (round + 1) * 64; ++key) {
+            REQUIRE(writer.insertOrAssign(key, key));
+        }
+        for (std::uint64_t key = round * 64; key < (round + 1) * 64; ++key) {
+            REQUIRE(reader.find(key, value));
+            REQUIRE(value == key);
+        }
+        for (std::uint64_t key = round * 64; key < (round + 1) * 64; ++key) {
+            REQUIRE(writer.erase(key));
+        }
+    }
+    REQUIRE(writer.size() == 0);
+
+    // No tombstones and overflow left behind
+    auto result = memorySource.open(name, MemorySource::OpenOnly);
+    REQUIRE(result);
+    auto const storage = detail::mapShared(std::get<0>(result.value()));
+    auto const buckets = std::bit_cast<Detail::Bucket const*>(storage->data() + Detail::kDataStartPos);
+    for (std::size_t index = 0; index < Detail::bucketsCount(64); ++index) {
+        REQUIRE(Detail::tags(&buckets[index]) == 0);
+        REQUIRE(buckets[index].overflow == 0);
+    }
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("SharedHashMap: writer died in the middle of modification") {
+    using Map = SharedHashMap<std::uint64_t, std::uint64_t>;
+    using Detail = detail::SharedHashMapDetail<std::uint64_t, std::uint64_t>;
+
+    auto const name = "test-hashmap-" + std::to_string(::getpid());
+    auto memorySource = DefaultMemorySource();
+    {
+        Map map(name, {.capacity = 1}, memorySource);
+        REQUIRE(map.createWriter().insertOrAssign(1, 10));
+    }
+
+    // Bucket sequence is left odd
+    {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        REQUIRE(result);
+        auto const storage = detail::mapShared(std::get<0>(result.value()));
+        std::bit_cast<Detail::Bucket*>(storage->data() + Detail::kDataStartPos)->sequence += 1;
+    }
+
+    Map map(name, memorySource);
+    auto reader = map.createReader();
+    std::uint64_t value = 0;
+    REQUIRE(!reader.find(1, value));
+
+    // Next writer finishes the modification, sequence parity is kept by the following ones
+    auto writer = map.createWriter();
+    REQUIRE(reader.find(1, value));
+    REQUIRE(value == 10);
+    REQUIRE(writer.insertOrAssign(1, 20));
+    REQUIRE(reader.find(1, value));
+    REQUIRE(value == 20);
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+TEST_CASE("SharedHashMap: concurrent reader") {
+    constexpr std::uint64_t kKeys = 64;
+    constexpr std::uint64_t kRounds = 2000;
+
+    SharedHashMap<std::uint64_t, OrderState> map("test", {.capacity = kKeys}, AnonymousMemorySource());
+    std::atomic<bool> done{false};
+
+    std::jthread writerThread([&, writer = map.createWriter()]() mutable {
+        for (std::uint64_t round = 1; round <= kRounds; ++round) {
+            for (std::uint64_t key = 0; key < kKeys; ++key) {
+                if (round % 3 == 0 && key % 4 == 0) {
+                    writer.erase(key);
+                } else {
+                    writer.insertOrAssign(key, {.orderID = key, .version = round, .check = key ^ round});
+                }
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    auto reader = map.createReader();
+    bool consistent = true;
+    while (!done.load(std::memory_order_acquire)) {
+        for (std::uint64_t key = 0; key < kKeys; ++key) {
+            OrderState state;
+            if (reader.find(key, state)) {
+                consistent = consistent && state.orderID == key && state.check == (key ^ state.version);
+            }
+        }
+    }
+    writerThread.join();
+    REQUIRE(consistent);
+
+    OrderState state;
+    for (std::uint64_t key = 0; key < kKeys; ++key) {
+        REQUIRE(reader.find(key, state));
+        REQUIRE(state.version == kRounds);
+    }
+}
+
+} // namespace rocket::testing
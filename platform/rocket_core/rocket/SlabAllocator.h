@@ -0,0 +1,559 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "MappedRegion.h"
+#include "MemorySource.h"
+#include "Platform.h"
+#include "detail/math.h"
+#include "detail/memory.h"
+
+namespace rocket {
+
+/// Handle of slab block, offset of the block from region start tagged with size class
+/// Handle is valid in all processes mapping the region, so it could be passed through queues instead of payload
+class SlabHandle {
+  private:
+    static constexpr unsigned kSizeClassShift = 56;
+    static constexpr std::uint64_t kOffsetMask = (std::uint64_t(1) << kSizeClassShift) - 1;
+
+    std::uint64_t value_ = 0;
+
+  public:
+    constexpr SlabHandle() noexcept = default;
+
+    constexpr SlabHandle(std::size_t sizeClass, std::uint64_t offset) noexcept
+        : value_((std::uint64_t(sizeClass) << kSizeClassShift) | offset) {}
+
+    /// Construct from raw value
+    [[nodiscard]] static constexpr auto fromValue(std::uint64_t value) noexcept -> SlabHandle {
+        SlabHandle handle;
+        handle.value_ = value;
+        return handle;
+    }
+
+    /// Raw value
+    [[nodiscard]] constexpr auto value() const noexcept -> std::uint64_t {
+        return value_;
+    }
+
+    /// Block offset from region start
+    [[nodiscard]] constexpr auto offset() const noexcept -> std::uint64_t {
+        return value_ & kOffsetMask;
+    }
+
+    /// Block size class
+    [[nodiscard]] constexpr auto sizeClass() const noexcept -> std::size_t {
+        return value_ >> kSizeClassShift;
+    }
+
+    /// Return true on handle refers block (offset 0 is memory header)
+    [[nodiscard]] constexpr explicit operator bool() const noexcept {
+        return value_ != 0;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(SlabHandle, SlabHandle) noexcept -> bool = default;
+};
+static_assert(sizeof(SlabHandle) == 8 && std::is_trivially_copyable_v<SlabHandle>);
+
+namespace detail {
+
+/// Slab allocator detail
+struct SlabAllocatorDetail {
+    /// Region tag
+    static constexpr std::string_view kTag = "rocket/slab";
+    /// Max size classes count
+    static constexpr std::size_t kMaxSizeClasses = 16;
+    /// Block alignment
+    static constexpr std::size_t kAlign = kHardwareDestructiveInterferenceSize;
+    /// Free list index bits, tag bits are incremented on each update (ABA)
+    static constexpr unsigned kIndexBits = 32;
+    static constexpr std::uint64_t kIndexMask = (std::uint64_t(1) << kIndexBits) - 1;
+
+    /// Size class of the region
+    struct SizeClass {
+        /// Free list head: update tag (high bits) and first free block index + 1 (low bits), own cache line
+        alignas(kAlign) std::uint64_t freeList;
+        /// Block size
+        std::uint64_t blockSize;
+        /// Blocks count
+        std::uint64_t blocksCount;
+        /// First block offset from region start
+        std::uint64_t offset;
+
+        static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+    };
+
+    /// Control struct for region
+    struct MemoryHeader {
+        /// Placeholder for region tag
+        char tag[kTag.size()];
+        /// Size classes count
+        std::uint64_t sizeClassesCount;
+        /// Size classes in ascending block size order
+        SizeClass sizeClasses[kMaxSizeClasses];
+    };
+    static_assert(std::is_trivially_copyable_v<MemoryHeader>);
+
+    /// Offset for the first block from region start
+    static constexpr std::size_t kDataStartPos = detail::align_up(sizeof(MemoryHeader), kAlign);
+
+    /// Check buffer points to valid slab region
+    [[nodiscard]] static auto check(std::span<std::byte const> buffer) noexcept -> bool {
+        if (buffer.size() < kDataStartPos) {
+            return false;
+        }
+        auto const header = std::bit_cast<MemoryHeader const*>(buffer.data());
+        if (!std::equal(kTag.begin(), kTag.end(), header->tag)) {
+            return false;
+        }
+        if (header->sizeClassesCount == 0 || header->sizeClassesCount > kMaxSizeClasses) {
+            return false;
+        }
+        for (std::size_t index = 0; index < header->sizeClassesCount; ++index) {
+            auto const& sizeClass = header->sizeClasses[index];
+            if (sizeClass.offset + sizeClass.blockSize * sizeClass.blocksCount > buffer.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Next free block link stored at block start
+    [[nodiscard]] static auto next(std::byte* block) noexcept -> std::atomic_ref<std::uint32_t> {
+        return std::atomic_ref(*std::bit_cast<std::uint32_t*>(block));
+    }
+
+    /// Block of size class
+    [[nodiscard]] static auto block(std::byte* base, SizeClass const& sizeClass, std::uint64_t index) noexcept
+        -> std::byte* {
+        return base + sizeClass.offset + index * sizeClass.blockSize;
+    }
+
+    /// Pop free block, return index + 1 or zero on size class exhausted
+    [[nodiscard]] static auto pop(std::byte* base, SizeClass& sizeClass) noexcept -> std::uint64_t {
+        auto head = std::atomic_ref(sizeClass.freeList).load(std::memory_order_acquire);
+        while (true) {
+            auto const first = head & kIndexMask;
+            if (first == 0) {
+                return 0;
+            }
+            // Block could be popped and reused concurrently, stale link is rejected by tag
+            auto const link = next(block(base, sizeClass, first - 1)).load(std::memory_order_relaxed);
+            auto const update = ((head >> kIndexBits) + 1) << kIndexBits | link;
+            if (std::atomic_ref(sizeClass.freeList)
+                    .compare_exchange_weak(head, update, std::memory_order_acquire, std::memory_order_acquire)) {
+                return first;
+            }
+        }
+    }
+
+    /// Push chain of free blocks linked from first (index + 1) to last (index + 1)
+    static void push(std::byte* base, SizeClass& sizeClass, std::uint64_t first, std::uint64_t last) noexcept {
+        auto head = std::atomic_ref(sizeClass.freeList).load(std::memory_order_relaxed);
+        while (true) {
+            next(block(base, sizeClass, last - 1)).store(std::uint32_t(head & kIndexMask), std::memory_order_relaxed);
+            auto const update = ((head >> kIndexBits) + 1) << kIndexBits | first;
+            if (std::atomic_ref(sizeClass.freeList)
+                    .compare_exchange_weak(head, update, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+/// Per-thread cache of slab blocks
+/// Blocks are taken from and returned to shared free lists in batches, so the free list cache line is touched once per
+/// batch. Cache is not thread-safe, cached blocks are returned to shared free lists on destruction.
+class SlabAllocatorCache {
+  private:
+    using Detail = detail::SlabAllocatorDetail;
+
+    struct Bin {
+        std::vector<std::uint32_t> blocks;
+    };
+
+    std::shared_ptr<MappedRegion> storage_;
+    std::byte* base_ = nullptr;
+    Detail::MemoryHeader* header_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::array<Bin, Detail::kMaxSizeClasses> bins_;
+
+  public:
+    SlabAllocatorCache() = default;
+
+    SlabAllocatorCache(SlabAllocatorCache&& that) noexcept {
+        swap(that);
+    }
+
+    SlabAllocatorCache& operator=(SlabAllocatorCache&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Construct cache keeping up to capacity blocks of each size class
+    SlabAllocatorCache(std::shared_ptr<MappedRegion> storage, std::size_t capacity)
+        : storage_(std::move(storage)), capacity_(capacity) {
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("invalid slab");
+        }
+        if (capacity_ < 2) {
+            throw std::runtime_error("invalid argument (capacity)");
+        }
+        base_ = storage_->data();
+        header_ = std::bit_cast<Detail::MemoryHeader*>(base_);
+        for (auto& bin : bins_) {
+            bin.blocks.reserve(capacity_);
+        }
+    }
+
+    /// Destructor. Return cached blocks
+    ~SlabAllocatorCache() {
+        flush();
+    }
+
+    /// Return true on initialized
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return storage_ && static_cast<bool>(*storage_);
+    }
+
+    /// Allocate block of at least size bytes from the smallest size class having free blocks
+    /// Return empty handle on no free blocks
+    [[nodiscard]] ROCKET_FORCE_INLINE auto allocate(std::size_t size) noexcept -> SlabHandle {
+        for (std::size_t index = 0; index < header_->sizeClassesCount; ++index) {
+            auto& sizeClass = header_->sizeClasses[index];
+            if (sizeClass.blockSize < size) {
+                continue;
+            }
+            auto& blocks = bins_[index].blocks;
+            if (blocks.empty() && !refill(index)) [[unlikely]] {
+                continue;
+            }
+            auto const block = blocks.back();
+            blocks.pop_back();
+            return SlabHandle(index, sizeClass.offset + block * sizeClass.blockSize);
+        }
+        return {};
+    }
+
+    /// Return block to cache
+    ROCKET_FORCE_INLINE void deallocate(SlabHandle handle) noexcept {
+        assert(handle && handle.sizeClass() < header_->sizeClassesCount);
+        auto const& sizeClass = header_->sizeClasses[handle.sizeClass()];
+        auto& blocks = bins_[handle.sizeClass()].blocks;
+        if (blocks.size() == capacity_) [[unlikely]] {
+            release(handle.sizeClass(), capacity_ / 2);
+        }
+        blocks.push_back(std::uint32_t((handle.offset() - sizeClass.offset) / sizeClass.blockSize));
+    }
+
+    /// Return all cached blocks to shared free lists
+    void flush() noexcept {
+        if (!header_) {
+            return;
+        }
+        for (std::size_t index = 0; index < header_->sizeClassesCount; ++index) {
+            release(index, bins_[index].blocks.size());
+        }
+    }
+
+    /// Swap resources with other cache
+    void swap(SlabAllocatorCache& that) noexcept {
+        using std::swap;
+        swap(storage_, that.storage_);
+        swap(base_, that.base_);
+        swap(header_, that.header_);
+        swap(capacity_, that.capacity_);
+        swap(bins_, that.bins_);
+    }
+
+    /// \see SlabAllocatorCache::swap
+    friend void swap(SlabAllocatorCache& a, SlabAllocatorCache& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    /// Take up to half of capacity blocks from shared free list
+    auto refill(std::size_t index) noexcept -> bool {
+        auto& sizeClass = header_->sizeClasses[index];
+        auto& blocks = bins_[index].blocks;
+        while (blocks.size() < capacity_ / 2) {
+            auto const block = Detail::pop(base_, sizeClass);
+            if (block == 0) {
+                break;
+            }
+            blocks.push_back(std::uint32_t(block - 1));
+        }
+        return !blocks.empty();
+    }
+
+    /// Return count blocks from the top of bin to shared free list as one chain
+    void release(std::size_t index, std::size_t count) noexcept {
+        if (count == 0) {
+            return;
+        }
+        auto& sizeClass = header_->sizeClasses[index];
+        auto& blocks = bins_[index].blocks;
+        auto const begin = blocks.end() - static_cast<std::ptrdiff_t>(count);
+        for (auto it = begin; it + 1 != blocks.end(); ++it) {
+            Detail::next(Detail::block(base_, sizeClass, *it)).store(*(it + 1) + 1, std::memory_order_relaxed);
+        }
+        Detail::push(base_, sizeClass, *begin + 1, blocks.back() + 1);
+        blocks.erase(begin, blocks.end());
+    }
+};
+
+/// Fixed-size block allocator in shared memory region
+///
+/// Region layout:
+/// +--------------+---------------------------+---------------------------+-----
+/// | MemoryHeader | size class 0 blocks       | size class 1 blocks       | ...
+/// +--------------+---------------------------+---------------------------+-----
+///
+/// Each size class has lock-free free list (Treiber stack with ABA tag). Blocks are addressed by SlabHandle, so all
+/// processes mapping the region exchange 8-byte handles instead of copying payload.
+class SlabAllocator {
+  private:
+    using Detail = detail::SlabAllocatorDetail;
+
+    File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
+
+  public:
+    using Cache = SlabAllocatorCache;
+
+    /// Size class options
+    struct SizeClass {
+        /// Block size, aligned up to cache line size
+        std::size_t blockSize;
+        /// Blocks count
+        std::size_t blocksCount;
+    };
+
+    struct CreationOptions {
+        std::vector<SizeClass> sizeClasses;
+    };
+
+    SlabAllocator(SlabAllocator const&) = delete;
+    SlabAllocator& operator=(SlabAllocator const&) = delete;
+    SlabAllocator() = default;
+
+    SlabAllocator(SlabAllocator&& that) noexcept {
+        swap(that);
+    }
+
+    SlabAllocator& operator=(SlabAllocator&& that) noexcept {
+        swap(that);
+        return *this;
+    }
+
+    /// Open only slab. Throws on error.
+    SlabAllocator(std::string_view name, MemorySource const& memorySource = DefaultMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        auto result = memorySource.open(name, MemorySource::OpenOnly);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!Detail::check(storage_->content())) {
+            throw std::runtime_error("failed to open slab (invalid)");
+        }
+    }
+
+    /// Open or create slab. Throws on error.
+    SlabAllocator(std::string_view name, CreationOptions const& options,
+        MemorySource const& memorySource = DefaultMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_(mappingOptions) {
+        auto sizeClasses = options.sizeClasses;
+        if (sizeClasses.empty() || sizeClasses.size() > Detail::kMaxSizeClasses) {
+            throw std::runtime_error("invalid argument (size classes count)");
+        }
+        std::ranges::sort(sizeClasses, {}, &SizeClass::blockSize);
+        for (auto& sizeClass : sizeClasses) {
+            if (sizeClass.blockSize == 0 || sizeClass.blocksCount == 0 || sizeClass.blocksCount > Detail::kIndexMask) {
+                throw std::runtime_error("invalid argument (size class)");
+            }
+            sizeClass.blockSize = detail::align_up(sizeClass.blockSize, Detail::kAlign);
+        }
+
+        auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+        if (!result) {
+            throw std::runtime_error("failed to open memory source");
+        }
+
+        std::size_t pageSize;
+        std::tie(file_, pageSize) = std::move(result).value();
+
+        std::size_t size = Detail::kDataStartPos;
+        for (auto const& sizeClass : sizeClasses) {
+            size += sizeClass.blockSize * sizeClass.blocksCount;
+        }
+        size = detail::align_up(size, pageSize);
+
+        // init slab or check slab's options is the same as requested
+        if (auto const fileSize = file_.getFileSize(); fileSize != 0) {
+            if (fileSize != size) {
+                throw std::runtime_error("size mismatch");
+            }
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!Detail::check(storage_->content()) || !matches(sizeClasses)) {
+                throw std::runtime_error("failed to open slab (invalid)");
+            }
+        } else {
+            file_.truncate(size);
+            storage_ = detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            init(sizeClasses);
+        }
+    }
+
+    /// Return true on slab initialized.
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return static_cast<bool>(file_);
+    }
+
+    /// Result of applying mapping options to the slab mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
+    /// Size classes count
+    [[nodiscard]] auto sizeClassesCount() const noexcept -> std::size_t {
+        return header()->sizeClassesCount;
+    }
+
+    /// Size class options
+    [[nodiscard]] auto sizeClass(std::size_t index) const noexcept -> SizeClass {
+        auto const& sizeClass = header()->sizeClasses[index];
+        return {.blockSize = sizeClass.blockSize, .blocksCount = sizeClass.blocksCount};
+    }
+
+    /// Allocate block of at least size bytes from shared free lists, prefer Cache for frequent allocations
+    /// Return empty handle on no free blocks
+    [[nodiscard]] auto allocate(std::size_t size) noexcept -> SlabHandle {
+        auto const header = this->header();
+        for (std::size_t index = 0; index < header->sizeClassesCount; ++index) {
+            auto& sizeClass = header->sizeClasses[index];
+            if (sizeClass.blockSize < size) {
+                continue;
+            }
+            if (auto const block = Detail::pop(storage_->data(), sizeClass); block != 0) {
+                return SlabHandle(index, sizeClass.offset + (block - 1) * sizeClass.blockSize);
+            }
+        }
+        return {};
+    }
+
+    /// Return block to shared free list
+    void deallocate(SlabHandle handle) noexcept {
+        auto const header = this->header();
+        assert(handle && handle.sizeClass() < header->sizeClassesCount);
+        auto& sizeClass = header->sizeClasses[handle.sizeClass()];
+        auto const block = (handle.offset() - sizeClass.offset) / sizeClass.blockSize + 1;
+        Detail::push(storage_->data(), sizeClass, block, block);
+    }
+
+    /// Block memory
+    [[nodiscard]] ROCKET_FORCE_INLINE auto data(SlabHandle handle) const noexcept -> std::span<std::byte> {
+        auto const& sizeClass = header()->sizeClasses[handle.sizeClass()];
+        return {storage_->data() + handle.offset(), sizeClass.blockSize};
+    }
+
+    /// Block memory as object pointer
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] ROCKET_FORCE_INLINE auto get(SlabHandle handle) const noexcept -> T* {
+        assert(sizeof(T) <= header()->sizeClasses[handle.sizeClass()].blockSize);
+        return std::bit_cast<T*>(storage_->data() + handle.offset());
+    }
+
+    /// Create per-thread cache. Throws on error.
+    [[nodiscard]] auto createCache(std::size_t capacity = 64) -> Cache {
+        if (!operator bool()) {
+            throw std::runtime_error("slab not initialized");
+        }
+        return Cache(storage_, capacity);
+    }
+
+    /// Swap resources with other slab.
+    void swap(SlabAllocator& that) noexcept {
+        using std::swap;
+        swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
+    }
+
+    /// \see SlabAllocator::swap
+    friend void swap(SlabAllocator& a, SlabAllocator& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    [[nodiscard]] auto header() const noexcept -> Detail::MemoryHeader* {
+        return std::bit_cast<Detail::MemoryHeader*>(storage_->data());
+    }
+
+    [[nodiscard]] auto matches(std::vector<SizeClass> const& sizeClasses) const noexcept -> bool {
+        auto const header = this->header();
+        if (header->sizeClassesCount != sizeClasses.size()) {
+            return false;
+        }
+        for (std::size_t index = 0; index < sizeClasses.size(); ++index) {
+            if (header->sizeClasses[index].blockSize != sizeClasses[index].blockSize ||
+                header->sizeClasses[index].blocksCount != sizeClasses[index].blocksCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void init(std::vector<SizeClass> const& sizeClasses) noexcept {
+        auto const base = storage_->data();
+        auto const header = this->header();
+        std::copy(Detail::kTag.begin(), Detail::kTag.end(), header->tag);
+        header->sizeClassesCount = sizeClasses.size();
+
+        std::size_t offset = Detail::kDataStartPos;
+        for (std::size_t index = 0; index < sizeClasses.size(); ++index) {
+            auto& sizeClass = header->sizeClasses[index];
+            sizeClass.blockSize = sizeClasses[index].blockSize;
+            sizeClass.blocksCount = sizeClasses[index].blocksCount;
+            sizeClass.offset = offset;
+            offset += sizeClass.blockSize * sizeClass.blocksCount;
+
+            // Link all blocks in address order
+            for (std::uint64_t block = 0; block + 1 < sizeClass.blocksCount; ++block) {
+                Detail::next(Detail::block(base, sizeClass, block)).store(block + 2, std::memory_order_relaxed);
+            }
+            Detail::next(Detail::block(base, sizeClass, sizeClass.blocksCount - 1)).store(0, std::memory_order_relaxed);
+            std::atomic_ref(sizeClass.freeList).store(1, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace rocket
@@ -0,0 +1,162 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "BoundedSPSCRawQueue.h"
+#include "SlabAllocator.h"
+#include "TestUtils.h"
+
+namespace rocket::testing {
+
+TEST_CASE("SlabAllocator: basic") {
+    SlabAllocator slab("test", {.sizeClasses = {{256, 4}, {64, 8}}}, AnonymousMemorySource());
+    REQUIRE(slab);
+    REQUIRE(slab.sizeClassesCount() == 2);
+    REQUIRE(slab.sizeClass(0).blockSize == 64);
+    REQUIRE(slab.sizeClass(1).blockSize == 256);
+
+    std::set<std::uint64_t> offsets;
+    std::vector<SlabHandle> handles;
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        auto const handle = slab.allocate(sizeof(std::uint64_t));
+        REQUIRE(handle);
+        REQUIRE(handle.sizeClass() == 0);
+        REQUIRE(offsets.insert(handle.offset()).second);
+        *slab.get<std::uint64_t>(handle) = i;
+        handles.push_back(handle);
+    }
+
+    // Exhausted size class falls back to larger one
+    auto const larger = slab.allocate(sizeof(std::uint64_t));
+    REQUIRE(larger);
+    REQUIRE(larger.sizeClass() == 1);
+    REQUIRE(slab.data(larger).size() == 256);
+
+    for (std::uint64_t i = 0; i < 3; ++i) {
+        REQUIRE(slab.allocate(sizeof(std::uint64_t)));
+    }
+    REQUIRE(!slab.allocate(sizeof(std::uint64_t)));
+    REQUIRE(!slab.allocate(512));
+
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        REQUIRE(*slab.get<std::uint64_t>(handles[i]) == i);
+    }
+
+    slab.deallocate(handles[3]);
+    auto const reused = slab.allocate(1);
+    REQUIRE(reused == handles[3]);
+}
+
+TEST_CASE("SlabAllocator: cache") {
+    SlabAllocator slab("test", {.sizeClasses = {{64, 16}}}, AnonymousMemorySource());
+    {
+        auto cache = slab.createCache(8);
+        REQUIRE(cache);
+
+        std::vector<SlabHandle> handles;
+        while (auto const handle = cache.allocate(1)) {
+            handles.push_back(handle);
+        }
+        REQUIRE(handles.size() == 16);
+        REQUIRE(!slab.allocate(1));
+
+        for (auto const handle : handles) {
+            cache.deallocate(handle);
+        }
+        // Cache keeps up to capacity blocks, the rest is returned to slab in batches
+        std::vector<SlabHandle> shared;
+        while (auto const handle = slab.allocate(1)) {
+            shared.push_back(handle);
+        }
+        REQUIRE(shared.size() == 8);
+        for (auto const handle : shared) {
+            slab.deallocate(handle);
+        }
+    }
+
+    // Destroyed cache returns all blocks
+    std::set<std::uint64_t> offsets;
+    while (auto const handle = slab.allocate(1)) {
+        REQUIRE(offsets.insert(handle.offset()).second);
+    }
+    REQUIRE(offsets.size() == 16);
+}
+
+TEST_CASE("SlabAllocator: handles passed through queue") {
+    struct Message {
+        std::uint64_t sequence;
+        char text[56];
+    };
+
+    SlabAllocator slab("test", {.sizeClasses = {{sizeof(Message), 64}}}, AnonymousMemorySource());
+    BoundedSPSCRawQueue queue("test", BoundedSPSCRawQueue::CreationOptions(1 << 12), AnonymousMemorySource());
+    auto producer = queue.createProducer();
+    auto consumer = queue.createConsumer();
+
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        auto const handle = slab.allocate(sizeof(Message));
+        REQUIRE(handle);
+        slab.get<Message>(handle)->sequence = i;
+        REQUIRE(enqueue(producer, handle.value()));
+
+        std::uint64_t value = 0;
+        REQUIRE(dequeue(consumer, value));
+        auto const received = SlabHandle::fromValue(value);
+        REQUIRE(received == handle);
+        REQUIRE(slab.get<Message>(received)->sequence == i);
+        slab.deallocate(received);
+    }
+}
+
+TEST_CASE("SlabAllocator: concurrent") {
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kBlocks = 256;
+    constexpr std::size_t kIterations = 20000;
+
+    SlabAllocator slab("test", {.sizeClasses = {{64, kBlocks}}}, AnonymousMemorySource());
+
+    // Every thread owns block while holding it, marker is overwritten only by owner
+    std::vector<std::jthread> threads;
+    std::atomic<bool> failed{false};
+    for (std::size_t index = 0; index < kThreads; ++index) {
+        threads.emplace_back([&, index, cache = slab.createCache(16)]() mutable {
+            std::vector<SlabHandle> held;
+            for (std::size_t i = 0; i < kIterations; ++i) {
+                if (held.size() < 32 && (i % 3) != 2) {
+                    if (auto const handle = cache.allocate(1)) {
+                        *slab.get<std::uint64_t>(handle) = index + 1;
+                        held.push_back(handle);
+                    }
+                } else if (!held.empty()) {
+                    auto const handle = held.back();
+                    held.pop_back();
+                    if (*slab.get<std::uint64_t>(handle) != index + 1) {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                    cache.deallocate(handle);
+                }
+            }
+            for (auto const handle : held) {
+                cache.deallocate(handle);
+            }
+        });
+    }
+    threads.clear();
+
+    REQUIRE(!failed.load());
+
+    std::set<std::uint64_t> offsets;
+    while (auto const handle = slab.allocate(1)) {
+        REQUIRE(offsets.insert(handle.offset()).second);
+    }
+    REQUIRE(offsets.size() == kBlocks);
+}
+
+} // namespace rocket::testing
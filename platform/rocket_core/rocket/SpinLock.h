@@ -6,11 +6,46 @@
 #include <immintrin.h>
 
 #include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Platform.h"
 
 namespace rocket {
 
+/// Exponential backoff for spin loops
+/// Each pause() spins twice longer than the previous one, so waiters stop hammering contended cache line. Waiter yields
+/// CPU after the longest spin, lock owner (or the next waiter of fair lock) might be preempted on CPU oversubscribed.
+class SpinBackoff {
+  public:
+    static constexpr std::uint32_t kMaxSpins = 1024;
+
+  private:
+    std::uint32_t spins_ = 1;
+
+  public:
+    /// Spin and double the next spin, yield on the longest spin reached
+    ROCKET_FORCE_INLINE void pause() noexcept {
+        if (spins_ < kMaxSpins) [[likely]] {
+            for (std::uint32_t i = 0; i < spins_; ++i) {
+                _mm_pause();
+            }
+            spins_ *= 2;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    /// Restart from the shortest spin
+    ROCKET_FORCE_INLINE void reset() noexcept {
+        spins_ = 1;
+    }
+};
+
 /// mimic: std::mutex
 /// std::lock_guard works!
+/// Test-and-test-and-set lock: waiters spin on read with exponential backoff and retry the write only on the lock is
+/// seen released. Not fair, prefer TicketLock or McsLock on many threads contend.
 class SpinLock final {
   private:
     std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
@@ -19,13 +54,16 @@ class SpinLock final {
     /// Locks the SpinLock, blocks if SpinLock is not available
     void lock() noexcept {
         while (flag_.test_and_set(std::memory_order_acquire)) {
-            _mm_pause();
+            SpinBackoff backoff;
+            do {
+                backoff.pause();
+            } while (flag_.test(std::memory_order_relaxed));
         }
     }
 
     /// Tries to lock the SpinLock, returns if the SpinLock is not available
     [[nodiscard]] auto try_lock() noexcept -> bool {
-        return !flag_.test_and_set(std::memory_order_acquire);
+        return !flag_.test(std::memory_order_relaxed) && !flag_.test_and_set(std::memory_order_acquire);
     }
 
     /// Unlocks the SpinLock
@@ -34,4 +72,124 @@ class SpinLock final {
     }
 };
 
+/// mimic: std::mutex
+/// Fair (FIFO) lock: each waiter takes a ticket and waits for it to be served, backoff is proportional to the
+/// number of waiters ahead. All waiters still spin on the same cache line, see McsLock. Fair locks stall on the next
+/// waiter preempted, so waiters yield CPU after spinning for a while.
+class TicketLock final {
+  private:
+    /// Pauses per waiter ahead
+    static constexpr std::uint32_t kPausesPerWaiter = 32;
+    /// Yield after waiting rounds
+    static constexpr std::uint32_t kYieldRounds = 64;
+
+    std::atomic<std::uint32_t> next_{0};
+    std::atomic<std::uint32_t> serving_{0};
+
+  public:
+    /// Locks the TicketLock, blocks if TicketLock is not available
+    void lock() noexcept {
+        auto const ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        for (std::uint32_t rounds = 0;; ++rounds) {
+            auto const serving = serving_.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                return;
+            }
+            if (rounds < kYieldRounds) [[likely]] {
+                for (std::uint32_t i = (ticket - serving) * kPausesPerWaiter; i != 0; --i) {
+                    _mm_pause();
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Tries to lock the TicketLock, returns if the TicketLock is not available
+    [[nodiscard]] auto try_lock() noexcept -> bool {
+        auto serving = serving_.load(std::memory_order_relaxed);
+        return next_.compare_exchange_strong(
+            serving, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /// Unlocks the TicketLock
+    void unlock() noexcept {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+/// Fair (FIFO) queue lock (Mellor-Crummey and Scott)
+/// Each waiter spins on own node, so lock handover touches the cache lines of the owner and the next waiter only.
+/// Node lives on the waiter stack while the lock is held, use McsLock::Guard.
+class McsLock final {
+  public:
+    /// Queue node of waiter, own cache line
+    struct alignas(kHardwareDestructiveInterferenceSize) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    /// mimic: std::lock_guard
+    class Guard {
+      private:
+        McsLock& lock_;
+        Node node_;
+
+      public:
+        Guard(Guard const&) = delete;
+        Guard& operator=(Guard const&) = delete;
+
+        explicit Guard(McsLock& lock) noexcept : lock_(lock) {
+            lock_.lock(node_);
+        }
+
+        ~Guard() noexcept {
+            lock_.unlock(node_);
+        }
+    };
+
+  private:
+    std::atomic<Node*> tail_{nullptr};
+
+  public:
+    /// Locks the McsLock, blocks if McsLock is not available
+    void lock(Node& node) noexcept {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.locked.store(true, std::memory_order_relaxed);
+        auto const prev = tail_.exchange(&node, std::memory_order_acq_rel);
+        if (prev) {
+            prev->next.store(&node, std::memory_order_release);
+            SpinBackoff backoff;
+            while (node.locked.load(std::memory_order_acquire)) {
+                backoff.pause();
+            }
+        }
+    }
+
+    /// Tries to lock the McsLock, returns if the McsLock is not available
+    [[nodiscard]] auto try_lock(Node& node) noexcept -> bool {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        return tail_.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /// Unlocks the McsLock locked with node, hands it over to the next waiter
+    void unlock(Node& node) noexcept {
+        auto next = node.next.load(std::memory_order_acquire);
+        if (!next) {
+            auto expected = &node;
+            if (tail_.compare_exchange_strong(
+                    expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+            // Next waiter swapped tail but not linked yet
+            SpinBackoff backoff;
+            while (!(next = node.next.load(std::memory_order_acquire))) {
+                backoff.pause();
+            }
+        }
+        next->locked.store(false, std::memory_order_release);
+    }
+};
+
 } // namespace rocket
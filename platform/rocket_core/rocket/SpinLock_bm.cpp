@@ -0,0 +1,63 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <cstdint>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include "SpinLock.h"
+
+namespace rocket::testing {
+namespace {
+
+/// Lock guard for mutex-like locks
+template <typename LockT>
+struct Locker {
+    template <typename Fn>
+    ROCKET_FORCE_INLINE static void with(LockT& lock, Fn&& fn) {
+        std::lock_guard guard(lock);
+        fn();
+    }
+};
+
+/// \see Locker
+template <>
+struct Locker<McsLock> {
+    template <typename Fn>
+    ROCKET_FORCE_INLINE static void with(McsLock& lock, Fn&& fn) {
+        McsLock::Guard guard(lock);
+        fn();
+    }
+};
+
+/// Shared state guarded by lock, counters share cache line with nothing else
+template <typename LockT>
+struct alignas(kHardwareDestructiveInterferenceSize) Shared {
+    LockT lock;
+    alignas(kHardwareDestructiveInterferenceSize) std::uint64_t counter = 0;
+};
+
+} // namespace
+
+/// All threads increment shared counter under lock, the first argument is pauses outside of the critical section
+template <typename LockT>
+static void BM_SpinLock_Contention(::benchmark::State& state) {
+    static Shared<LockT> shared;
+    auto const pauses = state.range(0);
+
+    for (auto _ : state) {
+        Locker<LockT>::with(shared.lock, [] { benchmark::DoNotOptimize(++shared.counter); });
+        for (auto i = pauses; i != 0; --i) {
+            _mm_pause();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_SpinLock_Contention, std::mutex)->Arg(0)->Arg(64)->ThreadRange(2, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpinLock_Contention, SpinLock)->Arg(0)->Arg(64)->ThreadRange(2, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpinLock_Contention, TicketLock)->Arg(0)->Arg(64)->ThreadRange(2, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpinLock_Contention, McsLock)->Arg(0)->Arg(64)->ThreadRange(2, 32)->UseRealTime();
+
+} // namespace rocket::testing
@@ -0,0 +1,84 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "SpinLock.h"
+
+namespace rocket::testing {
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::uint64_t kIterations = 10000;
+
+/// Increment counter under lock from several threads, lost update means broken mutual exclusion
+template <typename LockFn>
+auto contend(LockFn&& withLock) -> std::uint64_t {
+    std::uint64_t counter = 0;
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t index = 0; index < kThreads; ++index) {
+            threads.emplace_back([&] {
+                for (std::uint64_t i = 0; i < kIterations; ++i) {
+                    withLock([&] {
+                        auto const value = counter;
+                        std::atomic_signal_fence(std::memory_order_seq_cst);
+                        counter = value + 1;
+                    });
+                }
+            });
+        }
+    }
+    return counter;
+}
+
+/// Check mutex-like lock
+template <typename LockT>
+void checkLock() {
+    LockT lock;
+    auto const counter = contend([&](auto&& fn) {
+        std::lock_guard guard(lock);
+        fn();
+    });
+    REQUIRE(counter == kThreads * kIterations);
+
+    REQUIRE(lock.try_lock());
+    REQUIRE(!lock.try_lock());
+    lock.unlock();
+    REQUIRE(lock.try_lock());
+    lock.unlock();
+}
+
+} // namespace
+
+TEST_CASE("SpinLock: mutual exclusion") {
+    checkLock<SpinLock>();
+}
+
+TEST_CASE("SpinLock: TicketLock mutual exclusion") {
+    checkLock<TicketLock>();
+}
+
+TEST_CASE("SpinLock: McsLock mutual exclusion") {
+    McsLock lock;
+    auto const counter = contend([&](auto&& fn) {
+        McsLock::Guard guard(lock);
+        fn();
+    });
+    REQUIRE(counter == kThreads * kIterations);
+
+    McsLock::Node node;
+    McsLock::Node other;
+    REQUIRE(lock.try_lock(node));
+    REQUIRE(!lock.try_lock(other));
+    lock.unlock(node);
+    REQUIRE(lock.try_lock(other));
+    lock.unlock(other);
+}
+
+} // namespace rocket::testing
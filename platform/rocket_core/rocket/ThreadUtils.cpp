@@ -6,6 +6,7 @@
 #include <cerrno>
 
 #include <pthread.h>
+#include <signal.h>
 
 namespace rocket {
 
@@ -38,4 +39,8 @@ auto pinCurrentThreadToCoreNo(std::uint16_t coreNo) noexcept -> std::expected<vo
     return {};
 }
 
+auto isProcessAlive(int pid) noexcept -> bool {
+    return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
 } // namespace rocket
@@ -20,4 +20,7 @@ auto setThisThreadName(std::string const& value) -> std::expected<void, std::err
 /// Pin current thread to specified core number
 auto pinCurrentThreadToCoreNo(std::uint16_t coreNo) noexcept -> std::expected<void, std::error_code>;
 
+/// Return true on process with the pid exists (including processes of other users)
+[[nodiscard]] auto isProcessAlive(int pid) noexcept -> bool;
+
 } // namespace rocket
@@ -0,0 +1,395 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "TscClock.h"
+
+#include <cpuid.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "MemorySource.h"
+#include "detail/math.h"
+#include "detail/memory.h"
+
+namespace rocket {
+namespace {
+
+/// Max number of attempts to take a sample with small read window
+constexpr std::size_t kMaxSampleAttempts = 8;
+
+/// First refinement interval, doubled on each refinement
+constexpr auto kFirstRefineInterval = std::chrono::milliseconds(10);
+
+/// Interval for base point re-sync after the rate settled
+constexpr auto kResyncInterval = std::chrono::milliseconds(1000);
+
+/// Baseline length required for considering clock calibrated
+constexpr auto kCalibratedBaseline = std::chrono::milliseconds(100);
+
+/// Initial rate measurement duration (CPU doesn't report TSC frequency)
+constexpr auto kInitialMeasurement = std::chrono::milliseconds(1);
+
+/// Baseline length required for refining rate taken over from the previous shared page owner
+constexpr auto kTakeOverBaseline = std::chrono::seconds(10);
+
+/// Max time to wait for shared page initialization by owner
+constexpr auto kSharedPageWaitTimeout = std::chrono::seconds(1);
+
+/// Max time parameters could stay in the middle of update before the writer considered dead
+constexpr auto kStuckUpdateTimeout = std::chrono::milliseconds(50);
+
+using SharedPage = rocket::detail::TscClockSharedPage;
+
+/// Options for global instance
+struct GlobalOptions {
+    std::mutex mutex;
+    TscClockOptions options;
+    bool created = false;
+};
+
+[[nodiscard]] auto globalOptions() noexcept -> GlobalOptions& {
+    static auto* options = new GlobalOptions();
+    return *options;
+}
+
+[[nodiscard]] auto clockNow(clockid_t clockID) noexcept -> std::int64_t {
+    ::timespec ts;
+    ::clock_gettime(clockID, &ts);
+    return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+/// Ticks and clocks read at the same point
+struct Sample {
+    std::int64_t ticks;
+    std::int64_t monotonicRaw;
+    std::int64_t realtime;
+};
+
+/// Take a sample with the smallest ticks window out of a few attempts
+[[nodiscard]] auto takeSample(TscClock const& clock) noexcept -> Sample {
+    auto result = Sample{};
+    auto bestWindow = std::numeric_limits<std::int64_t>::max();
+
+    for (std::size_t attempt = 0; attempt < kMaxSampleAttempts; ++attempt) {
+        auto const ticksStart = clock.ticks();
+        auto const monotonicRaw = clockNow(CLOCK_MONOTONIC_RAW);
+        auto const realtime = clockNow(CLOCK_REALTIME);
+        auto const ticksStop = clock.ticks();
+
+        if (auto const window = ticksStop - ticksStart; window < bestWindow) {
+            bestWindow = window;
+            result = Sample{
+                .ticks = (ticksStart & ticksStop) + ((ticksStart ^ ticksStop) >> 1),
+                .monotonicRaw = monotonicRaw,
+                .realtime = realtime,
+            };
+        }
+    }
+
+    return result;
+}
+
+/// Nanoseconds per tick between two samples
+[[nodiscard]] auto rateBetween(Sample const& first, Sample const& second) noexcept -> double {
+    return static_cast<double>(second.monotonicRaw - first.monotonicRaw) /
+           static_cast<double>(second.ticks - first.ticks);
+}
+
+/// TSC frequency reported by CPU (CPUID.15H) or std::nullopt on not reported
+[[nodiscard]] auto cpuidTscFrequency() noexcept -> std::optional<double> {
+    unsigned int denominator = 0;
+    unsigned int numerator = 0;
+    unsigned int crystalHz = 0;
+    unsigned int unused = 0;
+    if (!__get_cpuid(0x15, &denominator, &numerator, &crystalHz, &unused)) {
+        return std::nullopt;
+    }
+    if (denominator == 0 || numerator == 0 || crystalHz == 0) {
+        return std::nullopt;
+    }
+    return static_cast<double>(crystalHz) * numerator / denominator;
+}
+
+} // namespace
+
+auto hasInvariantTsc() noexcept -> bool {
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+}
+
+auto TscClock::instance() noexcept -> TscClock& {
+    static auto* instance = [] {
+        auto& global = globalOptions();
+        std::lock_guard guard{global.mutex};
+        global.created = true;
+        return new TscClock(global.options);
+    }();
+    return *instance;
+}
+
+auto TscClock::configure(TscClockOptions const& options) -> bool {
+    auto& global = globalOptions();
+    std::lock_guard guard{global.mutex};
+    if (global.created) {
+        return false;
+    }
+    global.options = options;
+    return true;
+}
+
+auto TscClock::nowSlow() noexcept -> std::int64_t {
+    return instance().ticks();
+}
+
+TscClock::TscClock(TscClockOptions const& options) : invariantTsc_{hasInvariantTsc()} {
+    ticksSource_.store(invariantTsc_ ? kTicksRdtsc : kTicksMonotonicRaw, std::memory_order_relaxed);
+
+    auto published = false;
+    if (!options.sharedPageName.empty()) {
+        try {
+            published = this->attachSharedPage(options.sharedPageName);
+        } catch (std::exception const& e) {
+            fmt::print(stderr, "rocket: failed to attach TSC clock shared page \"{}\": {}\n", options.sharedPageName,
+                e.what());
+            sharedPage_ = MappedRegion();
+            sharedPageFile_ = File();
+            ownsSharedPage_.store(false, std::memory_order_relaxed);
+            params_.store(&localParams_, std::memory_order_relaxed);
+            calibrated_.store(&localCalibrated_, std::memory_order_relaxed);
+        }
+    }
+
+    if (!published) {
+        this->calibrate(*params_.load(std::memory_order_relaxed), *calibrated_.load(std::memory_order_relaxed));
+        if (sharedPage_) {
+            auto page = std::bit_cast<SharedPage*>(sharedPage_.data());
+            page->ready.store(1, std::memory_order_release);
+        }
+    }
+
+    try {
+        thread_ = std::jthread([this](std::stop_token stopToken) {
+            this->run(stopToken);
+        });
+    } catch (std::system_error const& e) {
+        fmt::print(stderr, "rocket: failed to start TSC clock calibration thread: {}\n", e.what());
+    }
+}
+
+TscClock::~TscClock() = default;
+
+auto TscClock::attachSharedPage(std::string const& name) -> bool {
+    auto result = DefaultMemorySource().open(name, MemorySource::OpenOrCreate);
+    if (!result) {
+        throw std::system_error{result.error()};
+    }
+
+    std::size_t pageSize;
+    std::tie(sharedPageFile_, pageSize) = std::move(result).value();
+    auto const capacity = rocket::detail::align_up(sizeof(SharedPage), pageSize);
+
+    // The lock is held by owner until it exits, it's released by the kernel even on crash
+    if (sharedPageFile_.tryLock()) {
+        ownsSharedPage_.store(true, std::memory_order_release);
+
+        if (auto const fileSize = sharedPageFile_.getFileSize(); fileSize != capacity) {
+            if (fileSize != 0) {
+                throw std::runtime_error{"size mismatch"};
+            }
+            sharedPageFile_.truncate(capacity);
+        }
+        sharedPage_ = rocket::detail::mapFile(sharedPageFile_, capacity);
+
+        auto page = std::bit_cast<SharedPage*>(sharedPage_.data());
+        auto const ready = page->ready.load(std::memory_order_acquire) != 0;
+        if (!ready) {
+            // Nobody attaches before the page is ready
+            page = new (sharedPage_.data()) SharedPage{};
+            std::copy(SharedPage::kTag.begin(), SharedPage::kTag.end(), page->tag);
+            page->invariantTsc = invariantTsc_;
+        } else if (!std::equal(SharedPage::kTag.begin(), SharedPage::kTag.end(), page->tag)) {
+            throw std::runtime_error{"invalid page"};
+        } else if (page->invariantTsc != invariantTsc_) {
+            throw std::runtime_error{"ticks source mismatch"};
+        }
+        params_.store(&page->params, std::memory_order_release);
+        calibrated_.store(&page->calibrated, std::memory_order_release);
+
+        // Parameters calibrated by the previous owner, on it died in the middle of update they are recalibrated
+        // in place: readers attached to the page keep retrying until store() finishes the update
+        return ready && !page->params.isUpdating();
+    }
+
+    // Owner could be still initializing the page
+    auto const deadline = std::chrono::steady_clock::now() + kSharedPageWaitTimeout;
+    while (true) {
+        if (!sharedPage_ && sharedPageFile_.getFileSize() == capacity) {
+            sharedPage_ = rocket::detail::mapFile(sharedPageFile_, capacity);
+        }
+        if (sharedPage_) {
+            auto const page = std::bit_cast<SharedPage const*>(sharedPage_.data());
+            if (page->ready.load(std::memory_order_acquire) != 0) {
+                break;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw std::runtime_error{"timed out waiting for owner"};
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto page = std::bit_cast<SharedPage*>(sharedPage_.data());
+    if (!std::equal(SharedPage::kTag.begin(), SharedPage::kTag.end(), page->tag)) {
+        throw std::runtime_error{"invalid page"};
+    }
+    if (page->invariantTsc != invariantTsc_) {
+        throw std::runtime_error{"ticks source mismatch"};
+    }
+    params_.store(&page->params, std::memory_order_release);
+    calibrated_.store(&page->calibrated, std::memory_order_release);
+    return true;
+}
+
+auto TscClock::paramsSlow() const noexcept -> TscClockParams {
+    auto const block = params_.load(std::memory_order_acquire);
+    auto seq = block->seq.load(std::memory_order_relaxed);
+    auto deadline = std::chrono::steady_clock::now() + kStuckUpdateTimeout;
+
+    TscClockParams params;
+    while (!block->tryLoad(params)) {
+        auto const now = std::chrono::steady_clock::now();
+        if (auto const value = block->seq.load(std::memory_order_relaxed); value != seq) {
+            // Writer is alive
+            seq = value;
+            deadline = now + kStuckUpdateTimeout;
+        } else if (now >= deadline) {
+            // Owner of shared page died in the middle of update, the next owner repairs the page
+            {
+                std::lock_guard guard{mutex_};
+                if (params_.load(std::memory_order_relaxed) == block) {
+                    fmt::print(stderr, "rocket: TSC clock shared page is stuck in the middle of update, "
+                                       "calibrating locally\n");
+                    this->calibrate(localParams_, localCalibrated_);
+                    calibrated_.store(&localCalibrated_, std::memory_order_release);
+                    params_.store(&localParams_, std::memory_order_release);
+                }
+            }
+            return params_.load(std::memory_order_acquire)->load();
+        }
+        std::this_thread::yield();
+    }
+    return params;
+}
+
+void TscClock::calibrate(TscClockParamsBlock& params, std::atomic<bool>& calibrated) const {
+    auto sample = takeSample(*this);
+    auto nanosecondsPerTick = 1.0;
+
+    if (invariantTsc_) {
+        if (auto const frequency = cpuidTscFrequency(); frequency) {
+            nanosecondsPerTick = 1e9 / *frequency;
+        } else {
+            auto const first = sample;
+            while (clockNow(CLOCK_MONOTONIC_RAW) - first.monotonicRaw < kInitialMeasurement.count() * 1000000l) {}
+            sample = takeSample(*this);
+            nanosecondsPerTick = rateBetween(first, sample);
+        }
+    } else {
+        // Ticks are CLOCK_MONOTONIC_RAW nanoseconds, rate is known
+        calibrated.store(true, std::memory_order_release);
+    }
+
+    params.store(TscClockParams{
+        .ticksBase = sample.ticks,
+        .wallClockBase = sample.realtime,
+        .nanosecondsPerTick = nanosecondsPerTick,
+    });
+}
+
+void TscClock::run(std::stop_token stopToken) {
+    std::unique_lock lock{mutex_};
+    // Wakes up on stop requested only, returns true on stop requested
+    auto const stopped = [&](std::chrono::milliseconds interval) {
+        return cv_.wait_for(lock, stopToken, interval, [&stopToken] {
+            return stopToken.stop_requested();
+        });
+    };
+
+    // Rate published by another process is more accurate than one measured over a short baseline
+    auto minRateBaseline = std::chrono::nanoseconds::zero();
+    auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(kFirstRefineInterval);
+
+    if (sharedPage_ && !this->ownsSharedPage()) {
+        // Owner calibrates, take over once it exits
+        while (true) {
+            if (stopped(kResyncInterval)) {
+                return;
+            }
+            try {
+                if (sharedPageFile_.tryLock()) {
+                    break;
+                }
+            } catch (std::exception const& e) {
+                fmt::print(stderr, "rocket: failed to lock TSC clock shared page: {}\n", e.what());
+                return;
+            }
+        }
+        ownsSharedPage_.store(true, std::memory_order_release);
+        minRateBaseline = kTakeOverBaseline;
+        interval = kResyncInterval;
+
+        auto page = std::bit_cast<SharedPage*>(sharedPage_.data());
+        if (page->params.isUpdating()) {
+            // Previous owner died in the middle of update, store() of calibration finishes it
+            this->calibrate(page->params, page->calibrated);
+        }
+        // Readers of this process might have fallen back to local parameters
+        calibrated_.store(&page->calibrated, std::memory_order_release);
+        params_.store(&page->params, std::memory_order_release);
+    } else if (sharedPage_ && calibrated_.load(std::memory_order_relaxed)->load(std::memory_order_acquire)) {
+        // Owner exited before this clock created
+        minRateBaseline = kTakeOverBaseline;
+        interval = kResyncInterval;
+    }
+
+    auto const first = takeSample(*this);
+
+    while (!stopped(interval)) {
+        auto const sample = takeSample(*this);
+        auto const block = params_.load(std::memory_order_relaxed);
+        auto params = block->load();
+        auto const baseline = std::chrono::nanoseconds(sample.monotonicRaw - first.monotonicRaw);
+
+        // Long baseline averages out sampling jitter
+        if (invariantTsc_ && baseline >= minRateBaseline) {
+            params.nanosecondsPerTick = rateBetween(first, sample);
+        }
+        params.ticksBase = sample.ticks;
+        params.wallClockBase = sample.realtime;
+        block->store(params);
+
+        if (baseline >= kCalibratedBaseline) {
+            calibrated_.load(std::memory_order_relaxed)->store(true, std::memory_order_release);
+        }
+
+        interval = std::min<std::chrono::milliseconds>(interval * 2, kResyncInterval);
+    }
+}
+
+} // namespace rocket
@@ -0,0 +1,264 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "File.h"
+#include "MappedRegion.h"
+#include "Platform.h"
+
+namespace rocket {
+
+/// Ticks to wall clock conversion parameters
+struct TscClockParams {
+    /// Ticks at base point
+    std::int64_t ticksBase = 0;
+    /// Wall clock (CLOCK_REALTIME) nanoseconds since epoch at base point
+    std::int64_t wallClockBase = 0;
+    /// Nanoseconds per tick
+    double nanosecondsPerTick = 1.0;
+};
+
+/// Conversion parameters published with a seqlock
+/// Single writer, any number of lock-free readers
+struct TscClockParamsBlock {
+    /// Max snapshot attempts of tryLoad()
+    static constexpr std::size_t kMaxLoadAttempts = 64;
+
+    /// Sequence number, odd while writer updates parameters
+    alignas(kHardwareDestructiveInterferenceSize) std::atomic<std::uint64_t> seq{0};
+    std::atomic<std::int64_t> ticksBase{0};
+    std::atomic<std::int64_t> wallClockBase{0};
+    std::atomic<double> nanosecondsPerTick{1.0};
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<double>::is_always_lock_free);
+
+    /// Publish parameters (single writer)
+    /// Sequence parity is forced, so an update left unfinished by the previous writer doesn't invert it
+    ROCKET_FORCE_INLINE void store(TscClockParams const& params) noexcept {
+        auto const value = seq.load(std::memory_order_relaxed) | 1;
+        seq.store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ticksBase.store(params.ticksBase, std::memory_order_relaxed);
+        wallClockBase.store(params.wallClockBase, std::memory_order_relaxed);
+        nanosecondsPerTick.store(params.nanosecondsPerTick, std::memory_order_relaxed);
+        seq.store(value + 1, std::memory_order_release);
+    }
+
+    /// Try to read consistent snapshot of parameters
+    /// @return false on writer was updating parameters for all kMaxLoadAttempts attempts
+    [[nodiscard]] ROCKET_FORCE_INLINE auto tryLoad(TscClockParams& params) const noexcept -> bool {
+        for (std::size_t attempt = 0; attempt < kMaxLoadAttempts; ++attempt) {
+            auto const value = seq.load(std::memory_order_acquire);
+            params.ticksBase = ticksBase.load(std::memory_order_relaxed);
+            params.wallClockBase = wallClockBase.load(std::memory_order_relaxed);
+            params.nanosecondsPerTick = nanosecondsPerTick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((value & 1) == 0 && value == seq.load(std::memory_order_relaxed)) [[likely]] {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Read consistent snapshot of parameters, blocks while writer updates parameters
+    /// Use by the writer itself or on the writer can't die in the middle of update (same process)
+    [[nodiscard]] ROCKET_FORCE_INLINE auto load() const noexcept -> TscClockParams {
+        TscClockParams params;
+        while (!this->tryLoad(params)) {
+            std::this_thread::yield();
+        }
+        return params;
+    }
+
+    /// Return true on writer is in the middle of update or died in it, parameters might be torn
+    /// The next writer finishes the update by store(), readers keep retrying until the parameters are complete
+    [[nodiscard]] auto isUpdating() const noexcept -> bool {
+        return (seq.load(std::memory_order_relaxed) & 1) != 0;
+    }
+};
+
+namespace detail {
+
+/// Shared clock parameters page layout
+struct TscClockSharedPage {
+    static constexpr std::string_view kTag = "rocket/tsc-clock";
+
+    char tag[kTag.size()];
+    /// Non-zero on page initialized by owner
+    std::atomic<std::uint32_t> ready;
+    /// True on ticks read with rdtsc by owner
+    bool invariantTsc;
+    std::atomic<bool> calibrated;
+    TscClockParamsBlock params;
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+static_assert(std::atomic<bool>::is_always_lock_free);
+
+} // namespace detail
+
+/// Default name of shared clock parameters page
+inline constexpr auto kDefaultTscClockSharedPageName = "rocket-tsc-clock";
+
+struct TscClockOptions {
+    /// Name of shared clock parameters page at /dev/shm (see DefaultMemorySource)
+    /// Empty name means the clock is calibrated by the process itself
+    std::string sharedPageName;
+};
+
+/// Return true on CPU has invariant TSC (CPUID.80000007H:EDX[8])
+[[nodiscard]] auto hasInvariantTsc() noexcept -> bool;
+
+/// TSC clock
+///
+/// Ticks are read with rdtsc on CPU with invariant TSC and from CLOCK_MONOTONIC_RAW (nanoseconds) otherwise.
+/// Conversion into wall clock time is lock-free and safe from any thread. Initial rate is taken from CPUID (or a short
+/// measurement) and refined by a background thread against CLOCK_MONOTONIC_RAW over a growing baseline, the base point
+/// is re-synced with CLOCK_REALTIME periodically.
+///
+/// With shared page enabled parameters are placed into a page shared by all processes on the host, so timestamps are
+/// converted identically everywhere. The first process takes an exclusive lock on the page and calibrates, the
+/// others skip calibration and take over once the owner exits. Parameters left in the middle of update by the owner
+/// died are repaired by the next owner, readers seeing them stuck fall back to calibration by the process itself.
+class TscClock {
+  private:
+    static constexpr std::uint32_t kTicksRdtsc = 1;
+    static constexpr std::uint32_t kTicksMonotonicRaw = 2;
+
+    /// Ticks source of the process, set by clock constructor, read by now() without global instance lookup
+    static inline std::atomic<std::uint32_t> ticksSource_{0};
+
+    // Switched to local parameters by readers on shared page stuck in the middle of update
+    mutable TscClockParamsBlock localParams_;
+    mutable std::atomic<bool> localCalibrated_{false};
+    mutable std::atomic<TscClockParamsBlock*> params_{&localParams_};
+    mutable std::atomic<std::atomic<bool>*> calibrated_{&localCalibrated_};
+    bool invariantTsc_ = false;
+    File sharedPageFile_;
+    MappedRegion sharedPage_;
+    std::atomic<bool> ownsSharedPage_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::jthread thread_;
+
+  public:
+    TscClock(TscClock const&) = delete;
+    TscClock& operator=(TscClock const&) = delete;
+
+    /// Construct clock and start calibration thread
+    /// Falls back to calibration by the process itself on shared page is not available
+    explicit TscClock(TscClockOptions const& options = {});
+
+    /// Destructor. Stop calibration thread
+    ~TscClock();
+
+    /// Global instance, calibration thread started on first call
+    /// The instance is never destroyed, so it's safe to use during static destruction
+    [[nodiscard]] static auto instance() noexcept -> TscClock&;
+
+    /// Set options for global instance
+    /// @return false on global instance already created
+    static auto configure(TscClockOptions const& options) -> bool;
+
+    /// Current ticks
+    /// Reads rdtsc inline once any clock is created, global instance is created on the first call otherwise
+    [[nodiscard]] ROCKET_FORCE_INLINE static auto now() noexcept -> std::int64_t {
+        if (ticksSource_.load(std::memory_order_relaxed) == kTicksRdtsc) [[likely]] {
+            return __builtin_ia32_rdtsc();
+        }
+        return nowSlow();
+    }
+
+    /// Current ticks
+    [[nodiscard]] ROCKET_FORCE_INLINE auto ticks() const noexcept -> std::int64_t {
+        if (invariantTsc_) [[likely]] {
+            return __builtin_ia32_rdtsc();
+        }
+        ::timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return ts.tv_sec * 1000000000l + ts.tv_nsec;
+    }
+
+    /// Return true on ticks read with rdtsc
+    [[nodiscard]] auto isInvariantTsc() const noexcept -> bool {
+        return invariantTsc_;
+    }
+
+    /// Return true on background calibration refined initial rate estimation
+    [[nodiscard]] auto isCalibrated() const noexcept -> bool {
+        return calibrated_.load(std::memory_order_acquire)->load(std::memory_order_acquire);
+    }
+
+    /// Return true on parameters placed into shared page
+    [[nodiscard]] auto isShared() const noexcept -> bool {
+        return static_cast<bool>(sharedPage_);
+    }
+
+    /// Return true on this clock calibrates parameters of shared page
+    [[nodiscard]] auto ownsSharedPage() const noexcept -> bool {
+        return ownsSharedPage_.load(std::memory_order_acquire);
+    }
+
+    /// Current conversion parameters
+    [[nodiscard]] ROCKET_FORCE_INLINE auto params() const noexcept -> TscClockParams {
+        TscClockParams params;
+        if (params_.load(std::memory_order_acquire)->tryLoad(params)) [[likely]] {
+            return params;
+        }
+        return this->paramsSlow();
+    }
+
+    /// Nanoseconds per tick
+    [[nodiscard]] ROCKET_FORCE_INLINE auto nanosecondsPerTick() const noexcept -> double {
+        return params_.load(std::memory_order_acquire)->nanosecondsPerTick.load(std::memory_order_relaxed);
+    }
+
+    /// Convert ticks into wall clock nanoseconds since epoch
+    [[nodiscard]] ROCKET_FORCE_INLINE auto toNanoseconds(std::int64_t value) const noexcept -> std::int64_t {
+        auto const params = this->params();
+        return params.wallClockBase +
+               static_cast<std::int64_t>(static_cast<double>(value - params.ticksBase) * params.nanosecondsPerTick);
+    }
+
+    /// Convert ticks into wall clock time
+    [[nodiscard]] ROCKET_FORCE_INLINE auto toTimeSpec(std::int64_t value) const noexcept -> ::timespec {
+        auto const ns = this->toNanoseconds(value);
+        return ::timespec{.tv_sec = ns / 1000000000l, .tv_nsec = ns % 1000000000l};
+    }
+
+    /// Convert duration into ticks
+    [[nodiscard]] ROCKET_FORCE_INLINE auto toTicks(std::chrono::nanoseconds value) const noexcept -> std::int64_t {
+        return static_cast<std::int64_t>(static_cast<double>(value.count()) / this->nanosecondsPerTick());
+    }
+
+  private:
+    /// Current ticks of global instance
+    [[nodiscard]] static auto nowSlow() noexcept -> std::int64_t;
+
+    /// Map shared page and take ownership on possible
+    /// @return true on parameters already published by another process
+    auto attachSharedPage(std::string const& name) -> bool;
+
+    /// Wait for the writer in the middle of update, fall back to calibration by the process itself on writer died
+    [[nodiscard]] auto paramsSlow() const noexcept -> TscClockParams;
+
+    /// Calibrate initial rate and publish parameters into block
+    void calibrate(TscClockParamsBlock& params, std::atomic<bool>& calibrated) const;
+
+    void run(std::stop_token stopToken);
+};
+
+} // namespace rocket
@@ -0,0 +1,57 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <ctime>
+
+#include <benchmark/benchmark.h>
+
+#include "TscClock.h"
+
+namespace rocket {
+
+static void BM_TscClockNow(::benchmark::State& state) {
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(TscClock::now());
+    }
+}
+
+BENCHMARK(BM_TscClockNow);
+
+static void BM_TscClockToTimeSpec(::benchmark::State& state) {
+    auto const& clock = TscClock::instance();
+    auto const ticks = TscClock::now();
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(clock.toTimeSpec(ticks));
+    }
+}
+
+BENCHMARK(BM_TscClockToTimeSpec);
+
+/// Parameters snapshot while writer (thread #0) publishes parameters continuously
+static void BM_TscClockParamsContended(::benchmark::State& state) {
+    static TscClockParamsBlock block;
+    std::int64_t value = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            block.store(TscClockParams{.ticksBase = ++value, .wallClockBase = value, .nanosecondsPerTick = 0.5});
+        } else {
+            ::benchmark::DoNotOptimize(block.load());
+        }
+    }
+}
+
+BENCHMARK(BM_TscClockParamsContended)->Threads(2)->Threads(4);
+
+template <clockid_t ClockID>
+static void BM_ClockGettime(::benchmark::State& state) {
+    ::timespec ts;
+    for (auto _ : state) {
+        ::clock_gettime(ClockID, &ts);
+        ::benchmark::DoNotOptimize(ts);
+    }
+}
+
+BENCHMARK(BM_ClockGettime<CLOCK_REALTIME>);
+BENCHMARK(BM_ClockGettime<CLOCK_MONOTONIC_RAW>);
+
+} // namespace rocket
@@ -0,0 +1,203 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "MemorySource.h"
+#include "TscClock.h"
+#include "detail/memory.h"
+
+namespace rocket {
+
+[[nodiscard]] auto realtimeNow() noexcept -> std::int64_t {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+TEST_CASE("TscClock: conversion") {
+    auto& clock = TscClock::instance();
+
+    auto const first = TscClock::now();
+    auto const second = TscClock::now();
+    REQUIRE_LE(first, second);
+    REQUIRE_GT(clock.nanosecondsPerTick(), 0.0);
+
+    // Initial estimation is good enough before calibration finished
+    auto const diff = clock.toNanoseconds(TscClock::now()) - realtimeNow();
+    REQUIRE_LT(std::abs(diff), std::chrono::nanoseconds(std::chrono::milliseconds(1)).count());
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!clock.isCalibrated() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(clock.isCalibrated());
+
+    auto const start = TscClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto const elapsed = clock.toNanoseconds(TscClock::now()) - clock.toNanoseconds(start);
+    REQUIRE_GE(elapsed, std::chrono::nanoseconds(std::chrono::milliseconds(50)).count());
+    REQUIRE_LT(elapsed, std::chrono::nanoseconds(std::chrono::milliseconds(150)).count());
+
+    auto const ticks = clock.toTicks(std::chrono::milliseconds(1));
+    REQUIRE_GT(ticks, 0);
+    REQUIRE_LT(std::abs(ticks * clock.nanosecondsPerTick() - 1e6), 1.0);
+}
+
+TEST_CASE("TscClock: destructor stops calibration thread") {
+    // Stop is requested in the middle of the growing refinement intervals
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        auto const clock = std::make_unique<TscClock>();
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    }
+    REQUIRE_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_CASE("TscClockParamsBlock: consistent snapshots") {
+    TscClockParamsBlock block;
+    block.store(TscClockParams{.ticksBase = 0, .wallClockBase = 0, .nanosecondsPerTick = 0.0});
+
+    std::atomic<bool> running{true};
+    std::atomic<std::size_t> torn{0};
+
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            while (running.load(std::memory_order_relaxed)) {
+                auto const params = block.load();
+                if (params.ticksBase != params.wallClockBase ||
+                    static_cast<double>(params.ticksBase) != params.nanosecondsPerTick) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+                // Let the writer progress on machines with a few cores
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (std::int64_t value = 1; value < 1000000; ++value) {
+        block.store(TscClockParams{
+            .ticksBase = value, .wallClockBase = value, .nanosecondsPerTick = static_cast<double>(value)});
+    }
+
+    running.store(false);
+    readers.clear();
+
+    REQUIRE_EQ(torn.load(), 0);
+}
+
+TEST_CASE("TscClockParamsBlock: writer died in the middle of update") {
+    TscClockParamsBlock block;
+    block.store(TscClockParams{.ticksBase = 1, .wallClockBase = 1, .nanosecondsPerTick = 1.0});
+
+    // Sequence left odd
+    block.seq.fetch_add(1);
+    TscClockParams params;
+    REQUIRE_FALSE(block.tryLoad(params));
+
+    REQUIRE(block.isUpdating());
+
+    // The next writer finishes the update, parity is kept
+    block.store(TscClockParams{.ticksBase = 2, .wallClockBase = 2, .nanosecondsPerTick = 1.0});
+    REQUIRE_FALSE(block.isUpdating());
+    REQUIRE(block.tryLoad(params));
+    REQUIRE_EQ(params.ticksBase, 2);
+}
+
+TEST_CASE("TscClock: shared page") {
+    auto const name = fmt::format("rocket-tsc-clock-test-{}", ::getpid());
+    auto const options = TscClockOptions{.sharedPageName = name};
+
+    auto owner = std::make_unique<TscClock>(options);
+    REQUIRE(owner->isShared());
+    REQUIRE(owner->ownsSharedPage());
+
+    // Parameters are taken from the page without calibration
+    auto const reader = std::make_unique<TscClock>(options);
+    REQUIRE(reader->isShared());
+    REQUIRE_FALSE(reader->ownsSharedPage());
+
+    auto const ticks = reader->ticks();
+    REQUIRE_LT(std::abs(reader->toNanoseconds(ticks) - owner->toNanoseconds(ticks)), 1000);
+    REQUIRE_LT(std::abs(reader->toNanoseconds(ticks) - realtimeNow()),
+        std::chrono::nanoseconds(std::chrono::milliseconds(1)).count());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!reader->isCalibrated() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(reader->isCalibrated());
+
+    // Reader takes over calibration once the owner exits
+    owner.reset();
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!reader->ownsSharedPage() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(reader->ownsSharedPage());
+    REQUIRE_LT(std::abs(reader->toNanoseconds(reader->ticks()) - realtimeNow()),
+        std::chrono::nanoseconds(std::chrono::milliseconds(1)).count());
+
+    std::filesystem::remove(DefaultMemorySource().path() / name);
+}
+
+TEST_CASE("TscClock: shared page owner died in the middle of update") {
+    auto const name = fmt::format("rocket-tsc-clock-test-{}", ::getpid());
+    auto const options = TscClockOptions{.sharedPageName = name};
+
+    std::make_unique<TscClock>(options).reset();
+
+    // Page of another process attached to it
+    auto memorySource = DefaultMemorySource();
+    auto result = memorySource.open(name, MemorySource::OpenOnly);
+    REQUIRE(result);
+    auto const storage = rocket::detail::mapShared(std::get<0>(result.value()));
+    auto const page = std::bit_cast<rocket::detail::TscClockSharedPage*>(storage->data());
+    auto const seq = page->params.seq.fetch_add(1) + 1;
+
+    // Attached reader never sees parameters of reinitialized page
+    std::atomic<bool> running{true};
+    std::atomic<bool> zeroed{false};
+    std::jthread reader([&] {
+        while (running.load()) {
+            TscClockParams params;
+            if (page->params.tryLoad(params) && params.wallClockBase == 0) {
+                zeroed.store(true);
+            }
+        }
+    });
+
+    auto const owner = std::make_unique<TscClock>(options);
+    REQUIRE(owner->ownsSharedPage());
+    // Update is finished in place, the page is not reinitialized
+    REQUIRE_GT(page->params.seq.load(), seq);
+    running.store(false);
+    reader.join();
+
+    REQUIRE_FALSE(zeroed.load());
+    REQUIRE(std::equal(rocket::detail::TscClockSharedPage::kTag.begin(),
+        rocket::detail::TscClockSharedPage::kTag.end(), page->tag));
+    REQUIRE_NE(page->ready.load(), 0);
+    REQUIRE_FALSE(page->params.isUpdating());
+    REQUIRE_LT(std::abs(owner->toNanoseconds(owner->ticks()) - realtimeNow()),
+        std::chrono::nanoseconds(std::chrono::milliseconds(1)).count());
+
+    std::filesystem::remove(memorySource.path() / name);
+}
+
+} // namespace rocket
@@ -4,10 +4,102 @@
 #include "memory.h"
 
 #include <sys/mman.h>
+#include <sys/stat.h>
 
+#include <map>
+#include <mutex>
 #include <system_error>
+#include <utility>
 
 namespace rocket::detail {
+namespace {
+
+/// Status of an option, empty on option not requested
+[[nodiscard]] auto optionStatus(bool requested, std::error_code const& ec) noexcept -> std::error_code {
+    return requested ? ec : std::error_code();
+}
+
+/// Process mappings shared by file identity
+/// Mapping keeps inode alive, so identity is not reused while mapping exists
+class SharedMappings {
+  private:
+    using Key = std::pair<dev_t, ino_t>;
+
+    struct Entry {
+        std::weak_ptr<MappedRegion> region;
+        /// Options applied to the mapping so far and their status
+        MappingOptions options;
+        MappingStatus status;
+    };
+
+    std::mutex mutex_;
+    std::map<Key, Entry> entries_;
+
+  public:
+    [[nodiscard]] auto map(File const& file, MappingOptions const& options, MappingStatus& status)
+        -> std::shared_ptr<MappedRegion> {
+        struct stat st;
+        if (::fstat(file.get(), &st) == -1) {
+            throw std::system_error(errno, getPosixErrorCategory(), "fstat(...)");
+        }
+        auto const key = Key{st.st_dev, st.st_ino};
+        auto const fileSize = static_cast<std::size_t>(st.st_size);
+
+        std::lock_guard guard{mutex_};
+        if (auto found = entries_.find(key); found != entries_.end()) {
+            if (auto region = found->second.region.lock(); region && region->size() == fileSize) {
+                status = reuse(found->second, *region, options);
+                return region;
+            }
+        }
+
+        std::erase_if(entries_, [](auto const& entry) {
+            return entry.second.region.expired();
+        });
+
+        auto region = std::make_shared<MappedRegion>(mapFile(file, fileSize, options, status));
+        entries_.insert_or_assign(key, Entry{.region = region, .options = options, .status = status});
+        return region;
+    }
+
+  private:
+    /// Apply options not applied to the mapping yet, return status of the requested options
+    [[nodiscard]] static auto reuse(Entry& entry, MappedRegion& region, MappingOptions const& options)
+        -> MappingStatus {
+        auto const missing = MappingOptions{
+            .populate = options.populate && !entry.options.populate,
+            .lock = options.lock && !entry.options.lock,
+            .hugePages = options.hugePages && !entry.options.hugePages,
+            .dontDump = options.dontDump && !entry.options.dontDump,
+        };
+        auto const applied = region.apply(missing);
+
+        auto& status = entry.status;
+        status.populate = missing.populate ? applied.populate : status.populate;
+        status.lock = missing.lock ? applied.lock : status.lock;
+        status.hugePages = missing.hugePages ? applied.hugePages : status.hugePages;
+        status.dontDump = missing.dontDump ? applied.dontDump : status.dontDump;
+        entry.options.populate = entry.options.populate || options.populate;
+        entry.options.lock = entry.options.lock || options.lock;
+        entry.options.hugePages = entry.options.hugePages || options.hugePages;
+        entry.options.dontDump = entry.options.dontDump || options.dontDump;
+
+        return MappingStatus{
+            .populate = optionStatus(options.populate, status.populate),
+            .lock = optionStatus(options.lock, status.lock),
+            .hugePages = optionStatus(options.hugePages, status.hugePages),
+            .dontDump = optionStatus(options.dontDump, status.dontDump),
+        };
+    }
+};
+
+[[nodiscard]] auto sharedMappings() noexcept -> SharedMappings& {
+    // Never destroyed, mappings could be released during static destruction
+    static auto* mappings = new SharedMappings();
+    return *mappings;
+}
+
+} // namespace
 
 MappedRegion mapFile(File const& file, std::size_t fileSize) {
     auto region = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, file.get(), 0);
@@ -21,4 +113,50 @@ MappedRegion mapFile(File const& file) {
     return mapFile(file, file.getFileSize());
 }
 
+MappedRegion mapFile(File const& file, std::size_t fileSize, MappingOptions const& options, MappingStatus& status) {
+    // Huge pages advice must precede page faults
+    auto const populateOnMap = options.populate && !options.hugePages;
+    auto region = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED | (populateOnMap ? MAP_POPULATE : 0),
+        file.get(), 0);
+    if (region == MAP_FAILED) {
+        throw std::system_error(errno, getPosixErrorCategory(), "mmap(...)");
+    }
+
+    auto result = MappedRegion(static_cast<std::byte*>(region), fileSize);
+    auto rest = options;
+    rest.populate = options.populate && !populateOnMap;
+    status = result.apply(rest);
+    return result;
+}
+
+MappedRegion mapFile(File const& file, MappingOptions const& options, MappingStatus& status) {
+    return mapFile(file, file.getFileSize(), options, status);
+}
+
+MappedRegion mapReadOnly(File const& file, std::size_t size) {
+    auto region = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file.get(), 0);
+    if (region == MAP_FAILED) {
+        throw std::system_error(errno, getPosixErrorCategory(), "mmap(...)");
+    }
+    return MappedRegion(static_cast<std::byte*>(region), size);
+}
+
+std::shared_ptr<MappedRegion> mapShared(File const& file, MappingOptions const& options, MappingStatus& status) {
+    return sharedMappings().map(file, options, status);
+}
+
+std::shared_ptr<MappedRegion> mapShared(File const& file) {
+    MappingStatus status;
+    return mapShared(file, MappingOptions{}, status);
+}
+
+MappedRegion mapAnonymous(std::size_t size, int flags) {
+    auto region =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | flags, -1, 0);
+    if (region == MAP_FAILED) {
+        throw std::system_error(errno, getPosixErrorCategory(), "mmap(...)");
+    }
+    return MappedRegion(static_cast<std::byte*>(region), size);
+}
+
 } // namespace rocket::detail
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "../File.h"
 #include "../MappedRegion.h"
 
@@ -14,4 +16,26 @@ MappedRegion mapFile(File const& file, std::size_t fileSize);
 /// \overload
 MappedRegion mapFile(File const& file);
 
+/// Map file to memory with options
+/// \param[out] status is result of applying each option, failed options don't fail mapping
+MappedRegion mapFile(File const& file, std::size_t fileSize, MappingOptions const& options, MappingStatus& status);
+
+/// \overload
+MappedRegion mapFile(File const& file, MappingOptions const& options, MappingStatus& status);
+
+/// Map beginning of file read-only without prefault, e.g. for sampling queue header
+MappedRegion mapReadOnly(File const& file, std::size_t size);
+
+/// Map whole file to memory or reuse the process mapping of the same file
+/// Mappings are reference counted and shared by all handles of the process while any of them alive, options are
+/// applied by the first mapping and @c status is the result of it
+std::shared_ptr<MappedRegion> mapShared(File const& file, MappingOptions const& options, MappingStatus& status);
+
+/// \overload
+std::shared_ptr<MappedRegion> mapShared(File const& file);
+
+/// Map private anonymous memory (prefaulted), for memory shared by threads of a process only
+/// \param[in] flags are extra mmap flags (e.g. MAP_HUGETLB)
+MappedRegion mapAnonymous(std::size_t size, int flags = 0);
+
 } // namespace rocket::detail
@@ -4,8 +4,13 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
+
+#include "../MemorySource.h"
 
 namespace rocket::logger {
 
@@ -15,6 +20,28 @@ struct BackendOptions {
 
     /// Sleep duration if there is no remaining work to process
     std::chrono::milliseconds sleepDuration = std::chrono::milliseconds{100};
+
+    /// Emit log records from all threads in timestamp order (k-way merge over thread queues)
+    bool timestampOrdered = false;
+
+    /// Reordering window for timestamp ordered mode
+    /// Records younger than the window are held back until the next iteration
+    std::chrono::microseconds reorderWindow = std::chrono::microseconds{50000};
+
+    /// Memory source for thread queues created from now on (see setQueueMemorySource)
+    /// E.g. std::make_shared<AnonymousMemorySource>(HugePagesOption::Auto) keeps queues on huge pages
+    std::shared_ptr<MemorySource const> queueMemorySource = nullptr;
+};
+
+/// Default name of registry for logger queues in shared memory mode
+inline constexpr auto kDefaultSharedRegistryName = "rocket-logger";
+
+struct SharedBackendOptions {
+    /// Registry name at /dev/shm, the collector (rocket-logd) should use the same name
+    std::string registryName = kDefaultSharedRegistryName;
+
+    /// Capacity of the process format dictionary (call sites metadata)
+    std::size_t dictionaryCapacity = 1024 * 1024;
 };
 
 } // namespace rocket::logger
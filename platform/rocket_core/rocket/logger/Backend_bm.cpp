@@ -0,0 +1,72 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Logger.h"
+
+namespace rocket::logger {
+
+/// Sink drops everything
+struct NullSink final : public Sink {
+    void write([[maybe_unused]] std::source_location const& location, [[maybe_unused]] LogLevel level,
+        [[maybe_unused]] ::timespec const& timestamp, [[maybe_unused]] std::thread::id const& threadID,
+        std::string_view message) override {
+        ::benchmark::DoNotOptimize(message.data());
+    }
+};
+
+static void ApplyCustomArgs(::benchmark::internal::Benchmark* b) {
+    b->UseRealTime();
+    b->Unit(::benchmark::kMillisecond);
+    b->ArgName("threads");
+    for (auto const threadsCount : {1, 2, 4, 8}) {
+        b->Arg(threadsCount);
+    }
+}
+
+static constexpr std::size_t kRecordsPerThread = 10000;
+
+/// Measure time spent by backend to drain and format records produced by threads in parallel
+template <bool TimestampOrdered>
+static void BM_BackendDrain(::benchmark::State& state) {
+    auto const threadsCount = std::size_t(state.range(0));
+
+    auto const options = BackendOptions{
+        .sleepDuration = std::chrono::milliseconds(1),
+        .timestampOrdered = TimestampOrdered,
+    };
+
+    setLogLevel(LogLevel::Notice);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            std::vector<std::jthread> threads;
+            for ([[maybe_unused]] auto i : std::views::iota(std::size_t(0), threadsCount)) {
+                threads.emplace_back([] {
+                    for (auto j : std::views::iota(std::size_t(0), kRecordsPerThread)) {
+                        logNoticeF("record #{} value {}", j, 3.1415);
+                    }
+                });
+            }
+        }
+        state.ResumeTiming();
+
+        startBackend(std::make_unique<NullSink>(), options);
+        stopBackend();
+    }
+
+    state.SetItemsProcessed(state.iterations() * threadsCount * kRecordsPerThread);
+}
+
+BENCHMARK(BM_BackendDrain<false>)->Apply(ApplyCustomArgs);
+BENCHMARK(BM_BackendDrain<true>)->Apply(ApplyCustomArgs);
+
+} // namespace rocket::logger
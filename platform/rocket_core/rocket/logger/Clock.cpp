@@ -3,15 +3,18 @@
 
 #include "Clock.h"
 
-#include "detail/TicksHelper.h"
-
 namespace rocket::logger {
 
+void TSCClock::init() noexcept {
+    [[maybe_unused]] auto& clock = TscClock::instance();
+}
+
 auto TSCClock::toTimeSpec(std::int64_t value) noexcept -> ::timespec {
-    static constexpr auto kNanosecondsInSecond =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(1)).count();
-    auto const nsSinceEpoch = detail::TicksHelper::instance()->timeSinceEpoch(value);
-    return ::timespec{.tv_sec = nsSinceEpoch / kNanosecondsInSecond, .tv_nsec = nsSinceEpoch % kNanosecondsInSecond};
+    return TscClock::instance().toTimeSpec(value);
+}
+
+auto TSCClock::toSortKey(std::chrono::nanoseconds value) noexcept -> std::int64_t {
+    return TscClock::instance().toTicks(value);
 }
 
 } // namespace rocket::logger
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 
 #include "../Platform.h"
+#include "../TscClock.h"
 
 namespace rocket::logger {
 
@@ -15,6 +17,9 @@ template <clockid_t ClockID>
 struct LinuxClock {
     using Timestamp = ::timespec;
 
+    /// Prepare clock ahead of the first timestamp
+    static void init() noexcept {}
+
     [[nodiscard]] ROCKET_FORCE_INLINE static auto now() noexcept -> Timestamp {
         timespec ts;
         ::clock_gettime(ClockID, &ts);
@@ -24,16 +29,38 @@ struct LinuxClock {
     [[nodiscard]] static constexpr auto toTimeSpec(::timespec const& value) noexcept -> ::timespec const& {
         return value;
     }
+
+    /// Return value for ordering timestamps
+    [[nodiscard]] static constexpr auto toSortKey(::timespec const& value) noexcept -> std::int64_t {
+        return value.tv_sec * 1000000000l + value.tv_nsec;
+    }
+
+    /// Convert duration into sort key units
+    [[nodiscard]] static constexpr auto toSortKey(std::chrono::nanoseconds value) noexcept -> std::int64_t {
+        return value.count();
+    }
 };
 
+/// Clock for timestamps based on rocket::TscClock
 struct TSCClock {
     using Timestamp = std::int64_t;
 
+    /// Calibrate global TscClock and start its calibration thread ahead of the first timestamp
+    static void init() noexcept;
+
     [[nodiscard]] ROCKET_FORCE_INLINE static auto now() noexcept -> Timestamp {
-        return __builtin_ia32_rdtsc();
+        return TscClock::now();
     }
 
     [[nodiscard]] static auto toTimeSpec(std::int64_t value) noexcept -> ::timespec;
+
+    /// Return value for ordering timestamps
+    [[nodiscard]] static constexpr auto toSortKey(std::int64_t value) noexcept -> std::int64_t {
+        return value;
+    }
+
+    /// Convert duration into sort key units (ticks)
+    [[nodiscard]] static auto toSortKey(std::chrono::nanoseconds value) noexcept -> std::int64_t;
 };
 
 #if defined(ROCKET_LOGGER_TSC_CLOCK)
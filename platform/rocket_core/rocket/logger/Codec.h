@@ -3,19 +3,33 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "../TypeTraits.h"
+#include "../detail/math.h"
 // #include <fugo/sbe/Concepts.h>
 
 namespace rocket::logger {
 
+/// Alternative of transformed std::variant standing for the variant valueless by exception
+struct ValuelessVariant {
+    [[nodiscard]] friend constexpr auto operator==(ValuelessVariant, ValuelessVariant) noexcept -> bool = default;
+};
+
 /// Codec for encoding/decoding a type T
 template <typename T>
 struct Codec {
@@ -61,18 +75,34 @@ struct Codec<T> {
     }
 };
 
+/// Nothing is stored for the placeholder
+template <>
+struct Codec<ValuelessVariant> {
+    static constexpr auto encodedSize(ValuelessVariant const&) noexcept -> std::size_t {
+        return 0;
+    }
+
+    static void encode(std::byte*&, ValuelessVariant const&) noexcept {}
+
+    static auto decode(std::byte const*&) noexcept -> ValuelessVariant {
+        return {};
+    }
+};
+
+/// String longer than std::uint32_t can count is truncated
 template <>
 struct Codec<std::string_view> {
     using SizeCodec = Codec<std::uint32_t>;
 
     static constexpr auto encodedSize(std::string_view const& value) noexcept -> std::size_t {
-        return SizeCodec::encodedSize(value.size()) + value.size();
+        return SizeCodec::encodedSize() + clampedSize(value);
     }
 
     static void encode(std::byte*& dest, std::string_view const& value) noexcept {
-        SizeCodec::encode(dest, value.size());
-        std::memcpy(dest, value.data(), value.size());
-        dest += value.size();
+        auto const count = clampedSize(value);
+        SizeCodec::encode(dest, count);
+        std::memcpy(dest, value.data(), count);
+        dest += count;
     }
 
     static auto decode(std::byte const*& src) noexcept -> std::string_view {
@@ -81,6 +111,156 @@ struct Codec<std::string_view> {
         src += size;
         return value;
     }
+
+  private:
+    [[nodiscard]] static constexpr auto clampedSize(std::string_view const& value) noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(
+            std::min<std::size_t>(value.size(), std::numeric_limits<std::uint32_t>::max()));
+    }
+};
+
+/// Contiguous sequence of trivially copyable values
+///
+/// Values are stored aligned to alignof(T) so decoded span points directly into the buffer,
+/// values beyond std::uint32_t count are truncated
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+struct Codec<std::span<T const>> {
+    using SizeCodec = Codec<std::uint32_t>;
+
+    static constexpr auto encodedSize(std::span<T const> const& value) noexcept -> std::size_t {
+        return SizeCodec::encodedSize() + (alignof(T) - 1) + clampedSize(value) * sizeof(T);
+    }
+
+    static void encode(std::byte*& dest, std::span<T const> const& value) noexcept {
+        auto const count = clampedSize(value);
+        SizeCodec::encode(dest, count);
+        dest = align(dest);
+        std::memcpy(dest, value.data(), count * sizeof(T));
+        dest += count * sizeof(T);
+    }
+
+    static auto decode(std::byte const*& src) noexcept -> std::span<T const> {
+        auto const size = SizeCodec::decode(src);
+        src = align(src);
+        auto value = std::span<T const>{std::bit_cast<T const*>(src), size};
+        src += value.size_bytes();
+        return value;
+    }
+
+  private:
+    [[nodiscard]] static constexpr auto clampedSize(std::span<T const> const& value) noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(
+            std::min<std::size_t>(value.size(), std::numeric_limits<std::uint32_t>::max()));
+    }
+
+    template <typename Ptr>
+    [[nodiscard]] static auto align(Ptr ptr) noexcept -> Ptr {
+        auto const address = std::bit_cast<std::uintptr_t>(ptr);
+        return ptr + (rocket::detail::align_up(address, std::uintptr_t(alignof(T))) - address);
+    }
+};
+
+/// std::optional<T>
+template <typename T>
+struct Codec<std::optional<T>> {
+    using FlagCodec = Codec<bool>;
+
+    static constexpr auto encodedSize(std::optional<T> const& value) noexcept -> std::size_t {
+        return FlagCodec::encodedSize() + (value ? Codec<T>::encodedSize(*value) : 0);
+    }
+
+    static void encode(std::byte*& dest, std::optional<T> const& value) noexcept {
+        FlagCodec::encode(dest, value.has_value());
+        if (value) {
+            Codec<T>::encode(dest, *value);
+        }
+    }
+
+    static auto decode(std::byte const*& src) noexcept -> std::optional<T> {
+        if (FlagCodec::decode(src)) {
+            return {Codec<T>::decode(src)};
+        }
+        return std::nullopt;
+    }
+};
+
+/// std::variant<Ts...>
+/// Variant valueless by exception is encoded as kValuelessIndex only and decoded as ValuelessVariant alternative
+/// (Transform of std::variant appends it), variants without the alternative are decoded default constructed
+template <typename... Ts>
+struct Codec<std::variant<Ts...>> {
+    using IndexCodec = Codec<std::uint8_t>;
+    using ValueT = std::variant<Ts...>;
+
+    /// Index reserved for variant valueless by exception
+    static constexpr std::uint8_t kValuelessIndex = 255;
+
+    static_assert(sizeof...(Ts) < kValuelessIndex, "Too many variant alternatives");
+
+    static constexpr auto encodedSize(ValueT const& value) noexcept -> std::size_t {
+        if (value.valueless_by_exception()) [[unlikely]] {
+            return IndexCodec::encodedSize();
+        }
+        return IndexCodec::encodedSize() + kEncodedSizes[value.index()](value);
+    }
+
+    static void encode(std::byte*& dest, ValueT const& value) noexcept {
+        if (value.valueless_by_exception()) [[unlikely]] {
+            IndexCodec::encode(dest, kValuelessIndex);
+            return;
+        }
+        IndexCodec::encode(dest, static_cast<std::uint8_t>(value.index()));
+        kEncoders[value.index()](dest, value);
+    }
+
+    static auto decode(std::byte const*& src) noexcept -> ValueT {
+        auto const index = IndexCodec::decode(src);
+        if (index == kValuelessIndex) [[unlikely]] {
+            if constexpr ((std::is_same_v<Ts, ValuelessVariant> || ...)) {
+                return ValueT{std::in_place_type<ValuelessVariant>};
+            } else {
+                return ValueT{};
+            }
+        }
+        return kDecoders[index](src);
+    }
+
+  private:
+    // Dispatch by index, std::visit throws on valueless variant
+    using EncodedSizeFn = std::size_t (*)(ValueT const&) noexcept;
+    using EncodeFn = void (*)(std::byte*&, ValueT const&) noexcept;
+    using DecodeFn = ValueT (*)(std::byte const*&) noexcept;
+
+    template <std::size_t I>
+    static auto encodedSizeAlternative(ValueT const& value) noexcept -> std::size_t {
+        using T = std::variant_alternative_t<I, ValueT>;
+        return Codec<T>::encodedSize(*std::get_if<I>(&value));
+    }
+
+    template <std::size_t I>
+    static void encodeAlternative(std::byte*& dest, ValueT const& value) noexcept {
+        using T = std::variant_alternative_t<I, ValueT>;
+        Codec<T>::encode(dest, *std::get_if<I>(&value));
+    }
+
+    template <std::size_t I>
+    static auto decodeAlternative(std::byte const*& src) noexcept -> ValueT {
+        using T = std::variant_alternative_t<I, ValueT>;
+        return ValueT{std::in_place_index<I>, Codec<T>::decode(src)};
+    }
+
+    static constexpr auto kEncodedSizes = []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<EncodedSizeFn, sizeof...(I)>{&encodedSizeAlternative<I>...};
+    }(std::index_sequence_for<Ts...>{});
+
+    static constexpr auto kEncoders = []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<EncodeFn, sizeof...(I)>{&encodeAlternative<I>...};
+    }(std::index_sequence_for<Ts...>{});
+
+    static constexpr auto kDecoders = []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<DecodeFn, sizeof...(I)>{&decodeAlternative<I>...};
+    }(std::index_sequence_for<Ts...>{});
 };
 
 // template <typename T>
@@ -0,0 +1,104 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "Codec.h"
+#include "Transform.h"
+
+namespace {
+
+/// Order book snapshot (large trivially copyable struct)
+struct BookSnapshot {
+    struct Level {
+        double price;
+        std::int64_t quantity;
+    };
+
+    char symbol[16];
+    std::uint64_t sequence;
+    std::array<Level, 10> bids;
+    std::array<Level, 10> asks;
+};
+
+} // namespace
+
+ROCKET_LOGGER_DEFERRED(BookSnapshot);
+
+template <>
+struct fmt::formatter<BookSnapshot> {
+    constexpr auto parse(fmt::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    auto format(BookSnapshot const& value, fmt::format_context& ctx) const {
+        auto out = fmt::format_to(ctx.out(), "{} #{}", value.symbol, value.sequence);
+        for (auto const& level : value.bids) {
+            out = fmt::format_to(out, " {}@{}", level.quantity, level.price);
+        }
+        out = fmt::format_to(out, " |");
+        for (auto const& level : value.asks) {
+            out = fmt::format_to(out, " {}@{}", level.quantity, level.price);
+        }
+        return out;
+    }
+};
+
+namespace rocket::logger {
+
+[[nodiscard]] auto makeBookSnapshot() noexcept -> BookSnapshot {
+    auto value = BookSnapshot{.symbol = "ESZ6", .sequence = 1234567, .bids = {}, .asks = {}};
+    for (std::size_t i = 0; i < value.bids.size(); ++i) {
+        value.bids[i] = {.price = 6123.25 - 0.25 * i, .quantity = std::int64_t(10 + i)};
+        value.asks[i] = {.price = 6123.50 + 0.25 * i, .quantity = std::int64_t(20 + i)};
+    }
+    return value;
+}
+
+/// Producer side cost: copy struct bytes into queue buffer
+static void BM_ProducerDeferred(::benchmark::State& state) {
+    alignas(64) std::array<std::byte, 4096> buffer;
+    auto value = makeBookSnapshot();
+
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(value);
+        auto const& arg = transform(value);
+        std::byte* dest = buffer.data();
+        Codec<std::remove_cvref_t<decltype(arg)>>::encode(dest, arg);
+        ::benchmark::DoNotOptimize(dest);
+        ::benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * sizeof(BookSnapshot));
+}
+
+BENCHMARK(BM_ProducerDeferred);
+
+/// Producer side cost: format struct on the hot thread and copy the string into queue buffer
+static void BM_ProducerEager(::benchmark::State& state) {
+    alignas(64) std::array<std::byte, 4096> buffer;
+    auto value = makeBookSnapshot();
+    fmt::memory_buffer formatBuffer;
+
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(value);
+        formatBuffer.clear();
+        fmt::format_to(std::back_inserter(formatBuffer), "{}", value);
+        auto const arg = std::string_view(formatBuffer.data(), formatBuffer.size());
+        std::byte* dest = buffer.data();
+        Codec<std::string_view>::encode(dest, arg);
+        ::benchmark::DoNotOptimize(dest);
+        ::benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * sizeof(BookSnapshot));
+}
+
+BENCHMARK(BM_ProducerEager);
+
+} // namespace rocket::logger
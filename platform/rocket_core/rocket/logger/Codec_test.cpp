@@ -0,0 +1,147 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+#include "Codec.h"
+#include "Transform.h"
+
+namespace rocket::logger {
+
+/// Encode value into buffer, decode it back and check all bytes consumed
+template <typename T>
+[[nodiscard]] auto roundTrip(T const& value, std::span<std::byte> buffer) -> T {
+    auto const size = Codec<T>::encodedSize(value);
+    REQUIRE(size <= buffer.size());
+
+    std::byte* dest = buffer.data();
+    Codec<T>::encode(dest, value);
+    REQUIRE(dest <= buffer.data() + size);
+
+    std::byte const* src = buffer.data();
+    auto result = Codec<T>::decode(src);
+    REQUIRE_EQ(src, dest);
+    return result;
+}
+
+TEST_CASE("Codec: span") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    auto const values = std::vector<std::uint64_t>{1, 2, 3, 5, 8, 13};
+    auto const value = transform(values);
+    static_assert(std::is_same_v<decltype(value), std::span<std::uint64_t const> const>);
+
+    // Misaligned start
+    auto const result = roundTrip(value, std::span(buffer).subspan(1));
+    REQUIRE(std::ranges::equal(result, values));
+    REQUIRE_EQ(std::bit_cast<std::uintptr_t>(result.data()) % alignof(std::uint64_t), 0);
+
+    auto const empty = roundTrip(std::span<int const>(), std::span(buffer));
+    REQUIRE(empty.empty());
+
+    // Count beyond std::uint32_t is truncated, the span is never dereferenced here
+    auto const huge = std::span<std::uint16_t const>(std::bit_cast<std::uint16_t const*>(buffer.data()),
+        std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1);
+    REQUIRE_EQ(Codec<std::span<std::uint16_t const>>::encodedSize(huge),
+        sizeof(std::uint32_t) + (alignof(std::uint16_t) - 1) +
+            std::size_t(std::numeric_limits<std::uint32_t>::max()) * sizeof(std::uint16_t));
+}
+
+TEST_CASE("Codec: array") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    auto const value = std::array<int, 3>{7, 8, 9};
+    static_assert(std::is_same_v<detail::TransformResult<std::array<int, 3>>, std::array<int, 3>>);
+    REQUIRE_EQ(roundTrip(transform(value), std::span(buffer)), value);
+}
+
+TEST_CASE("Codec: optional") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    auto const string = std::optional<std::string>("hello");
+    auto const value = transform(string);
+    static_assert(std::is_same_v<decltype(value), std::optional<std::string_view> const>);
+    REQUIRE_EQ(roundTrip(value, std::span(buffer)), std::optional<std::string_view>("hello"));
+
+    auto const empty = std::optional<double>();
+    REQUIRE_EQ(Codec<std::optional<double>>::encodedSize(empty), sizeof(bool));
+    REQUIRE_FALSE(roundTrip(empty, std::span(buffer)).has_value());
+}
+
+TEST_CASE("Codec: variant") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    using VariantT = std::variant<int, std::string, double>;
+    using ResultT = std::variant<int, std::string_view, double, ValuelessVariant>;
+    static_assert(std::is_same_v<detail::TransformResult<VariantT>, ResultT>);
+
+    for (auto const& value : {VariantT(42), VariantT("world"), VariantT(2.5)}) {
+        auto const result = roundTrip(transform(value), std::span(buffer));
+        REQUIRE_EQ(result.index(), value.index());
+        REQUIRE_EQ(result, transform(value));
+    }
+}
+
+/// Too large to be emplaced into std::variant through a temporary, so failed emplace leaves variant valueless
+struct Explosive {
+    Explosive() = default;
+    explicit Explosive(bool) {
+        throw std::runtime_error("explosive");
+    }
+    std::array<char, 512> payload;
+};
+
+template <>
+struct DeferredFormat<Explosive> : std::true_type {};
+
+TEST_CASE("Codec: valueless variant") {
+    alignas(8) std::array<std::byte, 1024> buffer;
+
+    auto valueless = std::variant<int, Explosive>(42);
+    REQUIRE_THROWS(valueless.emplace<Explosive>(true));
+    REQUIRE(valueless.valueless_by_exception());
+
+    // Transformed into placeholder alternative
+    auto const value = transform(valueless);
+    REQUIRE(std::holds_alternative<ValuelessVariant>(value));
+    REQUIRE_EQ(Codec<std::remove_cvref_t<decltype(value)>>::encodedSize(value), sizeof(std::uint8_t));
+    REQUIRE(std::holds_alternative<ValuelessVariant>(roundTrip(value, std::span(buffer))));
+
+    // Encoded by reserved index only, decoded default constructed without placeholder alternative
+    using VariantCodec = Codec<std::variant<int, Explosive>>;
+    REQUIRE_EQ(VariantCodec::encodedSize(valueless), sizeof(std::uint8_t));
+    REQUIRE(std::holds_alternative<int>(roundTrip(valueless, std::span(buffer))));
+}
+
+TEST_CASE("Codec: chrono") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    auto const duration = std::chrono::milliseconds(125);
+    REQUIRE_EQ(roundTrip(transform(duration), std::span(buffer)), duration);
+
+    auto const systemNow = std::chrono::system_clock::now();
+    REQUIRE_EQ(roundTrip(transform(systemNow), std::span(buffer)), systemNow);
+
+    auto const steadyNow = std::chrono::steady_clock::now();
+    REQUIRE_EQ(roundTrip(transform(steadyNow), std::span(buffer)), steadyNow.time_since_epoch());
+}
+
+TEST_CASE("Codec: error_code") {
+    alignas(8) std::array<std::byte, 256> buffer;
+
+    auto const value = std::make_error_code(std::errc::no_such_file_or_directory);
+    REQUIRE_EQ(roundTrip(transform(value), std::span(buffer)), value);
+}
+
+} // namespace rocket::logger
@@ -0,0 +1,233 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "Collector.h"
+
+#include <filesystem>
+#include <ranges>
+#include <system_error>
+
+#include <fmt/args.h>
+
+#include "Codec.h"
+
+namespace rocket::logger {
+namespace {
+
+/// Decode arg of type tag @c type and push it into the store
+/// Return false on type tag not supported
+[[nodiscard]] auto decodeArg(
+    ArgType type, std::byte const*& src, fmt::dynamic_format_arg_store<fmt::format_context>& store) -> bool {
+    switch (type) {
+    case ArgType::Bool: store.push_back(Codec<bool>::decode(src)); break;
+    case ArgType::Char: store.push_back(Codec<char>::decode(src)); break;
+    case ArgType::Int8: store.push_back(Codec<std::int8_t>::decode(src)); break;
+    case ArgType::UInt8: store.push_back(Codec<std::uint8_t>::decode(src)); break;
+    case ArgType::Int16: store.push_back(Codec<std::int16_t>::decode(src)); break;
+    case ArgType::UInt16: store.push_back(Codec<std::uint16_t>::decode(src)); break;
+    case ArgType::Int32: store.push_back(Codec<std::int32_t>::decode(src)); break;
+    case ArgType::UInt32: store.push_back(Codec<std::uint32_t>::decode(src)); break;
+    case ArgType::Int64: store.push_back(Codec<std::int64_t>::decode(src)); break;
+    case ArgType::UInt64: store.push_back(Codec<std::uint64_t>::decode(src)); break;
+    case ArgType::Float: store.push_back(Codec<float>::decode(src)); break;
+    case ArgType::Double: store.push_back(Codec<double>::decode(src)); break;
+    case ArgType::String: store.push_back(Codec<std::string_view>::decode(src)); break;
+    default: return false;
+    }
+    return true;
+}
+
+/// Remove file from memory source directory
+void removeFile(DefaultMemorySource const& memorySource, std::string_view name) noexcept {
+    std::error_code ec;
+    std::filesystem::remove(memorySource.path() / name, ec);
+}
+
+} // namespace
+
+Collector::Collector(CollectorOptions const& options, Handler handler)
+    : registryName_{options.registryName}, registry_{registryName_, memorySource_}, handler_{std::move(handler)},
+      attachedSlots_(detail::SharedRegistry::kSlotsCount, false) {}
+
+Collector::~Collector() = default;
+
+auto Collector::poll() -> std::size_t {
+    this->attachQueues();
+
+    std::size_t count = 0;
+
+    for (auto& queue : queues_) {
+        while (queue.consumer.dequeue([&](std::byte const* src) {
+            ++count;
+            this->processEvent(*queue.process, src);
+        })) {}
+    }
+
+    // Release queues closed by producer or left by exited process
+    std::erase_if(queues_, [this](Queue& queue) {
+        if (!queue.consumer.fetch().empty()) {
+            return false;
+        }
+        if (!queue.consumer.isClosed() && detail::isProcessAlive(queue.process->pid)) {
+            return false;
+        }
+        // Records committed right before close
+        if (!queue.consumer.fetch().empty()) {
+            return false;
+        }
+        this->detachQueue(queue);
+        return true;
+    });
+
+    this->releaseProcesses();
+
+    return count;
+}
+
+void Collector::attachQueues() {
+    for (std::size_t index = 0; index < detail::SharedRegistry::kSlotsCount; ++index) {
+        if (attachedSlots_[index]) {
+            continue;
+        }
+
+        auto const pid = registry_.ownerOf(index);
+        if (pid == 0) {
+            continue;
+        }
+
+        if (!registry_.isPublished(index)) {
+            // Producer died between claiming and publishing the slot
+            if (!detail::isProcessAlive(pid)) {
+                registry_.releaseAbandoned(index, pid);
+            }
+            continue;
+        }
+
+        this->attachQueue(index);
+    }
+}
+
+void Collector::attachQueue(std::size_t slotIndex) {
+    auto const& slot = registry_.slots()[slotIndex];
+    auto const queueName = std::string(slot.queueName);
+
+    try {
+        auto& process = processes_[std::make_pair(slot.pid, slot.sessionID)];
+        if (!process) {
+            auto dictionaryName = detail::makeDictionaryName(registryName_, slot.pid, slot.sessionID);
+            auto dictionary = detail::SharedDictionary(dictionaryName, memorySource_);
+            process = std::make_unique<Process>(slot.pid, std::move(dictionaryName), std::move(dictionary));
+        }
+
+        auto queue = BoundedSPSCRawQueue(queueName, memorySource_);
+        queues_.push_back(Queue{
+            .slotIndex = slotIndex,
+            .name = queueName,
+            .process = process.get(),
+            .consumer = queue.createConsumer(),
+        });
+        process->queuesCount += 1;
+        attachedSlots_[slotIndex] = true;
+    } catch (std::exception const& e) {
+        fmt::print(stderr, "rocket: failed to attach logger queue \"{}\": {}\n", queueName, e.what());
+        removeFile(memorySource_, queueName);
+        registry_.release(slotIndex);
+    }
+}
+
+void Collector::detachQueue(Queue& queue) {
+    removeFile(memorySource_, queue.name);
+    registry_.release(queue.slotIndex);
+    attachedSlots_[queue.slotIndex] = false;
+    queue.process->queuesCount -= 1;
+}
+
+void Collector::releaseProcesses() {
+    std::erase_if(processes_, [this](auto const& entry) {
+        auto const& process = entry.second;
+        if (process->queuesCount > 0 || detail::isProcessAlive(process->pid)) {
+            return false;
+        }
+        removeFile(memorySource_, process->dictionaryName);
+        return true;
+    });
+}
+
+void Collector::processEvent(Process& process, std::byte const* src) {
+    auto const event = Codec<RecordHeader>::decode(src);
+    if (event.type != EventType::LogRecord) {
+        return;
+    }
+
+    auto const logRecordHeader = Codec<LogRecordHeader>::decode(src);
+    // Address of RecordMetadata in producer process
+    auto const key = Codec<std::uint64_t>::decode(src);
+
+    auto record = CollectedRecord{
+        .pid = process.pid,
+        .level = LogLevel::Always,
+        .timestamp = Clock::toTimeSpec(logRecordHeader.timestamp),
+        .threadID = logRecordHeader.threadID,
+        .file = {},
+        .line = 0,
+        .message = {},
+    };
+
+    formatBuffer_.clear();
+
+    if (auto const callSite = this->findCallSite(process, key); callSite) {
+        record.level = callSite->level;
+        record.file = callSite->file;
+        record.line = callSite->line;
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        store.reserve(callSite->argTypes.size(), 0);
+
+        bool decoded = true;
+        for (auto const type : callSite->argTypes) {
+            if (!decodeArg(type, src, store)) {
+                decoded = false;
+                break;
+            }
+        }
+
+        if (decoded) {
+            try {
+                fmt::vformat_to(fmt::appender(formatBuffer_), callSite->format, store);
+            } catch (fmt::format_error const& e) {
+                formatBuffer_.clear();
+                fmt::format_to(fmt::appender(formatBuffer_), "<format error: {}> {}", e.what(), callSite->format);
+            }
+        } else {
+            fmt::format_to(fmt::appender(formatBuffer_), "<unsupported args> {}", callSite->format);
+        }
+    } else {
+        fmt::format_to(fmt::appender(formatBuffer_), "<unknown call site {:#x}>", key);
+    }
+
+    auto const lines = std::string_view{formatBuffer_.data(), formatBuffer_.size()};
+
+    constexpr auto kLineDelim = std::string_view{"\n"};
+    for (auto const message : std::views::split(lines, kLineDelim)) {
+        record.message = std::string_view{message};
+        handler_(record);
+    }
+}
+
+auto Collector::findCallSite(Process& process, std::uint64_t key) -> detail::DictionaryEntry const* {
+    if (auto const found = process.callSites.find(key); found != process.callSites.end()) [[likely]] {
+        return &found->second;
+    }
+
+    // Call site exported before the record enqueued, so it must be published by now
+    process.dictionary.forEachNewEntry([&](detail::DictionaryEntry const& entry) {
+        process.callSites.emplace(entry.key, entry);
+    });
+
+    if (auto const found = process.callSites.find(key); found != process.callSites.end()) {
+        return &found->second;
+    }
+    return nullptr;
+}
+
+} // namespace rocket::logger
@@ -0,0 +1,115 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../MemorySource.h"
+#include "BackendOptions.h"
+#include "Common.h"
+#include "detail/LoggerQueue.h"
+#include "detail/SharedDictionary.h"
+#include "detail/SharedRegistry.h"
+
+namespace rocket::logger {
+
+struct CollectorOptions {
+    /// Registry name at /dev/shm (see SharedBackendOptions::registryName)
+    std::string registryName = kDefaultSharedRegistryName;
+};
+
+/// Log record drained from a producer process
+/// Views are valid during handler call only
+struct CollectedRecord {
+    /// Producer process id
+    std::int32_t pid;
+    /// Log entry verbosity level
+    LogLevel level;
+    /// Log record timestamp
+    ::timespec timestamp;
+    /// Log record thread
+    std::thread::id threadID;
+    /// Source file name
+    std::string_view file;
+    /// Source file line
+    std::uint32_t line;
+    /// Formatted message (single line)
+    std::string_view message;
+};
+
+/// Collector drains and formats log records of all processes logging in shared memory mode
+///
+/// Producers (see startSharedBackend) publish thread queues in the registry and export call sites into per-process
+/// format dictionary. Collector discovers queues, decodes args using dictionary type tags and releases queues of
+/// exited threads and processes. Not thread-safe.
+class Collector {
+  public:
+    using Handler = std::function<void(CollectedRecord const&)>;
+
+  private:
+    struct Process {
+        std::int32_t pid;
+        std::string dictionaryName;
+        detail::SharedDictionary dictionary;
+        std::unordered_map<std::uint64_t, detail::DictionaryEntry> callSites;
+        std::size_t queuesCount = 0;
+    };
+
+    struct Queue {
+        std::size_t slotIndex;
+        std::string name;
+        Process* process;
+        detail::LoggerQueue::Consumer consumer;
+    };
+
+    DefaultMemorySource memorySource_;
+    std::string registryName_;
+    detail::SharedRegistry registry_;
+    Handler handler_;
+    // Slots already drained by collector
+    std::vector<bool> attachedSlots_;
+    std::vector<Queue> queues_;
+    std::map<std::pair<std::int32_t, std::uint64_t>, std::unique_ptr<Process>> processes_;
+    fmt::memory_buffer formatBuffer_;
+
+  public:
+    Collector(Collector const&) = delete;
+    Collector& operator=(Collector const&) = delete;
+
+    /// Open or create registry. Throws on error.
+    Collector(CollectorOptions const& options, Handler handler);
+
+    /// Destructor
+    ~Collector();
+
+    /// Discover new queues, drain all records and release queues of exited threads
+    /// @return number of records processed
+    auto poll() -> std::size_t;
+
+    /// Number of attached queues
+    [[nodiscard]] auto queuesCount() const noexcept -> std::size_t {
+        return queues_.size();
+    }
+
+  private:
+    void attachQueues();
+    void attachQueue(std::size_t slotIndex);
+    void detachQueue(Queue& queue);
+    void releaseProcesses();
+    void processEvent(Process& process, std::byte const* src);
+    [[nodiscard]] auto findCallSite(Process& process, std::uint64_t key) -> detail::DictionaryEntry const*;
+};
+
+} // namespace rocket::logger
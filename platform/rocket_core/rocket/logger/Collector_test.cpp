@@ -0,0 +1,104 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <doctest/doctest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Collector.h"
+#include "Logger.h"
+
+namespace rocket::logger {
+
+static_assert(argTypeOf<int>() == ArgType::Int32);
+static_assert(argTypeOf<unsigned long>() == ArgType::UInt64);
+static_assert(argTypeOf<char>() == ArgType::Char);
+static_assert(argTypeOf<std::string_view>() == ArgType::String);
+static_assert(argTypeOf<std::optional<int>>() == ArgType::Unsupported);
+static_assert(detail::kSharedArgs<int, double, std::string_view>);
+static_assert(!detail::kSharedArgs<int, std::optional<int>>);
+
+/// Remove files created for registry
+void removeRegistryFiles(std::string const& registryName) {
+    auto const path = DefaultMemorySource().path();
+    for (auto const& entry : std::filesystem::directory_iterator(path)) {
+        auto const name = entry.path().filename().string();
+        if (name == registryName || name.starts_with(registryName + ".")) {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+
+/// Count files created for registry (except registry itself)
+[[nodiscard]] auto countRegistryFiles(std::string const& registryName) -> std::size_t {
+    auto const path = DefaultMemorySource().path();
+    std::size_t count = 0;
+    for (auto const& entry : std::filesystem::directory_iterator(path)) {
+        count += entry.path().filename().string().starts_with(registryName + ".");
+    }
+    return count;
+}
+
+TEST_CASE("Collector: drain records of another process") {
+    auto const registryName = fmt::format("rocket-logger-test-{}", ::getpid());
+
+    std::vector<CollectedRecord> records;
+    std::vector<std::string> messages;
+    std::vector<std::string> files;
+    auto collector = Collector({.registryName = registryName}, [&](CollectedRecord const& record) {
+        records.push_back(record);
+        messages.emplace_back(record.message);
+        files.emplace_back(record.file);
+    });
+
+    auto const childPid = ::fork();
+    REQUIRE_NE(childPid, -1);
+
+    if (childPid == 0) {
+        startSharedBackend({.registryName = registryName});
+        std::jthread([] {
+            logNoticeF("hello {} #{} {:.2f}", "world", 42, 3.14159);
+            // optional is not supported by collector, formatted at call site
+            logWarningF("{}", std::optional<int>(7));
+            logErrorF("first\nsecond");
+        }).join();
+        std::_Exit(isSharedBackend() ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    int status = 0;
+    REQUIRE_EQ(::waitpid(childPid, &status, 0), childPid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE_EQ(WEXITSTATUS(status), EXIT_SUCCESS);
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (messages.size() < 4 && std::chrono::steady_clock::now() < deadline) {
+        collector.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto const expected = std::vector<std::string>{"hello world #42 3.14", "optional(7)", "first", "second"};
+    REQUIRE_EQ(messages, expected);
+    REQUIRE_EQ(records[0].pid, childPid);
+    REQUIRE_EQ(records[0].level, LogLevel::Notice);
+    REQUIRE_EQ(records[1].level, LogLevel::Warning);
+    REQUIRE(files[0].ends_with("Collector_test.cpp"));
+    REQUIRE_GT(records[0].line, 0);
+
+    // Queue and dictionary of the exited process are released
+    collector.poll();
+    REQUIRE_EQ(collector.queuesCount(), 0);
+    REQUIRE_EQ(countRegistryFiles(registryName), 0);
+
+    removeRegistryFiles(registryName);
+}
+
+} // namespace rocket::logger
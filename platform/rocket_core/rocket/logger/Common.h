@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <source_location>
+#include <span>
 #include <string_view>
 #include <thread>
 #include <type_traits>
 
-#include <fmt/args.h>
+#include <fmt/format.h>
 
 #include "../Platform.h"
 #include "Clock.h"
@@ -18,11 +21,57 @@ namespace rocket::logger {
 /// Log entry verbosity level
 enum class LogLevel { Always, Error, Warning, Notice, Debug, Trace };
 
-/// Decode args function signature
-using DecodeArgsFn = std::add_pointer_t<void(std::byte const*, fmt::dynamic_format_arg_store<fmt::format_context>*)>;
+/// Format log entry function signature
+/// Decodes args from a buffer and appends formatted message to the output buffer
+using FormatFn = std::add_pointer_t<void(fmt::memory_buffer&, std::byte const*)>;
 
-/// Decode args for log entry from a buffer
-using FormatFn = std::add_pointer_t<std::string(std::byte const*)>;
+/// Log record argument type tag
+/// Describes encoded args for decoding outside of the producer process (see Collector)
+enum class ArgType : std::uint8_t {
+    Unsupported,
+    Bool,
+    Char,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double,
+    String
+};
+
+/// Return argument type tag for type T
+template <typename T>
+[[nodiscard]] constexpr auto argTypeOf() noexcept -> ArgType {
+    if constexpr (std::is_same_v<T, bool>) {
+        return ArgType::Bool;
+    } else if constexpr (std::is_same_v<T, char>) {
+        return ArgType::Char;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return ArgType::Float;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return ArgType::Double;
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        return ArgType::String;
+    } else if constexpr (std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> ||
+                         std::is_same_v<T, char32_t>) {
+        return ArgType::Unsupported;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        constexpr auto kTypes = std::array{ArgType::Int8, ArgType::Int16, ArgType::Unsupported, ArgType::Int32,
+            ArgType::Unsupported, ArgType::Unsupported, ArgType::Unsupported, ArgType::Int64};
+        return kTypes[sizeof(T) - 1];
+    } else if constexpr (std::is_integral_v<T>) {
+        constexpr auto kTypes = std::array{ArgType::UInt8, ArgType::UInt16, ArgType::Unsupported, ArgType::UInt32,
+            ArgType::Unsupported, ArgType::Unsupported, ArgType::Unsupported, ArgType::UInt64};
+        return kTypes[sizeof(T) - 1];
+    } else {
+        return ArgType::Unsupported;
+    }
+}
 
 /// Flag indicates a record should never dropped at enqueue side
 constexpr auto kFlagRety = int(1 << 0);
@@ -37,8 +86,10 @@ struct RecordMetadata {
     std::string_view format;
     /// Log entry flags
     int flags;
-    /// Function to decode log entry args from a buffer
-    DecodeArgsFn decodeArgs;
+    /// Function to decode log entry args from a buffer and format message (generated per call site)
+    FormatFn formatMessage;
+    /// Log entry args type tags
+    std::span<ArgType const> argTypes;
 };
 static_assert(std::is_trivially_copyable_v<RecordMetadata>);
 
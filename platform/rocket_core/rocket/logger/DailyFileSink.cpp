@@ -9,17 +9,6 @@
 #include <fmt/format.h>
 
 namespace rocket::logger {
-namespace {
-
-auto calcNextRotateTime(std::time_t now) noexcept -> std::time_t {
-    auto tm = *std::localtime(&now);
-    tm.tm_sec = 0;
-    tm.tm_min = 0;
-    tm.tm_hour = 0;
-    return std::mktime(&tm) + 24 * 60 * 60;
-}
-
-} // namespace
 
 DailyFileSink::DailyFileSink(std::filesystem::path const& destination, std::string prefix)
     : destination_(std::filesystem::canonical(destination)), prefix_(std::move(prefix)) {
@@ -36,7 +25,7 @@ void DailyFileSink::write(std::source_location const& location, LogLevel level,
         if (!this->reopen(now)) {
             return;
         }
-        nextRotateTime_ = calcNextRotateTime(now);
+        nextRotateTime_ = this->calcNextRotateTime(now);
     }
 
     auto const formattedMessage = formatter_(location, level, timestamp, threadID, message);
@@ -51,8 +40,7 @@ void DailyFileSink::flush() {
 
 [[nodiscard]] auto DailyFileSink::reopen(std::time_t now) -> bool {
     // trim now to start of day at localtime
-    ::tm tm;
-    ::localtime_r(&now, &tm);
+    auto tm = timestampCache_.localtime(now);
     tm.tm_sec = 0;
     tm.tm_min = 0;
     tm.tm_hour = 0;
@@ -77,4 +65,12 @@ void DailyFileSink::flush() {
     return true;
 }
 
+auto DailyFileSink::calcNextRotateTime(std::time_t now) noexcept -> std::time_t {
+    auto tm = timestampCache_.localtime(now);
+    tm.tm_sec = 0;
+    tm.tm_min = 0;
+    tm.tm_hour = 0;
+    return std::mktime(&tm) + 24 * 60 * 60;
+}
+
 } // namespace rocket::logger
@@ -16,6 +16,7 @@ class DailyFileSink final : public Sink {
     std::string prefix_;
     FileStream fileStream_;
     PatternFormatter formatter_;
+    detail::TimestampCache timestampCache_;
     std::time_t nextRotateTime_ = 0;
 
   public:
@@ -42,6 +43,7 @@ class DailyFileSink final : public Sink {
 
   private:
     [[nodiscard]] auto reopen(std::time_t now) -> bool;
+    [[nodiscard]] auto calcNextRotateTime(std::time_t now) noexcept -> std::time_t;
 };
 
 } // namespace rocket::logger
@@ -0,0 +1,77 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <tuple>
+
+#include <benchmark/benchmark.h>
+#include <fmt/args.h>
+#include <fmt/compile.h>
+
+#include "Logger.h"
+
+namespace rocket::logger {
+
+/// Call site metadata for benchmark records
+struct FormatMetadata {
+    static constexpr auto format() noexcept -> std::string_view {
+        return "order {} {} {}@{} status={}";
+    }
+};
+
+/// Encode benchmark record args into a buffer
+template <typename... Args>
+[[nodiscard]] auto encodeArgs(std::span<std::byte> buffer, Args const&... args) -> std::byte const* {
+    std::byte* dest = buffer.data();
+    (Codec<Args>::encode(dest, args), ...);
+    return buffer.data();
+}
+
+/// Decode args into type-erased dynamic store and format (previous backend path)
+template <typename M, typename... Args>
+void formatMessageDynamic(fmt::memory_buffer& out, [[maybe_unused]] std::byte const* src) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    (store.push_back(Codec<Args>::decode(src)), ...);
+    fmt::vformat_to(std::back_inserter(out), M::format(), store);
+}
+
+/// Decode args into a tuple and format with format string compiled (ROCKET_LOGGER_COMPILED_FORMAT backend path)
+template <typename M, typename... Args>
+void formatMessageCompiled(fmt::memory_buffer& out, [[maybe_unused]] std::byte const* src) {
+    std::tuple<Args...> const args{Codec<Args>::decode(src)...};
+    std::apply(
+        [&out](auto const&... values) { fmt::format_to(fmt::appender(out), FMT_COMPILE(M::format()), values...); },
+        args);
+}
+
+template <FormatFn Fn>
+static void BM_FormatMessage(::benchmark::State& state) {
+    alignas(64) std::array<std::byte, 256> buffer;
+    auto const src = encodeArgs(std::span(buffer), std::uint64_t(123456789), std::string_view("ESZ6"),
+        std::int64_t(15), 6123.25, std::string_view("filled"));
+    fmt::memory_buffer out;
+
+    for (auto _ : state) {
+        out.clear();
+        Fn(out, src);
+        ::benchmark::DoNotOptimize(out.data());
+        ::benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FormatMessage<formatMessageDynamic<FormatMetadata, std::uint64_t, std::string_view, std::int64_t, double,
+        std::string_view>>)
+    ->Name("BM_FormatMessageDynamicStore");
+BENCHMARK(BM_FormatMessage<detail::formatMessage<FormatMetadata, std::uint64_t, std::string_view, std::int64_t,
+        double, std::string_view>>)
+    ->Name("BM_FormatMessageTuple");
+BENCHMARK(BM_FormatMessage<formatMessageCompiled<FormatMetadata, std::uint64_t, std::string_view, std::int64_t, double,
+        std::string_view>>)
+    ->Name("BM_FormatMessageCompiled");
+
+} // namespace rocket::logger
@@ -3,15 +3,32 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string_view>
+#include <tuple>
 
+#include <fmt/chrono.h>
+#if defined(ROCKET_LOGGER_COMPILED_FORMAT)
+#include <fmt/compile.h>
+#endif
 #include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <fmt/std.h>
 
 #include "Codec.h"
 #include "Macro.h"
 #include "Transform.h"
 #include "detail/Backend.h"
 
+/// Formatted the same way fmt formats valueless std::variant
+template <>
+struct fmt::formatter<rocket::logger::ValuelessVariant> : fmt::formatter<std::string_view> {
+    auto format(rocket::logger::ValuelessVariant, fmt::format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format("valueless by exception", ctx);
+    }
+};
+
 namespace rocket::logger {
 
 [[nodiscard]] ROCKET_FORCE_INLINE auto backend() -> detail::Backend* {
@@ -20,12 +37,49 @@ namespace rocket::logger {
 
 namespace detail {
 
-template <typename... Args>
-constexpr void decodeFormatArgs(
-    [[maybe_unused]] std::byte const* src, [[maybe_unused]] fmt::dynamic_format_arg_store<fmt::format_context>* store) {
-    (store->push_back(Codec<Args>::decode(src)), ...);
+/// Decode args from a buffer into a tuple and format message for call site described by M
+/// Arguments passed to fmt by reference, no type-erased copies made
+template <typename M, typename... Args>
+void formatMessage(fmt::memory_buffer& out, [[maybe_unused]] std::byte const* src) {
+    // braced initialization guarantees left-to-right decode order
+    std::tuple<Args...> const args{Codec<Args>::decode(src)...};
+
+    std::apply(
+        [&out](auto const&... values) {
+#if defined(ROCKET_LOGGER_COMPILED_FORMAT)
+            fmt::format_to(fmt::appender(out), FMT_COMPILE(M::format()), values...);
+#else
+            fmt::vformat_to(std::back_inserter(out), M::format(), fmt::make_format_args(values...));
+#endif
+        },
+        args);
 }
 
+/// Args type tags for a call site
+template <typename... Args>
+inline constexpr std::array<ArgType, sizeof...(Args)> kArgTypes = {argTypeOf<Args>()...};
+
+/// True on args could be decoded by the collector (shared memory mode)
+template <typename... Args>
+inline constexpr bool kSharedArgs = ((argTypeOf<Args>() != ArgType::Unsupported) && ...);
+
+/// Metadata for message formatted at call site
+template <typename M>
+struct PreformattedMetadata {
+    static constexpr auto location() noexcept -> std::source_location const* {
+        return M::location();
+    }
+    static constexpr auto level() noexcept -> LogLevel {
+        return M::level();
+    }
+    static constexpr auto flags() noexcept -> int {
+        return M::flags();
+    }
+    static constexpr auto format() noexcept -> std::string_view {
+        return "{}";
+    }
+};
+
 } // namespace detail
 
 /// Log verbosity level
@@ -73,6 +127,26 @@ ROCKET_FORCE_INLINE void setQueueCapacityHint(std::size_t sizeHint) {
     backend()->setQueueCapacityHint(sizeHint);
 }
 
+/// Queue memory source, empty for in-process anonymous mapping
+[[nodiscard]] ROCKET_FORCE_INLINE auto queueMemorySource() -> std::shared_ptr<MemorySource const> {
+    return backend()->queueMemorySource();
+}
+
+/// Set memory source for new queues (e.g. AnonymousMemorySource with huge pages)
+ROCKET_FORCE_INLINE void setQueueMemorySource(std::shared_ptr<MemorySource const> memorySource) {
+    backend()->setQueueMemorySource(std::move(memorySource));
+}
+
+/// Create queues ahead of time, so the first log call of a thread doesn't map and fault queue memory
+ROCKET_FORCE_INLINE void reserveQueues(std::size_t count) noexcept {
+    backend()->reserveQueues(count);
+}
+
+/// Create queue of the current thread now instead of on the first log call
+ROCKET_FORCE_INLINE void preallocateThreadContext() noexcept {
+    [[maybe_unused]] auto const threadContext = backend()->localThreadContext();
+}
+
 /// Check backend thread running
 ROCKET_FORCE_INLINE auto isBackendReady() noexcept -> bool {
     return backend()->isReady();
@@ -88,6 +162,18 @@ ROCKET_FORCE_INLINE void stopBackend() {
     backend()->stop();
 }
 
+/// Start shared memory mode: queues are published at /dev/shm and drained by the collector (rocket-logd)
+/// Should be called before the first log statement, threads already logging keep in-process queues
+/// Throws on error
+ROCKET_FORCE_INLINE void startSharedBackend(SharedBackendOptions const& options = {}) {
+    backend()->startShared(options);
+}
+
+/// Return true on shared memory mode started
+ROCKET_FORCE_INLINE auto isSharedBackend() noexcept -> bool {
+    return backend()->isShared();
+}
+
 /// Log statement handler
 /// @tparam M is struct with metadata from macro
 /// @param[in] args is arguments for log record
@@ -96,6 +182,16 @@ ROCKET_FORCE_INLINE void logStatement(Args const&... args) {
     // compile time format string check
     [[maybe_unused]] static constexpr auto formatStringCheck = fmt::format_string<Args...>(M::format());
 
+    if constexpr (!detail::kSharedArgs<Args...>) {
+        // Collector can't decode these args, format message at call site
+        if (backend()->isShared()) [[unlikely]] {
+            thread_local fmt::memory_buffer buffer;
+            buffer.clear();
+            fmt::vformat_to(fmt::appender(buffer), M::format(), fmt::make_format_args(args...));
+            return logStatement<detail::PreformattedMetadata<M>>(std::string_view(buffer.data(), buffer.size()));
+        }
+    }
+
     auto const now = Clock::now();
 
     // clang-format off
@@ -104,7 +200,8 @@ ROCKET_FORCE_INLINE void logStatement(Args const&... args) {
       .level = M::level(),
       .format = M::format(),
       .flags = M::flags(),
-      .decodeArgs = detail::decodeFormatArgs<Args...>
+      .formatMessage = detail::formatMessage<M, Args...>,
+      .argTypes = detail::kArgTypes<Args...>
   };
     // clang-format on
 
@@ -117,6 +214,11 @@ ROCKET_FORCE_INLINE void logStatement(Args const&... args) {
 
     auto const threadContext = backend()->localThreadContext();
 
+    if (threadContext->isShared()) [[unlikely]] {
+        // export call site into format dictionary once, before its first record reaches the collector
+        [[maybe_unused]] static bool const metaExported = backend()->exportRecordMetadata(&meta);
+    }
+
     threadContext->producer().enqueue<kEnqueuePolicy>(bufferSize, [&](std::byte* dst) noexcept {
         // RecordHeader
         Codec<RecordHeader>::encode(dst, RecordHeader{.type = EventType::LogRecord});
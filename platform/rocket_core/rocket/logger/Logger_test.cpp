@@ -3,14 +3,67 @@
 
 #include <doctest/doctest.h>
 
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <chrono>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <stdexcept>
 #include <thread>
+#include <variant>
+#include <vector>
 
 #include "DailyFileSink.h"
 #include "Logger.h"
 #include "StdOutSink.h"
 
+namespace {
+
+/// Quote is formatted on the backend thread only
+struct Quote {
+    char symbol[8];
+    double price;
+    std::int64_t quantity;
+};
+
+/// Thread used for formatting Quote
+std::thread::id gQuoteFormatThreadID;
+
+/// Too large to be emplaced into std::variant through a temporary, so failed emplace leaves variant valueless
+struct Explosive {
+    Explosive() = default;
+    explicit Explosive(bool) {
+        throw std::runtime_error("explosive");
+    }
+    std::array<char, 512> payload;
+};
+
+} // namespace
+
+ROCKET_LOGGER_DEFERRED(Quote);
+ROCKET_LOGGER_DEFERRED(Explosive);
+
+template <>
+struct fmt::formatter<Explosive> : fmt::formatter<std::string_view> {
+    auto format(Explosive const&, fmt::format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format("explosive", ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<Quote> {
+    constexpr auto parse(fmt::format_parse_context& ctx) {
+        return ctx.begin();
+    }
+
+    auto format(Quote const& quote, fmt::format_context& ctx) const {
+        gQuoteFormatThreadID = std::this_thread::get_id();
+        return fmt::format_to(ctx.out(), "{} {}@{}", quote.symbol, quote.quantity, quote.price);
+    }
+};
+
 namespace rocket::logger {
 
 TEST_CASE("Logger: ohm") {
@@ -52,4 +105,99 @@ TEST_CASE("Logger: DailyFileSink") {
     rocket::logger::stopBackend();
 }
 
+/// Sink collects messages
+struct CollectSink final : public Sink {
+    std::vector<std::string>& messages;
+
+    explicit CollectSink(std::vector<std::string>& messages) noexcept : messages{messages} {}
+
+    void write([[maybe_unused]] std::source_location const& location, [[maybe_unused]] LogLevel level,
+        [[maybe_unused]] ::timespec const& timestamp, [[maybe_unused]] std::thread::id const& threadID,
+        std::string_view message) override {
+        messages.emplace_back(message);
+    }
+};
+
+TEST_CASE("Logger: timestampOrdered") {
+    REQUIRE_FALSE(rocket::logger::isBackendReady());
+
+    std::vector<std::string> messages;
+
+    // Large window, everything is emitted on backend stop
+    auto const options = BackendOptions{.timestampOrdered = true, .reorderWindow = std::chrono::seconds(60)};
+    rocket::logger::startBackend(std::make_unique<CollectSink>(messages), options);
+    REQUIRE(rocket::logger::isBackendReady());
+
+    constexpr auto kThreadsCount = std::size_t(4);
+    constexpr auto kRecordsCount = std::size_t(500);
+
+    std::mutex mutex;
+    std::size_t seqNo = 0;
+
+    std::vector<std::jthread> threads;
+    for ([[maybe_unused]] auto i : std::views::iota(std::size_t(0), kThreadsCount)) {
+        threads.emplace_back([&] {
+            for ([[maybe_unused]] auto j : std::views::iota(std::size_t(0), kRecordsCount)) {
+                std::lock_guard guard{mutex};
+                logWarningF("{}", seqNo++);
+            }
+        });
+    }
+    threads.clear();
+
+    rocket::logger::stopBackend();
+
+    REQUIRE_EQ(messages.size(), kThreadsCount * kRecordsCount);
+    for (std::size_t index = 0; index < messages.size(); ++index) {
+        std::size_t value = 0;
+        std::from_chars(messages[index].data(), messages[index].data() + messages[index].size(), value);
+        REQUIRE_EQ(value, index);
+    }
+}
+
+TEST_CASE("Logger: extended types") {
+    REQUIRE_FALSE(rocket::logger::isBackendReady());
+
+    std::vector<std::string> messages;
+
+    rocket::logger::startBackend(std::make_unique<CollectSink>(messages));
+    REQUIRE(rocket::logger::isBackendReady());
+
+    auto const vector = std::vector<int>{1, 2, 3};
+    auto const array = std::array<double, 2>{0.5, 1.5};
+    auto const optional = std::optional<std::string>("value");
+    auto const variant = std::variant<int, std::string>("alternative");
+    auto const duration = std::chrono::milliseconds(15);
+
+    auto valueless = std::variant<int, Explosive>(42);
+    REQUIRE_THROWS(valueless.emplace<Explosive>(true));
+    REQUIRE(valueless.valueless_by_exception());
+
+    logWarningF("{} {} {} {} {} {}", vector, array, optional, std::optional<int>(), variant, duration);
+    logWarningF("{}", valueless);
+
+    rocket::logger::stopBackend();
+
+    REQUIRE_EQ(messages.size(), 2);
+    REQUIRE_EQ(messages.front(), R"([1, 2, 3] [0.5, 1.5] optional("value") none variant("alternative") 15ms)");
+    REQUIRE_EQ(messages.back(), "variant(valueless by exception)");
+}
+
+TEST_CASE("Logger: deferred format") {
+    REQUIRE_FALSE(rocket::logger::isBackendReady());
+
+    std::vector<std::string> messages;
+
+    rocket::logger::startBackend(std::make_unique<CollectSink>(messages));
+    REQUIRE(rocket::logger::isBackendReady());
+
+    logWarningF("quote: {}", Quote{.symbol = "ESZ6", .price = 6123.25, .quantity = 15});
+
+    rocket::logger::stopBackend();
+
+    REQUIRE_EQ(messages.size(), 1);
+    REQUIRE_EQ(messages.front(), "quote: ESZ6 15@6123.25");
+    REQUIRE_NE(gQuoteFormatThreadID, std::this_thread::get_id());
+}
+
 } // namespace rocket::logger
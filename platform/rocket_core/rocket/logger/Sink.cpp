@@ -3,33 +3,27 @@
 
 #include "Sink.h"
 
-#include <fmt/chrono.h>
+#include <unistd.h>
+
 #include <fmt/std.h>
 
 namespace rocket::logger {
-namespace {
-
-// Wrapper around localtime_r
-ROCKET_FORCE_INLINE auto localtime(std::time_t time) noexcept -> ::tm {
-    ::tm tm;
-    return *::localtime_r(&time, &tm);
-}
-
-} // namespace
 
 auto PatternFormatter::operator()(std::source_location const& location, LogLevel level, ::timespec const& timestamp,
     std::thread::id const& threadID, std::string_view message) -> std::string_view {
-    // serialize time
-    char buffer[30];
-    auto const result =
-        fmt::format_to_n(buffer, sizeof(buffer), "{:%F %T}.{:09}", localtime(timestamp.tv_sec), timestamp.tv_nsec);
-    auto const timestampStr = std::string_view(buffer, result.size);
+    static std::int32_t const pid = ::getpid();
+    return (*this)(location.file_name(), location.line(), pid, level, timestamp, threadID, message);
+}
+
+auto PatternFormatter::operator()(std::string_view file, std::uint32_t line, std::int32_t pid, LogLevel level,
+    ::timespec const& timestamp, std::thread::id const& threadID, std::string_view message) -> std::string_view {
+    auto const timestampStr = timestampCache_.format(timestamp);
 
     buffer_.clear();
 
     fmt::format_to(std::back_inserter(buffer_), fmt::runtime(pattern_), fmt::arg("timestamp", timestampStr),
         fmt::arg("threadID", threadID), fmt::arg("level", toShortString(level)), fmt::arg("message", message),
-        fmt::arg("file", location.file_name()), fmt::arg("line", location.line()));
+        fmt::arg("file", file), fmt::arg("line", line), fmt::arg("pid", pid));
 
     return std::string_view{buffer_.data(), buffer_.size()};
 }
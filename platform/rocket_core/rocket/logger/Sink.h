@@ -5,10 +5,12 @@
 
 #include <fmt/format.h>
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
 #include "Common.h"
+#include "detail/TimestampCache.h"
 
 namespace rocket::logger {
 
@@ -49,10 +51,12 @@ constexpr auto toShortString(LogLevel level) noexcept -> std::string_view {
 ///   - message - formatted message
 ///   - file - full path to source file
 ///   - line - line at source file
+///   - pid - log source process id
 class PatternFormatter {
   private:
     std::string pattern_ = "{timestamp} [{level}] ({threadID}) {message} ({file}:{line})";
     fmt::memory_buffer buffer_;
+    detail::TimestampCache timestampCache_;
 
   public:
     PatternFormatter() = default;
@@ -71,6 +75,11 @@ class PatternFormatter {
     /// Result valid until next call
     [[nodiscard]] auto operator()(std::source_location const& location, LogLevel level, ::timespec const& timestamp,
         std::thread::id const& threadID, std::string_view message) -> std::string_view;
+
+    /// Format string for a log entry from another process (see Collector)
+    /// Result valid until next call
+    [[nodiscard]] auto operator()(std::string_view file, std::uint32_t line, std::int32_t pid, LogLevel level,
+        ::timespec const& timestamp, std::thread::id const& threadID, std::string_view message) -> std::string_view;
 };
 
 } // namespace rocket::logger
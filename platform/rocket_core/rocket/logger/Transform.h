@@ -3,12 +3,20 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <ctime>
 #include <filesystem>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <string>
+#include <system_error>
 #include <type_traits>
+#include <variant>
 
 #include "../TypeTraits.h"
+#include "Codec.h"
 // #include <fugo/sbe/Concepts.h>
 
 namespace rocket::logger {
@@ -17,6 +25,11 @@ namespace rocket::logger {
 template <typename>
 struct Transform;
 
+/// Opt-in trait for user types logged by copy and formatted on the backend thread
+/// \see ROCKET_LOGGER_DEFERRED
+template <typename T>
+struct DeferredFormat : std::false_type {};
+
 /// Transform type T into loggable type
 template <typename T>
 [[nodiscard]] constexpr decltype(auto) transform(T const& value) {
@@ -37,6 +50,16 @@ struct TransformNone {
     }
 };
 
+/// Type T transformed into
+template <typename T>
+using TransformResult = std::remove_cvref_t<decltype(transform(std::declval<T const&>()))>;
+
+template <typename>
+constexpr bool IsStdArray = false;
+
+template <typename T, std::size_t N>
+constexpr bool IsStdArray<std::array<T, N>> = true;
+
 } // namespace detail
 
 /// All numbers (int, float, etc...)
@@ -87,9 +110,104 @@ struct Transform<T> {
     }
 };
 
+/// std::array of trivially copyable values (copied as is)
+template <typename T>
+    requires(detail::IsStdArray<T> && std::is_trivially_copyable_v<T>)
+struct Transform<T> : detail::TransformNone<T> {};
+
+/// Contiguous ranges of trivially copyable values (std::vector, std::span, etc...)
+template <typename T>
+    requires(std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+             std::is_trivially_copyable_v<std::ranges::range_value_t<T>> && !std::convertible_to<T, std::string_view> &&
+             !detail::IsStdArray<T>)
+struct Transform<T> {
+    using ValueT = std::ranges::range_value_t<T>;
+    [[nodiscard]] constexpr auto operator()(T const& value) const noexcept -> std::span<ValueT const> {
+        return {std::ranges::data(value), std::ranges::size(value)};
+    }
+};
+
+/// std::optional
+template <typename T>
+struct Transform<std::optional<T>> {
+    using ResultT = std::optional<detail::TransformResult<T>>;
+    [[nodiscard]] constexpr auto operator()(std::optional<T> const& value) const -> ResultT {
+        if (value) {
+            return ResultT{transform(*value)};
+        }
+        return std::nullopt;
+    }
+};
+
+/// std::variant
+/// Variant valueless by exception is transformed into the appended ValuelessVariant alternative
+template <typename... Ts>
+struct Transform<std::variant<Ts...>> {
+    using ResultT = std::variant<detail::TransformResult<Ts>..., ValuelessVariant>;
+    [[nodiscard]] constexpr auto operator()(std::variant<Ts...> const& value) const -> ResultT {
+        if (value.valueless_by_exception()) [[unlikely]] {
+            return ResultT{std::in_place_type<ValuelessVariant>};
+        }
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            using TransformFn = ResultT (*)(std::variant<Ts...> const&);
+            constexpr TransformFn kTransforms[] = {[](std::variant<Ts...> const& variant) -> ResultT {
+                return ResultT{std::in_place_index<I>, transform(*std::get_if<I>(&variant))};
+            }...};
+            return kTransforms[value.index()](value);
+        }(std::index_sequence_for<Ts...>{});
+    }
+};
+
+/// std::chrono::duration
+template <typename Rep, typename Period>
+struct Transform<std::chrono::duration<Rep, Period>> : detail::TransformNone<std::chrono::duration<Rep, Period>> {};
+
+/// std::chrono::time_point of system clock
+template <typename Duration>
+struct Transform<std::chrono::time_point<std::chrono::system_clock, Duration>>
+    : detail::TransformNone<std::chrono::time_point<std::chrono::system_clock, Duration>> {};
+
+/// std::chrono::time_point of other clocks (steady_clock, etc...), logged as duration since clock epoch
+template <typename Clock, typename Duration>
+struct Transform<std::chrono::time_point<Clock, Duration>> {
+    [[nodiscard]] constexpr auto operator()(std::chrono::time_point<Clock, Duration> const& value) const noexcept
+        -> Duration {
+        return value.time_since_epoch();
+    }
+};
+
+/// std::error_code (category is a static object, so copy is safe)
+template <>
+struct Transform<std::error_code> : detail::TransformNone<std::error_code> {};
+
+/// User types enabled with ROCKET_LOGGER_DEFERRED(T)
+template <typename T>
+    requires DeferredFormat<T>::value
+struct Transform<T> : detail::TransformNone<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "Deferred format type must be trivially copyable");
+    static_assert(std::is_default_constructible_v<T>, "Deferred format type must be default constructible");
+};
+
 // /// SBE flyweight object
 // template <typename T>
 //   requires fugo::sbe::SBEMessage<T>
 // struct Transform<T> : detail::TransformNone<T> {};
 
 } // namespace rocket::logger
+
+/// Log values of user type T by copying its bytes into the logger queue,
+/// fmt::formatter<T> runs on the backend thread only.
+/// T must be trivially copyable and default constructible.
+/// Should be used at global namespace scope.
+///
+/// Usage example:
+///
+/// struct Order { ... };
+/// ROCKET_LOGGER_DEFERRED(Order);
+/// template <>
+/// struct fmt::formatter<Order> { ... };
+/// ...
+/// logNotice("order: {}", order);
+#define ROCKET_LOGGER_DEFERRED(...)                                                                                    \
+    template <>                                                                                                        \
+    struct rocket::logger::DeferredFormat<__VA_ARGS__> : std::true_type {}
@@ -7,6 +7,7 @@
 #include <array>
 #include <chrono>
 #include <csignal>
+#include <stdexcept>
 #include <string_view>
 #include <thread>
 
@@ -82,6 +83,13 @@ void Backend::start(std::unique_ptr<Sink> sink, BackendOptions const& options) {
         installFailureSignalHandler();
     });
 
+    if (options.queueMemorySource) {
+        loggerQueueManager_.setQueueMemorySource(options.queueMemorySource);
+    }
+
+    // Keep clock calibration off the first log statement
+    Clock::init();
+
     backendThread_.start(std::move(sink), options);
 }
 
@@ -90,4 +98,31 @@ void Backend::stop() {
     backendThread_.stop();
 }
 
+void Backend::startShared(SharedBackendOptions const& options) {
+    std::lock_guard guard{backendThreadMutex_};
+
+    if (sharedBackendStorage_) {
+        throw std::runtime_error("shared memory mode already started");
+    }
+
+    Clock::init();
+
+    sharedBackendStorage_ = std::make_unique<SharedBackend>(options);
+    sharedBackend_.store(sharedBackendStorage_.get(), std::memory_order_release);
+}
+
+auto Backend::exportRecordMetadata(RecordMetadata const* metadata) noexcept -> bool {
+    if (auto const sharedBackend = sharedBackend_.load(std::memory_order_acquire); sharedBackend) {
+        return sharedBackend->exportRecordMetadata(metadata);
+    }
+    return false;
+}
+
+auto Backend::createThreadContext() noexcept -> ThreadContext {
+    if (auto const sharedBackend = sharedBackend_.load(std::memory_order_acquire); sharedBackend) {
+        return ThreadContext{sharedBackend->createProducer(loggerQueueManager_.queueCapacityHint()), true};
+    }
+    return ThreadContext{loggerQueueManager_.createProducer()};
+}
+
 } // namespace rocket::logger::detail
@@ -12,6 +12,7 @@
 #include "../Common.h"
 #include "../Sink.h"
 #include "BackendThread.h"
+#include "SharedBackend.h"
 #include "ThreadContext.h"
 
 namespace rocket::logger::detail {
@@ -23,6 +24,9 @@ class Backend {
     LoggerQueueManager loggerQueueManager_;
     BackendThread backendThread_{loggerQueueManager_};
     std::mutex backendThreadMutex_;
+    // Shared memory mode (nullptr on records processed in-process)
+    std::unique_ptr<SharedBackend> sharedBackendStorage_;
+    std::atomic<SharedBackend*> sharedBackend_{nullptr};
 
   public:
     [[nodiscard]] ROCKET_FORCE_INLINE static auto instance() -> Backend* {
@@ -58,12 +62,36 @@ class Backend {
         loggerQueueManager_.setQueueCapacityHint(value);
     }
 
+    /// Queue memory source, empty for in-process anonymous mapping
+    [[nodiscard]] auto queueMemorySource() const -> std::shared_ptr<MemorySource const> {
+        return loggerQueueManager_.queueMemorySource();
+    }
+
+    /// Change queue memory source (for new queues)
+    void setQueueMemorySource(std::shared_ptr<MemorySource const> value) {
+        loggerQueueManager_.setQueueMemorySource(std::move(value));
+    }
+
+    /// Create queues ahead of time for threads logging for the first time
+    void reserveQueues(std::size_t count) noexcept {
+        loggerQueueManager_.reserveQueues(count);
+    }
+
     /// Get ThreadContext for current thread
     [[nodiscard]] ROCKET_FORCE_INLINE auto localThreadContext() noexcept -> ThreadContext* {
-        static thread_local auto threadContext = ThreadContext{loggerQueueManager_};
+        static thread_local auto threadContext = this->createThreadContext();
         return &threadContext;
     }
 
+    /// Return true on shared memory mode started
+    [[nodiscard]] ROCKET_FORCE_INLINE auto isShared() const noexcept -> bool {
+        return sharedBackend_.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /// Export call site metadata into format dictionary of shared memory mode
+    /// Called once per call site on the first record enqueued into a shared queue
+    auto exportRecordMetadata(RecordMetadata const* metadata) noexcept -> bool;
+
     /// Return true on backend ready to process log records
     [[nodiscard]] ROCKET_FORCE_INLINE auto isReady() const noexcept {
         return backendThread_.isRunning();
@@ -75,8 +103,16 @@ class Backend {
     /// Stop backend thread
     void stop();
 
+    /// Start shared memory mode
+    /// Queues of threads logging for the first time from now on are drained by the collector process
+    /// Throws on error
+    void startShared(SharedBackendOptions const& options);
+
   private:
     Backend() = default;
+
+    /// Create context (queue producer) for a new thread
+    [[nodiscard]] auto createThreadContext() noexcept -> ThreadContext;
 };
 
 } // namespace rocket::logger::detail
@@ -3,6 +3,9 @@
 
 #include "BackendThread.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
 #include <ranges>
 
 #include <fmt/format.h>
@@ -32,17 +35,25 @@ void BackendThread::start(std::unique_ptr<Sink> sink, BackendOptions const& opti
 
         running_.store(true, std::memory_order_seq_cst);
 
+        auto const process = [&](std::chrono::nanoseconds reorderWindow) -> std::size_t {
+            if (options.timestampOrdered) {
+                return this->processIncomingLogRecordsOrdered(*sink, Clock::toSortKey(reorderWindow));
+            }
+            return this->processIncomingLogRecords(*sink);
+        };
+
         auto loopRateLimit = LoopRateLimit{options.sleepDuration};
         while (running_.load(std::memory_order_relaxed)) {
             try {
-                this->processIncomingLogRecords(*sink);
+                process(options.reorderWindow);
             } catch (std::exception const& e) {
                 fmt::print(stderr, "rocket: logger backend thread error: {}\n", e.what());
             }
             loopRateLimit.sleep();
         }
 
-        while (processIncomingLogRecords(*sink) > 0) {}
+        // Drain everything, there is no reason to hold records back on exit
+        while (process(std::chrono::nanoseconds{0}) > 0) {}
     });
 
     thread_.swap(thread);
@@ -74,17 +85,7 @@ auto BackendThread::processIncomingLogRecords(Sink& sink) -> std::size_t {
         while (true) {
             auto const success = consumer->dequeue([&](std::byte const* src) {
                 ++count;
-                auto const event = Codec<RecordHeader>::decode(src);
-
-                switch (event.type) {
-                case EventType::LogRecord: {
-                    auto const logRecordHeader = Codec<LogRecordHeader>::decode(src);
-                    auto const metadata = Codec<RecordMetadata*>::decode(src);
-                    this->processLogRecord(sink, &logRecordHeader, metadata, src);
-                    doFlush = true;
-                } break;
-                default: break;
-                }
+                doFlush = this->processEvent(sink, src) || doFlush;
             });
             if (!success) {
                 break;
@@ -99,19 +100,87 @@ auto BackendThread::processIncomingLogRecords(Sink& sink) -> std::size_t {
     return count;
 }
 
+auto BackendThread::processIncomingLogRecordsOrdered(Sink& sink, std::int64_t reorderWindow) -> std::size_t {
+    // Return sort key of the queue head or std::nullopt on queue is empty
+    auto const peekSortKey = [](LoggerQueue::Consumer* consumer) noexcept -> std::optional<std::int64_t> {
+        auto const buffer = consumer->fetch();
+        if (buffer.empty()) {
+            return std::nullopt;
+        }
+        auto src = buffer.data();
+        if (Codec<RecordHeader>::decode(src).type != EventType::LogRecord) {
+            // Not a log record, emit as soon as possible
+            return std::numeric_limits<std::int64_t>::min();
+        }
+        return Clock::toSortKey(Codec<LogRecordHeader>::decode(src).timestamp);
+    };
+
+    auto const greater = [](MergeEntry const& a, MergeEntry const& b) noexcept {
+        return a.sortKey > b.sortKey;
+    };
+
+    mergeHeap_.clear();
+    queueManager_.forEachConsumer([&](LoggerQueue::Consumer* consumer) {
+        if (auto const sortKey = peekSortKey(consumer); sortKey) {
+            mergeHeap_.push_back(MergeEntry{*sortKey, consumer});
+        }
+    });
+    std::ranges::make_heap(mergeHeap_, greater);
+
+    // Records stamped after the deadline could still have an older record in flight
+    auto const deadline = Clock::toSortKey(Clock::now()) - reorderWindow;
+
+    std::size_t count = 0;
+    auto doFlush = false;
+
+    while (!mergeHeap_.empty() && mergeHeap_.front().sortKey <= deadline) {
+        std::ranges::pop_heap(mergeHeap_, greater);
+        auto const consumer = mergeHeap_.back().consumer;
+        mergeHeap_.pop_back();
+
+        consumer->dequeue([&](std::byte const* src) {
+            ++count;
+            doFlush = this->processEvent(sink, src) || doFlush;
+        });
+
+        if (auto const sortKey = peekSortKey(consumer); sortKey) {
+            mergeHeap_.push_back(MergeEntry{*sortKey, consumer});
+            std::ranges::push_heap(mergeHeap_, greater);
+        }
+    }
+
+    if (doFlush) {
+        sink.flush();
+    }
+
+    return count;
+}
+
+auto BackendThread::processEvent(Sink& sink, std::byte const* src) -> bool {
+    auto const event = Codec<RecordHeader>::decode(src);
+
+    switch (event.type) {
+    case EventType::LogRecord: {
+        auto const logRecordHeader = Codec<LogRecordHeader>::decode(src);
+        auto const metadata = Codec<RecordMetadata*>::decode(src);
+        this->processLogRecord(sink, &logRecordHeader, metadata, src);
+        return true;
+    }
+    default: break;
+    }
+
+    return false;
+}
+
 void BackendThread::processLogRecord(
     Sink& sink, LogRecordHeader const* logRecordHeader, RecordMetadata const* metadata, std::byte const* argsBuffer) {
     assert(logRecordHeader);
     assert(metadata);
     assert(argsBuffer);
 
-    // Decode args for format
-    fmt::dynamic_format_arg_store<fmt::format_context> store;
-    metadata->decodeArgs(argsBuffer, &store);
-
-    formatBuffer_.resize(0);
-    fmt::vformat_to(std::back_inserter(formatBuffer_), metadata->format, store);
-    auto const lines = std::string{formatBuffer_.data(), formatBuffer_.size()};
+    formatBuffer_.clear();
+    metadata->formatMessage(formatBuffer_, argsBuffer);
+    auto const lines = std::string_view{formatBuffer_.data(), formatBuffer_.size()};
 
     constexpr auto kLineDelim = std::string_view{"\n"};
     for (auto const message : std::views::split(lines, kLineDelim)) {
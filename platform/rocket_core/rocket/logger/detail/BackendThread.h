@@ -4,9 +4,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -26,6 +28,14 @@ class BackendThread final {
     // Cache for message formatting
     fmt::memory_buffer formatBuffer_;
 
+    // Queue head for timestamp ordered merge
+    struct MergeEntry {
+        std::int64_t sortKey;
+        LoggerQueue::Consumer* consumer;
+    };
+    // Min-heap over queue heads (timestamp ordered mode)
+    std::vector<MergeEntry> mergeHeap_;
+
   public:
     BackendThread(BackendThread const&) = delete;
     BackendThread& operator=(BackendThread const&) = delete;
@@ -49,6 +59,8 @@ class BackendThread final {
 
   private:
     auto processIncomingLogRecords(Sink& sink) -> std::size_t;
+    auto processIncomingLogRecordsOrdered(Sink& sink, std::int64_t reorderWindow) -> std::size_t;
+    auto processEvent(Sink& sink, std::byte const* src) -> bool;
     void processLogRecord(Sink& sink, LogRecordHeader const* logRecordHeader, RecordMetadata const* metadata,
         std::byte const* argsBuffer);
 };
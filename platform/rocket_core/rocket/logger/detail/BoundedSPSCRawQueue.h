@@ -8,8 +8,10 @@
 #include <bit>
 #include <cassert>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 
 #include "../../File.h"
@@ -98,7 +100,7 @@ class BoundedSPSCRawQueueProducer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::size_t producerPosCache_ = 0;
@@ -118,8 +120,12 @@ class BoundedSPSCRawQueueProducer {
         return *this;
     }
 
-    BoundedSPSCRawQueueProducer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPSCRawQueueProducer(MappedRegion&& storage)
+        : BoundedSPSCRawQueueProducer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPSCRawQueueProducer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error{"invalid queue"};
@@ -141,7 +147,7 @@ class BoundedSPSCRawQueueProducer {
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return true on queue closed
@@ -250,7 +256,7 @@ class BoundedSPSCRawQueueConsumer {
     using MemoryHeader = typename QueueDetail::MemoryHeader;
     using MessageHeader = typename QueueDetail::MessageHeader;
 
-    MappedRegion storage_;
+    std::shared_ptr<MappedRegion> storage_;
     MemoryHeader* header_ = nullptr;
     std::span<std::byte> data_;
     std::size_t consumerPosCache_ = 0;
@@ -270,8 +276,12 @@ class BoundedSPSCRawQueueConsumer {
         return *this;
     }
 
-    BoundedSPSCRawQueueConsumer(MappedRegion&& storage) : storage_(std::move(storage)) {
-        auto content = storage_.content();
+    BoundedSPSCRawQueueConsumer(MappedRegion&& storage)
+        : BoundedSPSCRawQueueConsumer(std::make_shared<MappedRegion>(std::move(storage))) {}
+
+    /// Construct over a region shared with other queue handles of the process
+    explicit BoundedSPSCRawQueueConsumer(std::shared_ptr<MappedRegion> storage) : storage_(std::move(storage)) {
+        auto content = storage_->content();
 
         if (!QueueDetail::check(content)) {
             throw std::runtime_error{"invalid queue"};
@@ -285,7 +295,7 @@ class BoundedSPSCRawQueueConsumer {
 
     /// Return true on initialized
     [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
-        return static_cast<bool>(storage_);
+        return storage_ && static_cast<bool>(*storage_);
     }
 
     /// Return true on queue closed
@@ -298,6 +308,11 @@ class BoundedSPSCRawQueueConsumer {
         std::atomic_ref{header_->closed}.store(true, std::memory_order_release);
     }
 
+    /// Queue memory, shared with other handles of the queue in the process
+    [[nodiscard]] auto storage() const noexcept -> std::shared_ptr<MappedRegion> const& {
+        return storage_;
+    }
+
     /// Get next buffer for reading. Return empty buffer in case of no data.
     [[nodiscard]] ROCKET_FORCE_INLINE auto fetch() noexcept -> std::span<std::byte const> {
         if ((consumerPosCache_ == producerPosCache_ && (producerPosCache_ = std::atomic_ref{header_->producerPos}.load(
@@ -365,6 +380,9 @@ class BoundedSPSCRawQueueImpl {
     using MessageHeader = typename QueueDetail::MessageHeader;
 
     File file_;
+    std::shared_ptr<MappedRegion> storage_;
+    MappingOptions mappingOptions_;
+    MappingStatus mappingStatus_;
 
   public:
     using Producer = detail::BoundedSPSCRawQueueProducer<Traits>;
@@ -388,7 +406,9 @@ class BoundedSPSCRawQueueImpl {
     }
 
     /// Open only queue. Throws on error.
-    BoundedSPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = AnonymousMemorySource()) {
+    BoundedSPSCRawQueueImpl(std::string_view name, MemorySource const& memorySource = AnonymousMemorySource(),
+        MappingOptions const& mappingOptions = {})
+        : mappingOptions_{mappingOptions} {
         auto result = memorySource.open(name, MemorySource::OpenOnly);
         if (!result) {
             throw std::runtime_error{"failed to open memory source"};
@@ -396,14 +416,16 @@ class BoundedSPSCRawQueueImpl {
         std::size_t pageSize;
         std::tie(file_, pageSize) = std::move(result).value();
 
-        if (auto storage = rocket::detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+        storage_ = rocket::detail::mapShared(file_, mappingOptions_, mappingStatus_);
+        if (!QueueDetail::check(storage_->content())) {
             throw std::runtime_error{"failed to open queue (invalid)"};
         }
     }
 
     /// Open or create queue. Throws on error.
     BoundedSPSCRawQueueImpl(std::string_view name, CreationOptions const& options,
-        MemorySource const& memorySource = AnonymousMemorySource()) {
+        MemorySource const& memorySource = AnonymousMemorySource(), MappingOptions const& mappingOptions = {})
+        : mappingOptions_{mappingOptions} {
         auto result = memorySource.open(name, MemorySource::OpenOrCreate);
         if (!result) {
             throw std::runtime_error{"failed to open memory source"};
@@ -420,13 +442,40 @@ class BoundedSPSCRawQueueImpl {
             if (fileSize != capacity) {
                 throw std::runtime_error{"size mismatch"};
             }
-            if (auto storage = rocket::detail::mapFile(file_); !QueueDetail::check(storage.content())) {
+            storage_ = rocket::detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            if (!QueueDetail::check(storage_->content())) {
                 throw std::runtime_error{"failed to open queue (invalid)"};
             }
         } else {
             file_.truncate(capacity);
-            QueueDetail::init(rocket::detail::mapFile(file_, capacity).content());
+            storage_ = rocket::detail::mapShared(file_, mappingOptions_, mappingStatus_);
+            QueueDetail::init(storage_->content());
+        }
+    }
+
+    /// Create producer and consumer of a queue used within the process only. Throws on error.
+    /// Memory is mapped once (private anonymous, prefaulted) and shared by both ends, no file is created.
+    /// \param[in] flags are extra mmap flags (e.g. MAP_HUGETLB), capacity is rounded up to @c pageSize
+    [[nodiscard]] static auto createInProcess(CreationOptions const& options, std::size_t pageSize = 4096,
+        int flags = 0) -> std::tuple<Producer, Consumer> {
+        std::size_t const capacity = rocket::detail::align_up(options.capacityHint, pageSize);
+        if (capacity < QueueDetail::kMinBufferSize) {
+            throw std::runtime_error{"capacity is too small"};
         }
+
+        auto storage = std::make_shared<MappedRegion>(rocket::detail::mapAnonymous(capacity, flags));
+        QueueDetail::init(storage->content());
+        return std::make_tuple(Producer(storage), Consumer(storage));
+    }
+
+    /// Reset memory of a closed and drained in-process queue and create producer and consumer over it.
+    /// Throws on error.
+    [[nodiscard]] static auto recycle(std::shared_ptr<MappedRegion> storage) -> std::tuple<Producer, Consumer> {
+        if (!storage || !QueueDetail::check(storage->content())) {
+            throw std::runtime_error{"invalid queue"};
+        }
+        QueueDetail::init(storage->content());
+        return std::make_tuple(Producer(storage), Consumer(storage));
     }
 
     /// Return true on queue intialized.
@@ -434,12 +483,17 @@ class BoundedSPSCRawQueueImpl {
         return static_cast<bool>(file_);
     }
 
+    /// Result of applying mapping options to the queue mapping
+    [[nodiscard]] auto mappingStatus() const noexcept -> MappingStatus const& {
+        return mappingStatus_;
+    }
+
     /// Create producer for the queue. Throws on error.
     [[nodiscard]] ROCKET_FORCE_INLINE auto createProducer() -> Producer {
         if (!operator bool()) {
             throw std::runtime_error{"queue not initialized"};
         }
-        return Producer(rocket::detail::mapFile(file_));
+        return Producer(storage_);
     }
 
     /// Create consumer for the queue. Throws on error.
@@ -450,13 +504,16 @@ class BoundedSPSCRawQueueImpl {
         if (!file_.tryLock()) {
             throw std::runtime_error{"can't create consumer (already exists?)"};
         }
-        return Consumer(rocket::detail::mapFile(file_));
+        return Consumer(storage_);
     }
 
     /// Swap resources with other queue.
     void swap(BoundedSPSCRawQueueImpl& that) noexcept {
         using std::swap;
         swap(file_, that.file_);
+        swap(storage_, that.storage_);
+        swap(mappingOptions_, that.mappingOptions_);
+        swap(mappingStatus_, that.mappingStatus_);
     }
 
     /// \see BoundedSPSCRawQueueImpl::swap
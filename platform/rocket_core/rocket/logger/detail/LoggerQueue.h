@@ -6,6 +6,7 @@
 #include <immintrin.h>
 
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <tuple>
 
@@ -83,21 +84,68 @@ struct LoggerQueue {
         }
     };
 
+    /// Create producer and consumer of in-process queue (single anonymous mapping, no file)
+    /// @param[in] capacityHint is queue capacity hint
+    /// @return tuple with valid producer and consumer on success
+    [[nodiscard]] static auto createInProcess(std::size_t capacityHint) noexcept -> std::tuple<Producer, Consumer> {
+        try {
+            auto const options = BoundedSPSCRawQueue::CreationOptions{.capacityHint = capacityHint};
+            auto [producer, consumer] = BoundedSPSCRawQueue::createInProcess(options);
+            return std::make_tuple<Producer, Consumer>(std::move(producer), std::move(consumer));
+        } catch (std::exception const& e) {
+            fmt::print(stderr, "failed to create producer and consumer: {}\n", e.what());
+        }
+        return std::make_tuple(Producer(), Consumer());
+    }
+
+    /// Create producer and consumer over memory of a closed and drained queue
+    /// @param[in] storage is queue memory (see Consumer::storage)
+    /// @return tuple with valid producer and consumer on success
+    [[nodiscard]] static auto recycle(std::shared_ptr<MappedRegion> storage) noexcept
+        -> std::tuple<Producer, Consumer> {
+        try {
+            auto [producer, consumer] = BoundedSPSCRawQueue::recycle(std::move(storage));
+            return std::make_tuple<Producer, Consumer>(std::move(producer), std::move(consumer));
+        } catch (std::exception const& e) {
+            fmt::print(stderr, "failed to recycle queue: {}\n", e.what());
+        }
+        return std::make_tuple(Producer(), Consumer());
+    }
+
     /// Create producer and consumer
     /// @param[in] name is queue name
     /// @param[in] capacityHint is queue capacity hint
+    /// @param[in] memorySource is memory source for the queue (a new memory is expected on each open)
     /// @return tuple with valid producer and consumer on success
-    [[nodiscard]] static auto createProducerAndConsumer(std::string_view name, std::size_t capacityHint) noexcept
-        -> std::tuple<Producer, Consumer> {
+    [[nodiscard]] static auto createProducerAndConsumer(std::string_view name, std::size_t capacityHint,
+        MemorySource const& memorySource = AnonymousMemorySource()) noexcept -> std::tuple<Producer, Consumer> {
         try {
             auto const options = BoundedSPSCRawQueue::CreationOptions{.capacityHint = capacityHint};
-            auto queue = BoundedSPSCRawQueue(name, options);
+            auto queue = BoundedSPSCRawQueue(name, options, memorySource);
             return std::make_tuple<Producer, Consumer>(queue.createProducer(), queue.createConsumer());
         } catch (std::exception const& e) {
             fmt::print(stderr, "failed to create producer and consumer: {}\n", e.what());
         }
         return std::make_tuple(Producer(), Consumer());
     }
+
+    /// Create producer for a named queue
+    /// Consumer is expected to be created by another process from the same memory source
+    /// @param[in] name is queue name
+    /// @param[in] capacityHint is queue capacity hint
+    /// @param[in] memorySource is memory source for the queue
+    /// @return valid producer on success
+    [[nodiscard]] static auto createProducer(std::string_view name, std::size_t capacityHint,
+        MemorySource const& memorySource) noexcept -> Producer {
+        try {
+            auto const options = BoundedSPSCRawQueue::CreationOptions{.capacityHint = capacityHint};
+            auto queue = BoundedSPSCRawQueue(name, options, memorySource);
+            return queue.createProducer();
+        } catch (std::exception const& e) {
+            fmt::print(stderr, "failed to create producer: {}\n", e.what());
+        }
+        return Producer();
+    }
 };
 
 } // namespace rocket::logger::detail
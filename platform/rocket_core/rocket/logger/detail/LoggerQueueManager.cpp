@@ -3,16 +3,61 @@
 
 #include "LoggerQueueManager.h"
 
+#include <unistd.h>
+
 #include <mutex>
+#include <tuple>
+#include <utility>
 
 namespace rocket::logger::detail {
 
+auto LoggerQueueManager::queueMemorySource() const -> std::shared_ptr<MemorySource const> {
+    std::lock_guard guard(queueMemorySourceLock_);
+    return queueMemorySource_;
+}
+
+void LoggerQueueManager::setQueueMemorySource(std::shared_ptr<MemorySource const> value) {
+    std::lock_guard guard(queueMemorySourceLock_);
+    queueMemorySource_ = std::move(value);
+}
+
+void LoggerQueueManager::reserveQueues(std::size_t count) noexcept {
+    auto const capacityHint = this->queueCapacityHint();
+
+    std::size_t capacity = poolCapacity_.load(std::memory_order_relaxed);
+    while (capacity < count && !poolCapacity_.compare_exchange_weak(capacity, count, std::memory_order_relaxed)) {}
+
+    while (this->pooledQueuesCount() < count) {
+        auto [producer, consumer] = this->createQueue(capacityHint);
+        if (!producer || !consumer) {
+            return;
+        }
+
+        std::lock_guard guard(poolLock_);
+        try {
+            pool_.push_back(consumer.storage());
+        } catch (...) {
+            return;
+        }
+    }
+}
+
+auto LoggerQueueManager::pooledQueuesCount() const noexcept -> std::size_t {
+    std::lock_guard guard(poolLock_);
+    return pool_.size();
+}
+
 auto LoggerQueueManager::createProducer(std::optional<std::size_t> capacityHint) noexcept -> LoggerQueue::Producer {
     if (!capacityHint) {
         capacityHint = this->queueCapacityHint();
     }
 
-    auto [producer, consumer] = LoggerQueue::createProducerAndConsumer("logger-queue", *capacityHint);
+    auto [producer, consumer] = [&] {
+        if (auto storage = this->takePooledQueue(*capacityHint); storage) {
+            return LoggerQueue::recycle(std::move(storage));
+        }
+        return this->createQueue(*capacityHint);
+    }();
     if (!producer || !consumer) {
         return {};
     }
@@ -26,11 +71,55 @@ auto LoggerQueueManager::createProducer(std::optional<std::size_t> capacityHint)
     return std::move(producer);
 }
 
+auto LoggerQueueManager::createQueue(std::size_t capacityHint) noexcept
+    -> std::tuple<LoggerQueue::Producer, LoggerQueue::Consumer> {
+    if (auto const memorySource = this->queueMemorySource(); memorySource) {
+        auto const name = fmt::format(
+            "rocket-logger-queue-{}-{}", ::getpid(), queuesCreated_.fetch_add(1, std::memory_order_relaxed));
+        // File left by a dead process with the same pid is not reattached
+        std::ignore = memorySource->remove(name);
+        auto result = LoggerQueue::createProducerAndConsumer(name, capacityHint, *memorySource);
+        std::ignore = memorySource->remove(name);
+        if (std::get<0>(result) && std::get<1>(result)) [[likely]] {
+            return result;
+        }
+        fmt::print(stderr, "rocket: fall back to in-process memory for logger queue\n");
+    }
+    return LoggerQueue::createInProcess(capacityHint);
+}
+
+auto LoggerQueueManager::takePooledQueue(std::size_t capacityHint) noexcept -> std::shared_ptr<MappedRegion> {
+    std::lock_guard guard(poolLock_);
+    while (!pool_.empty()) {
+        auto storage = std::move(pool_.back());
+        pool_.pop_back();
+        if (storage->size() >= capacityHint) {
+            return storage;
+        }
+    }
+    return {};
+}
+
+void LoggerQueueManager::recycleQueue(LoggerQueue::Consumer& consumer) noexcept {
+    std::lock_guard guard(poolLock_);
+    if (pool_.size() >= poolCapacity_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    try {
+        pool_.push_back(consumer.storage());
+    } catch (...) {
+    }
+}
+
 void LoggerQueueManager::rebuildQueues() {
-    // Drop closed queues
-    std::erase_if(queues_, [](LoggerQueue::Consumer const& consumer) {
+    // Recycle closed and drained queues
+    std::erase_if(queues_, [this](LoggerQueue::Consumer& consumer) {
         assert(static_cast<bool>(consumer));
-        return consumer.isClosed();
+        if (consumer.isClosed() && consumer.fetch().empty()) {
+            this->recycleQueue(consumer);
+            return true;
+        }
+        return false;
     });
 
     // Add pending queues
@@ -5,10 +5,14 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <ranges>
+#include <tuple>
 #include <vector>
 
+#include "../../MemorySource.h"
 #include "../../SpinLock.h"
 #include "LoggerQueue.h"
 
@@ -17,8 +21,12 @@ namespace rocket::logger::detail {
 /// Default queue capacity hint
 constexpr std::size_t kDefaultCapacityHint = 2 * 1024 * 1024;
 
+/// Default max number of pooled queues
+constexpr std::size_t kDefaultQueuePoolCapacity = 4;
+
 /// Queue manager
-/// Used for queues lifetime
+/// Used for queues lifetime. Queues of exited threads are recycled into a pool of prefaulted queues, which are handed
+/// out to threads logging for the first time.
 class LoggerQueueManager final {
   private:
     std::vector<LoggerQueue::Consumer> queues_;
@@ -27,6 +35,15 @@ class LoggerQueueManager final {
     std::atomic<bool> rebuildQueuesFlag_{false};
     // Capacity for a new queues
     std::atomic<std::size_t> queueCapacityHint_{kDefaultCapacityHint};
+    // Memory source for a new queues (in-process anonymous mapping on empty)
+    std::shared_ptr<MemorySource const> queueMemorySource_;
+    mutable SpinLock queueMemorySourceLock_;
+    // Queues created from the memory source, numbers queue names
+    std::atomic<std::uint64_t> queuesCreated_{0};
+    // Memory of closed (or reserved) queues ready for reuse
+    std::vector<std::shared_ptr<MappedRegion>> pool_;
+    mutable SpinLock poolLock_;
+    std::atomic<std::size_t> poolCapacity_{kDefaultQueuePoolCapacity};
 
   public:
     LoggerQueueManager(LoggerQueueManager const&) = delete;
@@ -47,6 +64,22 @@ class LoggerQueueManager final {
         queueCapacityHint_.store(value, std::memory_order_relaxed);
     }
 
+    /// Memory source for new queues, empty for in-process anonymous mapping
+    [[nodiscard]] auto queueMemorySource() const -> std::shared_ptr<MemorySource const>;
+
+    /// Set a memory source for new queues (e.g. AnonymousMemorySource with huge pages)
+    /// Each queue is opened under a unique name (pid and counter) and removed from the memory source once mapped, so
+    /// file backed sources (DefaultMemorySource) never share a queue between threads or leave it behind. Queues fall
+    /// back to in-process anonymous mapping on the memory source fails.
+    void setQueueMemorySource(std::shared_ptr<MemorySource const> value);
+
+    /// Create queues ahead of time, so the first log call of a thread doesn't pay for mapping and page faults
+    /// Pool capacity is raised to @c count on needed
+    void reserveQueues(std::size_t count) noexcept;
+
+    /// Number of pooled queues
+    [[nodiscard]] auto pooledQueuesCount() const noexcept -> std::size_t;
+
     /// Create producer with default (or requested) capacity hint
     [[nodiscard]] auto createProducer(std::optional<std::size_t> capacityHint = {}) noexcept -> LoggerQueue::Producer;
 
@@ -74,6 +107,16 @@ class LoggerQueueManager final {
     }
 
   private:
+    /// Create a new queue
+    [[nodiscard]] auto createQueue(std::size_t capacityHint) noexcept
+        -> std::tuple<LoggerQueue::Producer, LoggerQueue::Consumer>;
+
+    /// Take pooled queue of at least @c capacityHint size, smaller queues are released
+    [[nodiscard]] auto takePooledQueue(std::size_t capacityHint) noexcept -> std::shared_ptr<MappedRegion>;
+
+    /// Put memory of closed and drained queue into the pool
+    void recycleQueue(LoggerQueue::Consumer& consumer) noexcept;
+
     void rebuildQueues();
 };
 
@@ -3,6 +3,14 @@
 
 #include <doctest/doctest.h>
 
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
 #include "LoggerQueueManager.h"
 
 namespace rocket::logger::detail {
@@ -42,4 +50,147 @@ TEST_CASE("LoggerQueueManager") {
     REQUIRE_EQ(getConsumersCount(queueManager), 0);
 }
 
+/// Anonymous memory source counting opens
+class CountingMemorySource final : public MemorySource {
+  private:
+    AnonymousMemorySource memorySource_;
+    mutable std::atomic<std::size_t> opensCount_{0};
+
+  public:
+    [[nodiscard]] auto opensCount() const noexcept -> std::size_t {
+        return opensCount_.load();
+    }
+
+    [[nodiscard]] auto open(std::string_view name, OpenFlags flags) const noexcept
+        -> std::expected<std::tuple<File, std::size_t>, std::error_code> override {
+        opensCount_.fetch_add(1);
+        return memorySource_.open(name, flags);
+    }
+};
+
+TEST_CASE("LoggerQueueManager: queue memory source") {
+    LoggerQueueManager queueManager;
+    REQUIRE_FALSE(queueManager.queueMemorySource());
+
+    auto const memorySource = std::make_shared<CountingMemorySource>();
+    queueManager.setQueueMemorySource(memorySource);
+    REQUIRE_EQ(queueManager.queueMemorySource(), memorySource);
+
+    auto producer = queueManager.createProducer(1024 * 1024);
+    REQUIRE(producer);
+    REQUIRE_EQ(memorySource->opensCount(), 1);
+
+    // Falls back to in-process memory on memory source fails (base MemorySource::open returns ENOSYS)
+    queueManager.setQueueMemorySource(std::make_shared<MemorySource>());
+    auto fallbackProducer = queueManager.createProducer(1024 * 1024);
+    REQUIRE(fallbackProducer);
+    REQUIRE_EQ(getConsumersCount(queueManager), 2);
+}
+
+TEST_CASE("LoggerQueueManager: file backed memory source") {
+    constexpr std::size_t kMessages = 1000;
+
+    LoggerQueueManager queueManager;
+    auto const memorySource = std::make_shared<DefaultMemorySource>();
+    queueManager.setQueueMemorySource(memorySource);
+
+    // Each thread gets own queue
+    auto const produce = [&](std::byte id) {
+        auto producer = queueManager.createProducer(64 * 1024);
+        REQUIRE(producer);
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            while (!producer.enqueue(16, [&](std::byte* dest) {
+                dest[0] = id;
+            })) {
+                std::this_thread::yield();
+            }
+        }
+        producer.close();
+    };
+
+    std::size_t counts[2] = {0, 0};
+    std::atomic<bool> done{false};
+    std::jthread first([&] {
+        produce(std::byte(1));
+    });
+    std::jthread second([&] {
+        produce(std::byte(2));
+    });
+    std::jthread waiter([&] {
+        first.join();
+        second.join();
+        done.store(true);
+    });
+
+    bool consistent = true;
+    auto const drain = [&] {
+        queueManager.forEachConsumer([&](LoggerQueue::Consumer* const consumer) {
+            std::byte id{0};
+            while (consumer->dequeue([&](std::byte const* src) {
+                id = id == std::byte(0) ? src[0] : id;
+                consistent = consistent && src[0] == id;
+                counts[std::size_t(src[0]) - 1] += 1;
+            })) {}
+        });
+    };
+    while (!done.load()) {
+        drain();
+    }
+    drain();
+    drain();
+
+    REQUIRE(consistent);
+    REQUIRE_EQ(counts[0], kMessages);
+    REQUIRE_EQ(counts[1], kMessages);
+
+    // Queue files are removed once mapped
+    auto const prefix = "rocket-logger-queue-" + std::to_string(::getpid()) + "-";
+    for (auto const& entry : std::filesystem::directory_iterator(memorySource->path())) {
+        REQUIRE_FALSE(entry.path().filename().string().starts_with(prefix));
+    }
+}
+
+TEST_CASE("LoggerQueueManager: queue pool") {
+    LoggerQueueManager queueManager;
+
+    queueManager.reserveQueues(2);
+    REQUIRE_EQ(queueManager.pooledQueuesCount(), 2);
+
+    {
+        auto producer = queueManager.createProducer(64 * 1024);
+        REQUIRE(producer);
+        REQUIRE_EQ(queueManager.pooledQueuesCount(), 1);
+        REQUIRE(producer.enqueue(16, [](std::byte* dest) {
+            dest[0] = std::byte(42);
+        }));
+        producer.close();
+    }
+
+    // Closed queue is recycled once drained
+    std::size_t count = 0;
+    queueManager.forEachConsumer([&](LoggerQueue::Consumer* const consumer) {
+        while (consumer->dequeue([&](std::byte const* src) {
+            REQUIRE_EQ(src[0], std::byte(42));
+            count += 1;
+        })) {}
+    });
+    REQUIRE_EQ(count, 1);
+    REQUIRE_EQ(getConsumersCount(queueManager), 0);
+    REQUIRE_EQ(queueManager.pooledQueuesCount(), 2);
+
+    // Recycled queue is empty and open
+    auto producer = queueManager.createProducer(64 * 1024);
+    REQUIRE(producer);
+    REQUIRE_FALSE(producer.isClosed());
+    queueManager.forEachConsumer([&](LoggerQueue::Consumer* const consumer) {
+        REQUIRE(consumer->fetch().empty());
+    });
+    REQUIRE_EQ(getConsumersCount(queueManager), 1);
+
+    // Pooled queues smaller than requested are released
+    auto largeProducer = queueManager.createProducer(2 * kDefaultCapacityHint);
+    REQUIRE(largeProducer);
+    REQUIRE_EQ(queueManager.pooledQueuesCount(), 0);
+}
+
 } // namespace rocket::logger::detail
@@ -0,0 +1,44 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include "LoggerQueue.h"
+
+namespace rocket::logger::detail {
+
+/// Thread start cost: queue creation and the first record
+/// Queue on memfd: memfd_create, ftruncate, three mmap (check, producer, consumer) and flock
+static void BM_ThreadStartMemFdQueue(::benchmark::State& state) {
+    auto const capacityHint = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto [producer, consumer] = LoggerQueue::createProducerAndConsumer("logger-queue", capacityHint);
+        producer.enqueue(64, [](std::byte* dest) {
+            std::memset(dest, 0, 64);
+        });
+        ::benchmark::DoNotOptimize(consumer.fetch());
+    }
+}
+
+BENCHMARK(BM_ThreadStartMemFdQueue)->Arg(64 * 1024)->Arg(2 * 1024 * 1024);
+
+/// Thread start cost: queue creation and the first record
+/// In-process queue: single anonymous mmap shared by producer and consumer
+static void BM_ThreadStartInProcessQueue(::benchmark::State& state) {
+    auto const capacityHint = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto [producer, consumer] = LoggerQueue::createInProcess(capacityHint);
+        producer.enqueue(64, [](std::byte* dest) {
+            std::memset(dest, 0, 64);
+        });
+        ::benchmark::DoNotOptimize(consumer.fetch());
+    }
+}
+
+BENCHMARK(BM_ThreadStartInProcessQueue)->Arg(64 * 1024)->Arg(2 * 1024 * 1024);
+
+} // namespace rocket::logger::detail
@@ -0,0 +1,63 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "SharedBackend.h"
+
+#include <unistd.h>
+
+#include <bit>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+
+#include <fmt/format.h>
+
+namespace rocket::logger::detail {
+
+SharedBackend::SharedBackend(SharedBackendOptions const& options)
+    : registryName_{options.registryName}, pid_{::getpid()},
+      sessionID_(std::chrono::system_clock::now().time_since_epoch().count()),
+      registry_{registryName_, memorySource_},
+      dictionary_{makeDictionaryName(registryName_, pid_, sessionID_),
+          SharedDictionary::CreationOptions{.capacityHint = options.dictionaryCapacity}, memorySource_} {}
+
+auto SharedBackend::createProducer(std::size_t capacityHint) noexcept -> LoggerQueue::Producer {
+    auto const queueName = fmt::format(
+        "{}.{}.{}.{}", registryName_, pid_, sessionID_, nextQueueNo_.fetch_add(1, std::memory_order_relaxed));
+
+    auto producer = LoggerQueue::createProducer(queueName, capacityHint, memorySource_);
+    if (!producer) {
+        return {};
+    }
+
+    if (!registry_.publish(pid_, sessionID_, queueName)) {
+        fmt::print(stderr, "rocket: failed to publish logger queue \"{}\" (registry is full)\n", queueName);
+        std::error_code ec;
+        std::filesystem::remove(memorySource_.path() / queueName, ec);
+        return {};
+    }
+
+    return producer;
+}
+
+auto SharedBackend::exportRecordMetadata(RecordMetadata const* metadata) noexcept -> bool {
+    auto const entry = DictionaryEntry{
+        .key = std::bit_cast<std::uint64_t>(metadata),
+        .level = metadata->level,
+        .line = metadata->location->line(),
+        .file = metadata->location->file_name(),
+        .format = metadata->format,
+        .argTypes = metadata->argTypes,
+    };
+
+    std::lock_guard guard{dictionaryLock_};
+    if (!dictionary_.append(entry)) [[unlikely]] {
+        fmt::print(stderr, "rocket: failed to export call site {}:{} (format dictionary is full)\n", entry.file,
+            entry.line);
+        return false;
+    }
+    return true;
+}
+
+} // namespace rocket::logger::detail
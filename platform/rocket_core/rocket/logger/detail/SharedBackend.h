@@ -0,0 +1,47 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "../../MemorySource.h"
+#include "../../SpinLock.h"
+#include "../BackendOptions.h"
+#include "../Common.h"
+#include "LoggerQueue.h"
+#include "SharedDictionary.h"
+#include "SharedRegistry.h"
+
+namespace rocket::logger::detail {
+
+/// Producer side of shared memory mode
+/// Thread queues are created at /dev/shm, published in the registry and drained by the collector process
+class SharedBackend final {
+  private:
+    DefaultMemorySource memorySource_;
+    std::string registryName_;
+    std::int32_t pid_;
+    std::uint64_t sessionID_;
+    SharedRegistry registry_;
+    SharedDictionary dictionary_;
+    SpinLock dictionaryLock_;
+    std::atomic<std::uint64_t> nextQueueNo_{0};
+
+  public:
+    SharedBackend(SharedBackend const&) = delete;
+    SharedBackend& operator=(SharedBackend const&) = delete;
+
+    /// Open registry and create format dictionary. Throws on error.
+    explicit SharedBackend(SharedBackendOptions const& options);
+
+    /// Create queue, publish it in the registry and return producer
+    [[nodiscard]] auto createProducer(std::size_t capacityHint) noexcept -> LoggerQueue::Producer;
+
+    /// Export call site metadata into format dictionary
+    auto exportRecordMetadata(RecordMetadata const* metadata) noexcept -> bool;
+};
+
+} // namespace rocket::logger::detail
@@ -0,0 +1,125 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "SharedDictionary.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "../../detail/math.h"
+#include "../../detail/memory.h"
+#include "../Codec.h"
+
+namespace rocket::logger::detail {
+namespace {
+
+/// Offset for the first entry from memory buffer start
+constexpr std::size_t kDataStartPos = sizeof(SharedDictionary::MemoryHeader);
+
+[[nodiscard]] auto check(std::span<std::byte const> buffer) noexcept -> bool {
+    if (buffer.size() < kDataStartPos) {
+        return false;
+    }
+    auto const header = std::bit_cast<SharedDictionary::MemoryHeader const*>(buffer.data());
+    return std::equal(SharedDictionary::kTag.begin(), SharedDictionary::kTag.end(), header->tag);
+}
+
+void init(std::span<std::byte> buffer) noexcept {
+    auto header = std::bit_cast<SharedDictionary::MemoryHeader*>(buffer.data());
+    std::copy(SharedDictionary::kTag.begin(), SharedDictionary::kTag.end(), header->tag);
+    std::atomic_ref{header->size}.store(0, std::memory_order_release);
+}
+
+[[nodiscard]] auto encodedSize(DictionaryEntry const& entry) noexcept -> std::size_t {
+    return Codec<std::uint32_t>::encodedSize() + Codec<std::uint64_t>::encodedSize() +
+           Codec<LogLevel>::encodedSize() + Codec<std::uint32_t>::encodedSize() +
+           Codec<std::string_view>::encodedSize(entry.file) + Codec<std::string_view>::encodedSize(entry.format) +
+           Codec<std::span<ArgType const>>::encodedSize(entry.argTypes);
+}
+
+} // namespace
+
+auto makeDictionaryName(std::string_view registryName, std::int32_t pid, std::uint64_t sessionID) -> std::string {
+    return fmt::format("{}.{}.{}.dictionary", registryName, pid, sessionID);
+}
+
+SharedDictionary::SharedDictionary(std::string_view name, MemorySource const& memorySource) {
+    auto result = memorySource.open(name, MemorySource::OpenOnly);
+    if (!result) {
+        throw std::runtime_error{"failed to open memory source"};
+    }
+    File file;
+    std::size_t pageSize;
+    std::tie(file, pageSize) = std::move(result).value();
+
+    storage_ = rocket::detail::mapFile(file);
+    if (!check(storage_.content())) {
+        throw std::runtime_error{"failed to open dictionary (invalid)"};
+    }
+
+    header_ = std::bit_cast<MemoryHeader*>(storage_.data());
+    data_ = storage_.content().subspan(kDataStartPos);
+}
+
+SharedDictionary::SharedDictionary(
+    std::string_view name, CreationOptions const& options, MemorySource const& memorySource) {
+    auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+    if (!result) {
+        throw std::runtime_error{"failed to open memory source"};
+    }
+    File file;
+    std::size_t pageSize;
+    std::tie(file, pageSize) = std::move(result).value();
+
+    if (file.getFileSize() != 0) {
+        throw std::runtime_error{"dictionary already exists"};
+    }
+
+    std::size_t const capacity = rocket::detail::align_up(kDataStartPos + options.capacityHint, pageSize);
+    file.truncate(capacity);
+    storage_ = rocket::detail::mapFile(file, capacity);
+    init(storage_.content());
+
+    header_ = std::bit_cast<MemoryHeader*>(storage_.data());
+    data_ = storage_.content().subspan(kDataStartPos);
+}
+
+auto SharedDictionary::append(DictionaryEntry const& entry) noexcept -> bool {
+    auto const pos = std::atomic_ref{header_->size}.load(std::memory_order_relaxed);
+    auto const size = encodedSize(entry);
+    if (size > data_.size() - pos) {
+        return false;
+    }
+
+    std::byte* dest = data_.data() + pos;
+    Codec<std::uint32_t>::encode(dest, std::uint32_t(size));
+    Codec<std::uint64_t>::encode(dest, entry.key);
+    Codec<LogLevel>::encode(dest, entry.level);
+    Codec<std::uint32_t>::encode(dest, entry.line);
+    Codec<std::string_view>::encode(dest, entry.file);
+    Codec<std::string_view>::encode(dest, entry.format);
+    Codec<std::span<ArgType const>>::encode(dest, entry.argTypes);
+
+    std::atomic_ref{header_->size}.store(pos + size, std::memory_order_release);
+    return true;
+}
+
+auto SharedDictionary::readEntry(std::size_t& pos) const noexcept -> DictionaryEntry {
+    std::byte const* src = data_.data() + pos;
+    pos += Codec<std::uint32_t>::decode(src);
+
+    DictionaryEntry entry;
+    entry.key = Codec<std::uint64_t>::decode(src);
+    entry.level = Codec<LogLevel>::decode(src);
+    entry.line = Codec<std::uint32_t>::decode(src);
+    entry.file = Codec<std::string_view>::decode(src);
+    entry.format = Codec<std::string_view>::decode(src);
+    entry.argTypes = Codec<std::span<ArgType const>>::decode(src);
+    return entry;
+}
+
+} // namespace rocket::logger::detail
@@ -0,0 +1,117 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../../MappedRegion.h"
+#include "../../MemorySource.h"
+#include "../../Platform.h"
+#include "../Common.h"
+
+namespace rocket::logger::detail {
+
+/// Call site metadata exported to the collector
+/// Replaces RecordMetadata pointer which is meaningless outside of the producer process
+struct DictionaryEntry {
+    /// Call site key (address of RecordMetadata in producer process)
+    std::uint64_t key;
+    /// Log entry verbosity level
+    LogLevel level;
+    /// Source file line
+    std::uint32_t line;
+    /// Source file name
+    std::string_view file;
+    /// Format string
+    std::string_view format;
+    /// Log entry args type tags
+    std::span<ArgType const> argTypes;
+};
+
+/// Return dictionary name for the producer process session
+[[nodiscard]] auto makeDictionaryName(std::string_view registryName, std::int32_t pid, std::uint64_t sessionID)
+    -> std::string;
+
+/// Append-only dictionary of call sites of the producer process
+///
+/// Dictionary layout:
+/// +--------------+----------------+---------+----------------+---------+-----
+/// | MemoryHeader | std::uint32_t  | Entry   | std::uint32_t  | Entry   | ...
+/// +--------------+----------------+---------+----------------+---------+-----
+///
+/// Entries are published by advancing MemoryHeader::size, so the collector reads entries without locking.
+/// Single writer (producer process), single reader (collector).
+class SharedDictionary {
+  public:
+    /// Dictionary tag
+    static constexpr std::string_view kTag = "rocket/logger-dictionary";
+
+    /// Control struct for dictionary
+    struct MemoryHeader {
+        /// Placeholder for dictionary tag
+        char tag[kTag.size()];
+        /// Number of bytes with published entries
+        alignas(kHardwareDestructiveInterferenceSize) std::size_t size;
+
+        static_assert(std::atomic_ref<std::size_t>::is_always_lock_free);
+    };
+    static_assert(std::is_trivially_copyable_v<MemoryHeader>);
+
+    struct CreationOptions {
+        std::size_t capacityHint;
+    };
+
+  private:
+    MappedRegion storage_;
+    MemoryHeader* header_ = nullptr;
+    std::span<std::byte> data_;
+    // Position of the next entry to read
+    std::size_t readPos_ = 0;
+
+  public:
+    SharedDictionary(SharedDictionary const&) = delete;
+    SharedDictionary& operator=(SharedDictionary const&) = delete;
+    SharedDictionary() = default;
+    SharedDictionary(SharedDictionary&&) = default;
+    SharedDictionary& operator=(SharedDictionary&&) = default;
+
+    /// Open only dictionary. Throws on error.
+    SharedDictionary(std::string_view name, MemorySource const& memorySource);
+
+    /// Create dictionary. Throws on error.
+    SharedDictionary(std::string_view name, CreationOptions const& options, MemorySource const& memorySource);
+
+    /// Return true on dictionary initialized
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return static_cast<bool>(storage_);
+    }
+
+    /// Append entry and make it visible for the reader
+    /// @return false on there is no space left
+    auto append(DictionaryEntry const& entry) noexcept -> bool;
+
+    /// Invoke @c fn for each entry published since the last call
+    /// Entry views are valid until dictionary destroyed
+    template <typename Fn>
+        requires std::invocable<Fn, DictionaryEntry const&>
+    void forEachNewEntry(Fn&& fn) {
+        auto const size = std::atomic_ref{header_->size}.load(std::memory_order_acquire);
+        while (readPos_ < size) {
+            auto const entry = readEntry(readPos_);
+            std::invoke(fn, entry);
+        }
+    }
+
+  private:
+    [[nodiscard]] auto readEntry(std::size_t& pos) const noexcept -> DictionaryEntry;
+};
+
+} // namespace rocket::logger::detail
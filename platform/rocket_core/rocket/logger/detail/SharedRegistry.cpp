@@ -0,0 +1,123 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "SharedRegistry.h"
+
+#include <signal.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+#include "../../detail/math.h"
+#include "../../detail/memory.h"
+
+namespace rocket::logger::detail {
+namespace {
+
+/// Offset for the first slot from memory buffer start
+constexpr std::size_t kSlotsStartPos =
+    rocket::detail::align_up(sizeof(SharedRegistry::MemoryHeader), alignof(SharedRegistry::Slot));
+
+/// Registry size
+constexpr std::size_t kRegistrySize = kSlotsStartPos + SharedRegistry::kSlotsCount * sizeof(SharedRegistry::Slot);
+
+[[nodiscard]] auto check(std::span<std::byte const> buffer) noexcept -> bool {
+    if (buffer.size() < kRegistrySize) {
+        return false;
+    }
+    auto const header = std::bit_cast<SharedRegistry::MemoryHeader const*>(buffer.data());
+    if (!std::equal(SharedRegistry::kTag.begin(), SharedRegistry::kTag.end(), header->tag)) {
+        return false;
+    }
+    return header->slotsCount == SharedRegistry::kSlotsCount;
+}
+
+void init(std::span<std::byte> buffer) noexcept {
+    std::ranges::fill(buffer, std::byte(0));
+    auto header = std::bit_cast<SharedRegistry::MemoryHeader*>(buffer.data());
+    std::copy(SharedRegistry::kTag.begin(), SharedRegistry::kTag.end(), header->tag);
+    header->slotsCount = SharedRegistry::kSlotsCount;
+}
+
+} // namespace
+
+SharedRegistry::SharedRegistry(std::string_view name, MemorySource const& memorySource) {
+    auto result = memorySource.open(name, MemorySource::OpenOrCreate);
+    if (!result) {
+        throw std::runtime_error{"failed to open memory source"};
+    }
+
+    File file;
+    std::size_t pageSize;
+    std::tie(file, pageSize) = std::move(result).value();
+
+    std::size_t const capacity = rocket::detail::align_up(kRegistrySize, pageSize);
+
+    // Producers and collector could race on registry creation
+    std::lock_guard guard{file};
+
+    if (auto const fileSize = file.getFileSize(); fileSize != 0) {
+        if (fileSize != capacity) {
+            throw std::runtime_error{"size mismatch"};
+        }
+        storage_ = rocket::detail::mapFile(file);
+        if (!check(storage_.content())) {
+            throw std::runtime_error{"failed to open registry (invalid)"};
+        }
+    } else {
+        file.truncate(capacity);
+        storage_ = rocket::detail::mapFile(file, capacity);
+        init(storage_.content());
+    }
+
+    slots_ = std::span(std::bit_cast<Slot*>(storage_.data() + kSlotsStartPos), kSlotsCount);
+}
+
+auto SharedRegistry::publish(std::int32_t pid, std::uint64_t sessionID, std::string_view queueName) noexcept
+    -> std::optional<std::size_t> {
+    if (queueName.size() >= kMaxNameSize) [[unlikely]] {
+        return std::nullopt;
+    }
+
+    for (std::size_t index = 0; index < slots_.size(); ++index) {
+        auto& slot = slots_[index];
+
+        auto expected = std::int32_t(0);
+        if (!std::atomic_ref{slot.pid}.compare_exchange_strong(expected, pid, std::memory_order_acquire)) {
+            continue;
+        }
+
+        slot.sessionID = sessionID;
+        auto const last = std::copy(queueName.begin(), queueName.end(), slot.queueName);
+        *last = '\0';
+        std::atomic_ref{slot.ready}.store(1, std::memory_order_release);
+
+        return index;
+    }
+
+    return std::nullopt;
+}
+
+void SharedRegistry::release(std::size_t index) noexcept {
+    auto& slot = slots_[index];
+    std::atomic_ref{slot.ready}.store(0, std::memory_order_relaxed);
+    std::atomic_ref{slot.pid}.store(0, std::memory_order_release);
+}
+
+auto SharedRegistry::releaseAbandoned(std::size_t index, std::int32_t pid) noexcept -> bool {
+    auto& slot = slots_[index];
+    if (std::atomic_ref{slot.ready}.load(std::memory_order_acquire) != 0) {
+        return false;
+    }
+    return std::atomic_ref{slot.pid}.compare_exchange_strong(pid, 0, std::memory_order_release);
+}
+
+auto isProcessAlive(std::int32_t pid) noexcept -> bool {
+    return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
+} // namespace rocket::logger::detail
@@ -0,0 +1,113 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "../../File.h"
+#include "../../MappedRegion.h"
+#include "../../MemorySource.h"
+#include "../../Platform.h"
+
+namespace rocket::logger::detail {
+
+/// Registry of logger queues shared between producer processes and the collector
+///
+/// Registry layout:
+/// +----------------+---------+---------+-----+-----------------------+
+/// | MemoryHeader   | Slot[0] | Slot[1] | ... | Slot[kSlotsCount - 1] |
+/// +----------------+---------+---------+-----+-----------------------+
+///
+/// Slot lifecycle:
+///   free (pid == 0) -> claimed by producer (pid != 0) -> published (ready != 0) -> released by collector
+class SharedRegistry {
+  public:
+    /// Registry tag
+    static constexpr std::string_view kTag = "rocket/logger-registry";
+    /// Number of slots (max number of queues across all processes)
+    static constexpr std::size_t kSlotsCount = 1024;
+    /// Max queue name size (including trailing zero)
+    static constexpr std::size_t kMaxNameSize = 96;
+
+    /// Control struct for registry
+    struct MemoryHeader {
+        /// Placeholder for registry tag
+        char tag[kTag.size()];
+        /// Number of slots
+        std::uint32_t slotsCount;
+    };
+    static_assert(std::is_trivially_copyable_v<MemoryHeader>);
+
+    /// Registered queue
+    struct Slot {
+        /// Owner process id, zero on slot is free
+        alignas(kHardwareDestructiveInterferenceSize) std::int32_t pid;
+        /// Non-zero on slot content published
+        std::uint32_t ready;
+        /// Owner process session (tells apart processes with reused pid)
+        std::uint64_t sessionID;
+        /// Queue name at memory source
+        char queueName[kMaxNameSize];
+
+        static_assert(std::atomic_ref<std::int32_t>::is_always_lock_free);
+        static_assert(std::atomic_ref<std::uint32_t>::is_always_lock_free);
+    };
+    static_assert(std::is_trivially_copyable_v<Slot>);
+
+  private:
+    MappedRegion storage_;
+    std::span<Slot> slots_;
+
+  public:
+    SharedRegistry(SharedRegistry const&) = delete;
+    SharedRegistry& operator=(SharedRegistry const&) = delete;
+    SharedRegistry() = default;
+    SharedRegistry(SharedRegistry&&) = default;
+    SharedRegistry& operator=(SharedRegistry&&) = default;
+
+    /// Open or create registry. Throws on error.
+    SharedRegistry(std::string_view name, MemorySource const& memorySource);
+
+    /// Return true on registry initialized
+    [[nodiscard]] ROCKET_FORCE_INLINE explicit operator bool() const noexcept {
+        return static_cast<bool>(storage_);
+    }
+
+    /// Claim a free slot and publish queue
+    /// @return slot index on success and std::nullopt on registry is full
+    [[nodiscard]] auto publish(std::int32_t pid, std::uint64_t sessionID, std::string_view queueName) noexcept
+        -> std::optional<std::size_t>;
+
+    /// Release published slot
+    void release(std::size_t index) noexcept;
+
+    /// Release slot claimed by process @c pid but never published
+    /// @return true on slot released
+    auto releaseAbandoned(std::size_t index, std::int32_t pid) noexcept -> bool;
+
+    /// Registry slots
+    [[nodiscard]] ROCKET_FORCE_INLINE auto slots() const noexcept -> std::span<Slot const> {
+        return slots_;
+    }
+
+    /// Return slot owner pid or zero on slot is free
+    [[nodiscard]] ROCKET_FORCE_INLINE auto ownerOf(std::size_t index) const noexcept -> std::int32_t {
+        return std::atomic_ref{slots_[index].pid}.load(std::memory_order_acquire);
+    }
+
+    /// Return true on slot content published
+    [[nodiscard]] ROCKET_FORCE_INLINE auto isPublished(std::size_t index) const noexcept -> bool {
+        return std::atomic_ref{slots_[index].ready}.load(std::memory_order_acquire) != 0;
+    }
+};
+
+/// Return true on process @c pid is alive
+[[nodiscard]] auto isProcessAlive(std::int32_t pid) noexcept -> bool;
+
+} // namespace rocket::logger::detail
@@ -17,6 +17,7 @@ class ThreadContext final {
   private:
     LoggerQueue::Producer producer_;
     std::thread::id threadID_;
+    bool shared_ = false;
 
   public:
     ThreadContext(ThreadContext const&) = delete;
@@ -28,6 +29,11 @@ class ThreadContext final {
     ThreadContext(LoggerQueueManager& loggerQueueManager) noexcept
         : producer_{loggerQueueManager.createProducer()}, threadID_{std::this_thread::get_id()} {}
 
+    /// Construct from producer
+    /// @param[in] shared is true on producer queue drained by the collector (shared memory mode)
+    explicit ThreadContext(LoggerQueue::Producer producer, bool shared = false) noexcept
+        : producer_{std::move(producer)}, threadID_{std::this_thread::get_id()}, shared_{shared} {}
+
     /// Destructor
     ~ThreadContext() {
         if (producer_) {
@@ -44,6 +50,11 @@ class ThreadContext final {
     [[nodiscard]] ROCKET_FORCE_INLINE auto threadID() const noexcept -> std::thread::id {
         return threadID_;
     }
+
+    /// Return true on queue drained by the collector (shared memory mode)
+    [[nodiscard]] ROCKET_FORCE_INLINE auto isShared() const noexcept -> bool {
+        return shared_;
+    }
 };
 
 } // namespace rocket::logger::detail
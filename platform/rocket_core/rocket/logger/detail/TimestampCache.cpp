@@ -0,0 +1,141 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include "TimestampCache.h"
+
+#include <cstdint>
+
+namespace rocket::logger::detail {
+namespace {
+
+constexpr std::time_t kSecondsPerDay = 24 * 60 * 60;
+
+/// Local time offset at a point
+struct Offset {
+    long utcOffset;
+    int isDst;
+
+    [[nodiscard]] friend auto operator==(Offset const&, Offset const&) noexcept -> bool = default;
+};
+
+[[nodiscard]] auto offsetAt(std::time_t time) noexcept -> Offset {
+    ::tm tm;
+    ::localtime_r(&time, &tm);
+    return Offset{.utcOffset = tm.tm_gmtoff, .isDst = tm.tm_isdst};
+}
+
+/// Find transition between @c same (offset equal to @c offset) and @c other (offset differs)
+/// @return the first point of range containing @c other
+[[nodiscard]] auto findTransition(Offset const& offset, std::time_t same, std::time_t other) noexcept -> std::time_t {
+    while (same - other > 1 || other - same > 1) {
+        auto const middle = same + (other - same) / 2;
+        if (offsetAt(middle) == offset) {
+            same = middle;
+        } else {
+            other = middle;
+        }
+    }
+    return other;
+}
+
+/// Days since 1970-01-01 for a civil date
+[[nodiscard]] constexpr auto daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept -> std::int64_t {
+    year -= month <= 2;
+    auto const era = (year >= 0 ? year : year - 399) / 400;
+    auto const yoe = static_cast<unsigned>(year - era * 400);
+    auto const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0);
+static_assert(daysFromCivil(2000, 3, 1) == 11017);
+
+/// Write zero padded number
+ROCKET_FORCE_INLINE void writeDigits(char* dst, std::size_t count, std::int64_t value) noexcept {
+    for (std::size_t index = count; index > 0; --index) {
+        dst[index - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+void TimestampCache::update(std::time_t time) noexcept {
+    ::tm tm;
+    ::localtime_r(&time, &tm);
+    utcOffset_ = tm.tm_gmtoff;
+    isDst_ = tm.tm_isdst;
+    zone_ = tm.tm_zone;
+
+    auto const offset = Offset{.utcOffset = utcOffset_, .isDst = isDst_};
+    auto const lookAround = std::chrono::duration_cast<std::chrono::seconds>(kLookAround).count();
+
+    if (auto const until = time + lookAround; offsetAt(until) == offset) {
+        validUntil_ = until;
+    } else {
+        validUntil_ = findTransition(offset, time, until);
+    }
+
+    if (auto const from = time - lookAround; offsetAt(from) == offset) {
+        validFrom_ = from;
+    } else {
+        validFrom_ = findTransition(offset, time, from) + 1;
+    }
+}
+
+auto TimestampCache::toLocalTime(std::time_t time) const noexcept -> ::tm {
+    auto const local = static_cast<std::int64_t>(time) + utcOffset_;
+    auto days = local / kSecondsPerDay;
+    auto seconds = local % kSecondsPerDay;
+    if (seconds < 0) {
+        seconds += kSecondsPerDay;
+        days -= 1;
+    }
+
+    // Civil date from days since epoch
+    auto const z = days + 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = static_cast<unsigned>(z - era * 146097);
+    auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const day = doy - (153 * mp + 2) / 5 + 1;
+    auto const month = mp < 10 ? mp + 3 : mp - 9;
+    auto const year = static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2);
+
+    ::tm tm{};
+    tm.tm_sec = static_cast<int>(seconds % 60);
+    tm.tm_min = static_cast<int>(seconds / 60 % 60);
+    tm.tm_hour = static_cast<int>(seconds / 3600);
+    tm.tm_mday = static_cast<int>(day);
+    tm.tm_mon = static_cast<int>(month - 1);
+    tm.tm_year = static_cast<int>(year - 1900);
+    tm.tm_wday = static_cast<int>(((days + 4) % 7 + 7) % 7);
+    tm.tm_yday = static_cast<int>(days - daysFromCivil(year, 1, 1));
+    tm.tm_isdst = isDst_;
+    tm.tm_gmtoff = utcOffset_;
+    tm.tm_zone = zone_;
+    return tm;
+}
+
+void TimestampCache::formatPrefix(std::time_t time) noexcept {
+    auto const tm = this->localtime(time);
+
+    writeDigits(buffer_, 4, tm.tm_year + 1900);
+    buffer_[4] = '-';
+    writeDigits(buffer_ + 5, 2, tm.tm_mon + 1);
+    buffer_[7] = '-';
+    writeDigits(buffer_ + 8, 2, tm.tm_mday);
+    buffer_[10] = ' ';
+    writeDigits(buffer_ + 11, 2, tm.tm_hour);
+    buffer_[13] = ':';
+    writeDigits(buffer_ + 14, 2, tm.tm_min);
+    buffer_[16] = ':';
+    writeDigits(buffer_ + 17, 2, tm.tm_sec);
+    buffer_[kPrefixSize] = '.';
+
+    cachedSecond_ = time;
+}
+
+} // namespace rocket::logger::detail
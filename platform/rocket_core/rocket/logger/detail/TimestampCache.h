@@ -0,0 +1,81 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <limits>
+#include <string_view>
+
+#include "../../Platform.h"
+
+namespace rocket::logger::detail {
+
+/// Local time conversion and timestamp formatting cache
+///
+/// UTC offset is taken from localtime_r once and reused until the next time zone transition (searched up to
+/// kLookAround in both directions), so conversion is plain arithmetic without glibc lock and /etc/localtime checks.
+/// Formatted "YYYY-mm-dd HH:MM:SS" prefix is cached per second, only nanoseconds are formatted for each timestamp.
+/// Time zone changes (TZ or /etc/localtime) are picked up once the offset range expires. Not thread-safe.
+class TimestampCache {
+  public:
+    /// Formatted timestamp size: YYYY-mm-dd HH:MM:SS.sssssssss
+    static constexpr std::size_t kSize = 29;
+
+    /// Max distance to search for a time zone transition, there is at most one transition within
+    static constexpr auto kLookAround = std::chrono::hours(24);
+
+  private:
+    static constexpr std::size_t kPrefixSize = 19;
+
+    // Offset range
+    std::time_t validFrom_ = std::numeric_limits<std::time_t>::max();
+    std::time_t validUntil_ = std::numeric_limits<std::time_t>::min();
+    long utcOffset_ = 0;
+    int isDst_ = 0;
+    char const* zone_ = nullptr;
+
+    // Formatted timestamp with cached prefix
+    std::time_t cachedSecond_ = std::numeric_limits<std::time_t>::min();
+    char buffer_[kSize];
+
+  public:
+    TimestampCache() = default;
+
+    /// Convert into broken-down local time (same as localtime_r)
+    [[nodiscard]] ROCKET_FORCE_INLINE auto localtime(std::time_t time) noexcept -> ::tm {
+        if (time < validFrom_ || time >= validUntil_) [[unlikely]] {
+            this->update(time);
+        }
+        return this->toLocalTime(time);
+    }
+
+    /// Format timestamp as local time YYYY-mm-dd HH:MM:SS.sssssssss
+    /// Result valid until next call
+    [[nodiscard]] auto format(::timespec const& timestamp) noexcept -> std::string_view {
+        if (timestamp.tv_sec != cachedSecond_) [[unlikely]] {
+            this->formatPrefix(timestamp.tv_sec);
+        }
+
+        auto nanoseconds = timestamp.tv_nsec;
+        for (std::size_t index = kSize; index > kPrefixSize + 1; --index) {
+            buffer_[index - 1] = static_cast<char>('0' + nanoseconds % 10);
+            nanoseconds /= 10;
+        }
+
+        return std::string_view{buffer_, kSize};
+    }
+
+  private:
+    /// Take UTC offset and its range from localtime_r
+    void update(std::time_t time) noexcept;
+
+    /// Convert using cached UTC offset
+    [[nodiscard]] auto toLocalTime(std::time_t time) const noexcept -> ::tm;
+
+    void formatPrefix(std::time_t time) noexcept;
+};
+
+} // namespace rocket::logger::detail
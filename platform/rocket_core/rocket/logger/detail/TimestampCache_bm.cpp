@@ -0,0 +1,96 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <ctime>
+
+#include <benchmark/benchmark.h>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "TimestampCache.h"
+
+namespace rocket::logger::detail {
+namespace {
+
+/// Timestamps advanced by 1 us, new second once per 1000000 records
+[[nodiscard]] auto nextTimestamp(::timespec& timestamp) noexcept -> ::timespec const& {
+    timestamp.tv_nsec += 1000;
+    if (timestamp.tv_nsec >= 1000000000l) {
+        timestamp.tv_nsec -= 1000000000l;
+        timestamp.tv_sec += 1;
+    }
+    return timestamp;
+}
+
+} // namespace
+
+/// Previous PatternFormatter implementation
+static void BM_LocaltimeFormat(::benchmark::State& state) {
+    auto timestamp = ::timespec{.tv_sec = std::time(nullptr), .tv_nsec = 0};
+    char buffer[30];
+
+    for (auto _ : state) {
+        auto const& value = nextTimestamp(timestamp);
+        ::tm tm;
+        ::localtime_r(&value.tv_sec, &tm);
+        auto const result = fmt::format_to_n(buffer, sizeof(buffer), "{:%F %T}.{:09}", tm, value.tv_nsec);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_LocaltimeFormat);
+
+static void BM_TimestampCacheFormat(::benchmark::State& state) {
+    auto timestamp = ::timespec{.tv_sec = std::time(nullptr), .tv_nsec = 0};
+    TimestampCache cache;
+
+    for (auto _ : state) {
+        auto const result = cache.format(nextTimestamp(timestamp));
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_TimestampCacheFormat);
+
+/// Each record in a new second
+static void BM_TimestampCacheFormatNewSecond(::benchmark::State& state) {
+    auto timestamp = ::timespec{.tv_sec = std::time(nullptr), .tv_nsec = 0};
+    TimestampCache cache;
+
+    for (auto _ : state) {
+        timestamp.tv_sec += 1;
+        auto const result = cache.format(timestamp);
+        ::benchmark::DoNotOptimize(result);
+        ::benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_TimestampCacheFormatNewSecond);
+
+static void BM_Localtime(::benchmark::State& state) {
+    auto time = std::time(nullptr);
+
+    for (auto _ : state) {
+        ::tm tm;
+        ::benchmark::DoNotOptimize(::localtime_r(&time, &tm));
+        time += 1;
+    }
+}
+
+BENCHMARK(BM_Localtime);
+
+static void BM_TimestampCacheLocaltime(::benchmark::State& state) {
+    auto time = std::time(nullptr);
+    TimestampCache cache;
+
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(cache.localtime(time));
+        time += 1;
+    }
+}
+
+BENCHMARK(BM_TimestampCacheLocaltime);
+
+} // namespace rocket::logger::detail
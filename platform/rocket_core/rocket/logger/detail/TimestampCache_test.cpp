@@ -0,0 +1,96 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+#include <doctest/doctest.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "TimestampCache.h"
+
+namespace rocket::logger::detail {
+
+/// Set TZ for the scope
+class ScopedTimeZone {
+  private:
+    std::optional<std::string> previous_;
+
+  public:
+    explicit ScopedTimeZone(char const* value) {
+        if (auto const previous = std::getenv("TZ"); previous) {
+            previous_ = previous;
+        }
+        ::setenv("TZ", value, 1);
+        ::tzset();
+    }
+
+    ~ScopedTimeZone() {
+        if (previous_) {
+            ::setenv("TZ", previous_->c_str(), 1);
+        } else {
+            ::unsetenv("TZ");
+        }
+        ::tzset();
+    }
+};
+
+void checkLocalTime(TimestampCache& cache, std::time_t time) {
+    ::tm expected;
+    ::localtime_r(&time, &expected);
+    auto const tm = cache.localtime(time);
+
+    INFO("time: ", time);
+    REQUIRE_EQ(tm.tm_sec, expected.tm_sec);
+    REQUIRE_EQ(tm.tm_min, expected.tm_min);
+    REQUIRE_EQ(tm.tm_hour, expected.tm_hour);
+    REQUIRE_EQ(tm.tm_mday, expected.tm_mday);
+    REQUIRE_EQ(tm.tm_mon, expected.tm_mon);
+    REQUIRE_EQ(tm.tm_year, expected.tm_year);
+    REQUIRE_EQ(tm.tm_wday, expected.tm_wday);
+    REQUIRE_EQ(tm.tm_yday, expected.tm_yday);
+    REQUIRE_EQ(tm.tm_isdst, expected.tm_isdst);
+    REQUIRE_EQ(tm.tm_gmtoff, expected.tm_gmtoff);
+}
+
+TEST_CASE("TimestampCache: local time across DST transitions") {
+    ScopedTimeZone const timeZone{"Europe/Berlin"};
+    TimestampCache cache;
+
+    // 2024-03-31 01:00:00 UTC and 2024-10-27 01:00:00 UTC
+    for (std::time_t const transition : {1711846800l, 1729990800l}) {
+        for (auto time = transition - 7200; time < transition + 7200; time += 7) {
+            checkLocalTime(cache, time);
+        }
+        // Out of order access
+        for (auto time = transition + 100000; time > transition - 100000; time -= 997) {
+            checkLocalTime(cache, time);
+        }
+    }
+
+    // Leap years and epoch
+    for (std::time_t const time : {0l, 951782400l, 951868800l, 4107542400l, -86400l}) {
+        checkLocalTime(cache, time);
+    }
+}
+
+TEST_CASE("TimestampCache: format") {
+    ScopedTimeZone const timeZone{"America/New_York"};
+    TimestampCache cache;
+
+    for (std::time_t time = 1710054000; time < 1710054000 + 4 * 3600; time += 61) {
+        for (long const nanoseconds : {0l, 1l, 123456789l, 999999999l}) {
+            auto const timestamp = ::timespec{.tv_sec = time, .tv_nsec = nanoseconds};
+            ::tm tm;
+            ::localtime_r(&time, &tm);
+            auto const expected = fmt::format("{:%F %T}.{:09}", tm, nanoseconds);
+            REQUIRE_EQ(cache.format(timestamp), expected);
+        }
+    }
+}
+
+} // namespace rocket::logger::detail
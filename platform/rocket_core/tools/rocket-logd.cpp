@@ -0,0 +1,122 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+// Log collector for processes logging in shared memory mode (see rocket::logger::startSharedBackend)
+//
+// usage: rocket-logd [-r registry] [-c clockPage] [-o output] [-p pattern] [-s sleepMs]
+//   -r registry - registry name at /dev/shm (default: rocket-logger)
+//   -c clockPage - TSC clock shared page name at /dev/shm, empty to disable (default: rocket-tsc-clock)
+//   -o output   - output file, reopened on SIGHUP (default: stdout)
+//   -p pattern  - PatternFormatter pattern
+//   -s sleepMs  - sleep duration if there is no remaining work to process (default: 1ms)
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <rocket/FileStream.h>
+#include <rocket/LoopRateLimit.h>
+#include <rocket/Signals.h>
+#include <rocket/TscClock.h>
+#include <rocket/logger/Collector.h>
+#include <rocket/logger/Sink.h>
+
+namespace {
+
+struct Options {
+    rocket::logger::CollectorOptions collector;
+    rocket::TscClockOptions clock = {.sharedPageName = rocket::kDefaultTscClockSharedPageName};
+    std::optional<std::string> output;
+    std::string pattern = "{timestamp} [{level}] ({pid}:{threadID}) {message} ({file}:{line})";
+    std::chrono::milliseconds sleepDuration = std::chrono::milliseconds(1);
+};
+
+[[noreturn]] void usage(char const* name) {
+    fmt::print(stderr, "usage: {} [-r registry] [-c clockPage] [-o output] [-p pattern] [-s sleepMs]\n", name);
+    std::exit(EXIT_FAILURE);
+}
+
+auto parseOptions(int argc, char* argv[]) -> Options {
+    auto options = Options();
+    int opt;
+    while ((opt = ::getopt(argc, argv, "r:c:o:p:s:h")) != -1) {
+        switch (opt) {
+        case 'r': options.collector.registryName = optarg; break;
+        case 'c': options.clock.sharedPageName = optarg; break;
+        case 'o': options.output = optarg; break;
+        case 'p': options.pattern = optarg; break;
+        case 's': options.sleepDuration = std::chrono::milliseconds(std::atoi(optarg)); break;
+        default: usage(argv[0]);
+        }
+    }
+    return options;
+}
+
+auto openOutput(std::optional<std::string> const& path) -> rocket::FileStream {
+    if (path) {
+        return rocket::FileStream(*path, "a");
+    }
+    return rocket::FileStream(stdout);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        auto const options = parseOptions(argc, argv);
+
+        rocket::installSignalHandlers();
+
+        // Daemon started first calibrates clock for all producers sharing the page
+        rocket::TscClock::configure(options.clock);
+        [[maybe_unused]] auto const& clock = rocket::TscClock::instance();
+
+        auto output = openOutput(options.output);
+        auto formatter = rocket::logger::PatternFormatter();
+        formatter.setPattern(options.pattern);
+
+        auto collector =
+            rocket::logger::Collector(options.collector, [&](rocket::logger::CollectedRecord const& record) {
+                auto const line = formatter(record.file, record.line, record.pid, record.level, record.timestamp,
+                    record.threadID, record.message);
+                fmt::print(output, "{}\n", line);
+            });
+
+        auto running = true;
+        auto loopRateLimit = rocket::LoopRateLimit(options.sleepDuration);
+
+        while (running) {
+            rocket::notifyCatchedSignals([&](rocket::CatchedSignal signal) {
+                if (signal.shutdown()) {
+                    running = false;
+                }
+                if (signal.reload()) {
+                    std::fflush(output);
+                    output = openOutput(options.output);
+                }
+            });
+
+            if (collector.poll() > 0) {
+                std::fflush(output);
+            }
+
+            loopRateLimit.sleep();
+        }
+
+        // Drain everything
+        while (collector.poll() > 0) {}
+        std::fflush(output);
+    } catch (std::exception const& e) {
+        fmt::print(stderr, "rocket-logd: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,478 @@
+// Copyright (c) Sergey Kovalevich <inndie@gmail.com>
+// SPDX-License-Identifier: AGPL-3.0
+
+// Inspector for shared memory queues (SPSC, SPMC, MPSC)
+//
+// usage: rocket-qstat [-w] [-i intervalMs] [-d directory] name...
+//   -w, --watch       - refresh live with rates (statistics enabled queues and MPSC)
+//   -i, --interval    - watch refresh interval (default: 1000ms)
+//   -d, --directory   - queues directory (default: /dev/shm)
+//
+// Queues are mapped read-only and never locked, consumer (producer for SPMC) lock holder is taken from /proc/locks.
+
+#include <getopt.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <rocket/BoundedMPSCRawQueue.h>
+#include <rocket/BoundedSPMCRawQueue.h>
+#include <rocket/BoundedSPSCRawQueue.h>
+#include <rocket/LoopRateLimit.h>
+#include <rocket/MemorySource.h>
+#include <rocket/Signals.h>
+#include <rocket/detail/memory.h>
+
+namespace {
+
+/// Max messages walked for SPSC lag
+constexpr std::size_t kMaxWalkMessages = std::size_t(1) << 20;
+
+struct Options {
+    bool watch = false;
+    std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+    std::optional<std::filesystem::path> directory;
+    std::vector<std::string> names;
+};
+
+[[noreturn]] void usage(char const* name) {
+    fmt::print(stderr, "usage: {} [-w] [-i intervalMs] [-d directory] name...\n", name);
+    std::exit(EXIT_FAILURE);
+}
+
+auto parseOptions(int argc, char* argv[]) -> Options {
+    static ::option const longOptions[] = {
+        {"watch", no_argument, nullptr, 'w'},
+        {"interval", required_argument, nullptr, 'i'},
+        {"directory", required_argument, nullptr, 'd'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    auto options = Options();
+    int opt;
+    while ((opt = ::getopt_long(argc, argv, "wi:d:h", longOptions, nullptr)) != -1) {
+        switch (opt) {
+        case 'w': options.watch = true; break;
+        case 'i': options.interval = std::chrono::milliseconds(std::atoi(optarg)); break;
+        case 'd': options.directory = optarg; break;
+        default: usage(argv[0]);
+        }
+    }
+    for (int index = optind; index < argc; ++index) {
+        options.names.emplace_back(argv[index]);
+    }
+    if (options.names.empty() || options.interval.count() <= 0) {
+        usage(argv[0]);
+    }
+    return options;
+}
+
+/// Return pid of process holding flock on the file or std::nullopt
+auto getLockHolder(rocket::File const& file) -> std::optional<int> {
+    struct stat st;
+    if (::fstat(file.get(), &st) == -1) {
+        return std::nullopt;
+    }
+
+    auto handle = std::fopen("/proc/locks", "r");
+    if (!handle) {
+        return std::nullopt;
+    }
+
+    std::optional<int> result;
+    char line[256];
+    while (!result && std::fgets(line, sizeof(line), handle)) {
+        char type[16];
+        int pid = 0;
+        unsigned int major = 0;
+        unsigned int minor = 0;
+        unsigned long inode = 0;
+        // 1: FLOCK  ADVISORY  WRITE 1234 00:19:5678 0 EOF
+        if (std::sscanf(line, "%*d: %15s %*s %*s %d %x:%x:%lu", type, &pid, &major, &minor, &inode) != 5) {
+            continue;
+        }
+        if (std::string_view(type) == "FLOCK" && major == ::major(st.st_dev) && minor == ::minor(st.st_dev) &&
+            inode == st.st_ino) {
+            result = pid;
+        }
+    }
+    std::fclose(handle);
+    return result;
+}
+
+/// Queue state sample
+struct Sample {
+    std::string_view type;
+    std::string_view lockRole;
+    std::size_t capacity = 0;
+    std::size_t producerPos = 0;
+    std::optional<std::size_t> consumerPos;
+    std::optional<std::size_t> lagBytes;
+    std::optional<std::size_t> lagMessages;
+    bool lagMessagesTruncated = false;
+    /// Monotonic message counters (MPSC positions)
+    std::optional<std::size_t> producedMessages;
+    std::optional<std::size_t> consumedMessages;
+    /// Pid and lag (bytes) of each registered consumer (SPMC with backpressure)
+    std::vector<std::pair<std::int32_t, std::size_t>> consumerLags;
+    /// Lag (bytes) of each consumer group (SPMC)
+    std::vector<std::size_t> groupLags;
+    /// Messages abandoned by dead producers (MPSC)
+    std::optional<std::size_t> abandoned;
+    std::optional<rocket::QueueStatistics> statistics;
+    std::optional<int> lockHolder;
+};
+
+/// Queue inspector
+class Inspector {
+  protected:
+    std::string name_;
+    rocket::File file_;
+    rocket::MappedRegion storage_;
+
+  public:
+    Inspector(std::string name, rocket::File file, rocket::MappedRegion storage)
+        : name_(std::move(name)), file_(std::move(file)), storage_(std::move(storage)) {}
+
+    virtual ~Inspector() = default;
+
+    [[nodiscard]] auto name() const noexcept -> std::string const& {
+        return name_;
+    }
+
+    [[nodiscard]] virtual auto sample() const -> Sample = 0;
+};
+
+/// Load position published by queue
+[[nodiscard]] auto loadPos(std::size_t const& value) noexcept -> std::size_t {
+    return std::atomic_ref(const_cast<std::size_t&>(value)).load(std::memory_order_acquire);
+}
+
+template <typename Traits>
+class SPSCInspector final : public Inspector {
+  private:
+    using QueueDetail = rocket::detail::BoundedSPSCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+    using MessageHeader = typename QueueDetail::MessageHeader;
+
+  public:
+    using Inspector::Inspector;
+
+    [[nodiscard]] auto sample() const -> Sample override {
+        auto const header = std::bit_cast<MemoryHeader const*>(storage_.data());
+        auto const data = storage_.content().subspan(QueueDetail::kDataStartPos);
+
+        auto result = Sample();
+        result.type = Traits::kTag;
+        result.lockRole = "consumer";
+        result.capacity = data.size();
+        auto const consumerPos = loadPos(header->consumerPos);
+        result.producerPos = loadPos(header->producerPos);
+        result.consumerPos = consumerPos;
+        result.lagBytes = QueueDetail::occupancy(result.producerPos, consumerPos, data.size());
+
+        // Messages between positions are not overwritten until consumed, stop on consumer moved ahead
+        std::size_t count = 0;
+        for (auto pos = consumerPos; pos != result.producerPos; ++count) {
+            if (count == kMaxWalkMessages || pos + sizeof(MessageHeader) > data.size()) {
+                result.lagMessagesTruncated = true;
+                break;
+            }
+            auto const message = std::bit_cast<MessageHeader const*>(data.data() + pos);
+            auto const next = message->payloadOffset + message->size;
+            if (next > data.size() || next == pos) {
+                result.lagMessagesTruncated = true;
+                break;
+            }
+            pos = next;
+        }
+        result.lagMessages = count;
+
+        if constexpr (QueueDetail::kStatistics) {
+            result.statistics = header->statistics.load();
+        }
+        result.lockHolder = getLockHolder(file_);
+        return result;
+    }
+};
+
+template <typename Traits>
+class SPMCInspector final : public Inspector {
+  private:
+    using QueueDetail = rocket::detail::BoundedSPMCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+
+  public:
+    using Inspector::Inspector;
+
+    [[nodiscard]] auto sample() const -> Sample override {
+        auto const header = std::bit_cast<MemoryHeader const*>(storage_.data());
+
+        // Consumers positions are process local
+        auto result = Sample();
+        result.type = Traits::kTag;
+        result.lockRole = "producer";
+        result.capacity = storage_.size() - QueueDetail::kDataStartPos;
+        result.producerPos = loadPos(header->producerPos);
+        if constexpr (QueueDetail::kConsumerSlots > 0) {
+            for (auto const& slot : header->consumers.slots) {
+                auto const owner =
+                    std::atomic_ref(const_cast<std::int32_t&>(slot.owner)).load(std::memory_order_acquire);
+                if (owner != 0) {
+                    result.consumerLags.emplace_back(
+                        owner, QueueDetail::occupancy(result.producerPos, loadPos(slot.pos), result.capacity));
+                }
+            }
+        }
+        if constexpr (QueueDetail::kConsumerGroups > 0) {
+            for (auto const& cursor : header->groups.cursors) {
+                auto const pos = rocket::detail::SPMCConsumerGroupCursor::offset(loadPos(cursor.value));
+                result.groupLags.push_back(
+                    result.producerPos >= pos ? result.producerPos - pos : result.capacity - pos + result.producerPos);
+            }
+        }
+        if constexpr (QueueDetail::kStatistics) {
+            result.statistics = header->statistics.load();
+        }
+        result.lockHolder = getLockHolder(file_);
+        return result;
+    }
+};
+
+template <typename Traits>
+class MPSCInspector final : public Inspector {
+  private:
+    using QueueDetail = rocket::detail::BoundedMPSCRawQueueDetail<Traits>;
+    using MemoryHeader = typename QueueDetail::MemoryHeader;
+
+  public:
+    using Inspector::Inspector;
+
+    [[nodiscard]] auto sample() const -> Sample override {
+        auto const header = std::bit_cast<MemoryHeader const*>(storage_.data());
+
+        auto result = Sample();
+        result.type = Traits::kTag;
+        result.lockRole = "consumer";
+        result.capacity = header->maxMessageSize * header->length;
+        auto const consumerPos = loadPos(header->consumerPos);
+        auto const producerPos = loadPos(header->producerPos);
+        result.producerPos = producerPos;
+        result.consumerPos = consumerPos;
+        result.producedMessages = producerPos;
+        result.consumedMessages = consumerPos;
+        result.lagMessages = producerPos - consumerPos;
+        result.lagBytes = *result.lagMessages * header->maxMessageSize;
+        result.abandoned = loadPos(header->abandoned);
+        if constexpr (QueueDetail::kStatistics) {
+            result.statistics = header->statistics.load();
+        }
+        result.lockHolder = getLockHolder(file_);
+        return result;
+    }
+};
+
+/// Return true on buffer holds a queue of the layout
+template <typename QueueDetail>
+[[nodiscard]] auto matches(std::span<std::byte const> content) noexcept -> bool {
+    return content.size() >= std::max(sizeof(typename QueueDetail::MemoryHeader), QueueDetail::kTag.size()) &&
+           QueueDetail::check(content);
+}
+
+auto openQueue(rocket::MemorySource const& memorySource, std::string const& name) -> std::unique_ptr<Inspector> {
+    using namespace rocket;
+
+    auto result = memorySource.open(name, MemorySource::OpenOnly);
+    if (!result) {
+        throw std::runtime_error(fmt::format("failed to open queue \"{}\": {}", name, result.error().message()));
+    }
+    auto file = std::get<File>(std::move(result).value());
+    auto const fileSize = file.getFileSize();
+    if (fileSize == 0) {
+        throw std::runtime_error(fmt::format("queue \"{}\" is empty", name));
+    }
+
+    // Read-only without prefault, only pages touched by sampling are mapped
+    auto storage = detail::mapReadOnly(file, fileSize);
+    auto const content = storage.content();
+
+    // Tags of different layouts never match each other
+    if (matches<detail::BoundedSPSCRawQueueDetail<BoundedSPSCRawQueueStatisticsTraits>>(content)) {
+        return std::make_unique<SPSCInspector<BoundedSPSCRawQueueStatisticsTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedSPSCRawQueueDetail<BoundedSPSCRawQueueDefaultTraits>>(content)) {
+        return std::make_unique<SPSCInspector<BoundedSPSCRawQueueDefaultTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedSPMCRawQueueDetail<BoundedSPMCRawQueueStatisticsTraits>>(content)) {
+        return std::make_unique<SPMCInspector<BoundedSPMCRawQueueStatisticsTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedSPMCRawQueueDetail<BoundedSPMCRawQueueBackpressureTraits>>(content)) {
+        return std::make_unique<SPMCInspector<BoundedSPMCRawQueueBackpressureTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedSPMCRawQueueDetail<BoundedSPMCRawQueueGroupTraits>>(content)) {
+        return std::make_unique<SPMCInspector<BoundedSPMCRawQueueGroupTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedSPMCRawQueueDetail<BoundedSPMCRawQueueDefaultTraits>>(content)) {
+        return std::make_unique<SPMCInspector<BoundedSPMCRawQueueDefaultTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedMPSCRawQueueDetail<BoundedMPSCRawQueueStatisticsTraits>>(content)) {
+        return std::make_unique<MPSCInspector<BoundedMPSCRawQueueStatisticsTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    if (matches<detail::BoundedMPSCRawQueueDetail<BoundedMPSCRawQueueDefaultTraits>>(content)) {
+        return std::make_unique<MPSCInspector<BoundedMPSCRawQueueDefaultTraits>>(
+            name, std::move(file), std::move(storage));
+    }
+    throw std::runtime_error(fmt::format("\"{}\" is not a rocket queue", name));
+}
+
+template <typename T>
+auto formatOptional(std::optional<T> const& value) -> std::string {
+    return value ? fmt::format("{}", *value) : std::string("-");
+}
+
+void printSample(std::string const& name, Sample const& sample) {
+    fmt::print("{}: {}\n", name, sample.type);
+    fmt::print("  capacity:      {} bytes\n", sample.capacity);
+    fmt::print("  producer pos:  {}\n", sample.producerPos);
+    fmt::print("  consumer pos:  {}\n", formatOptional(sample.consumerPos));
+    fmt::print("  lag:           {} bytes, {}{} messages\n", formatOptional(sample.lagBytes),
+        sample.lagMessagesTruncated ? ">=" : "", formatOptional(sample.lagMessages));
+    for (auto const& [pid, lag] : sample.consumerLags) {
+        fmt::print("  consumer lag:  {} bytes (pid {})\n", lag, pid);
+    }
+    for (std::size_t group = 0; group < sample.groupLags.size(); ++group) {
+        fmt::print("  group {} lag:   {} bytes\n", group, sample.groupLags[group]);
+    }
+    if (sample.abandoned) {
+        fmt::print("  abandoned:     {} messages\n", *sample.abandoned);
+    }
+    auto const lock = fmt::format("{} lock:", sample.lockRole);
+    if (sample.lockHolder) {
+        fmt::print("  {:<15}held by pid {}\n", lock, *sample.lockHolder);
+    } else {
+        fmt::print("  {:<15}not held\n", lock);
+    }
+    if (sample.statistics) {
+        auto const& statistics = *sample.statistics;
+        fmt::print("  messages:      {}\n", statistics.messages);
+        fmt::print("  bytes:         {}\n", statistics.bytes);
+        fmt::print("  full events:   {}\n", statistics.fullEvents);
+        fmt::print("  high-water:    {} bytes\n", statistics.highWaterMark);
+    }
+}
+
+void printRates(Sample const& previous, Sample const& current, double seconds) {
+    auto const rate = [seconds](std::uint64_t from, std::uint64_t to) {
+        return static_cast<double>(to - from) / seconds;
+    };
+    if (current.statistics && previous.statistics) {
+        fmt::print("  rate:          {:.0f} msg/s, {:.0f} B/s, {:.0f} full/s\n",
+            rate(previous.statistics->messages, current.statistics->messages),
+            rate(previous.statistics->bytes, current.statistics->bytes),
+            rate(previous.statistics->fullEvents, current.statistics->fullEvents));
+    }
+    if (current.producedMessages && previous.producedMessages) {
+        fmt::print("  enqueue rate:  {:.0f} msg/s\n", rate(*previous.producedMessages, *current.producedMessages));
+        fmt::print("  dequeue rate:  {:.0f} msg/s\n", rate(*previous.consumedMessages, *current.consumedMessages));
+    }
+    if (!current.statistics && !current.producedMessages) {
+        fmt::print("  rate:          - (statistics disabled)\n");
+    }
+}
+
+auto makeMemorySource(Options const& options) -> std::unique_ptr<rocket::MemorySource> {
+    if (options.directory) {
+        return std::make_unique<rocket::DefaultMemorySource>(*options.directory, ::sysconf(_SC_PAGESIZE));
+    }
+    return std::make_unique<rocket::DefaultMemorySource>();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        auto const options = parseOptions(argc, argv);
+        auto const memorySource = makeMemorySource(options);
+
+        std::vector<std::unique_ptr<Inspector>> inspectors;
+        for (auto const& name : options.names) {
+            inspectors.push_back(openQueue(*memorySource, name));
+        }
+
+        std::vector<Sample> samples;
+        for (auto const& inspector : inspectors) {
+            samples.push_back(inspector->sample());
+        }
+
+        if (!options.watch) {
+            for (std::size_t index = 0; index < inspectors.size(); ++index) {
+                printSample(inspectors[index]->name(), samples[index]);
+            }
+            return EXIT_SUCCESS;
+        }
+
+        rocket::installSignalHandlers();
+
+        auto running = true;
+        auto loopRateLimit = rocket::LoopRateLimit(options.interval);
+        auto sampledAt = std::chrono::steady_clock::now();
+
+        while (running) {
+            loopRateLimit.sleep();
+
+            rocket::notifyCatchedSignals([&](rocket::CatchedSignal signal) {
+                if (signal.shutdown()) {
+                    running = false;
+                }
+            });
+
+            auto const now = std::chrono::steady_clock::now();
+            auto const seconds = std::chrono::duration<double>(now - sampledAt).count();
+            sampledAt = now;
+
+            // Clear screen
+            fmt::print("\x1b[H\x1b[2J");
+            for (std::size_t index = 0; index < inspectors.size(); ++index) {
+                auto sample = inspectors[index]->sample();
+                printSample(inspectors[index]->name(), sample);
+                printRates(samples[index], sample, seconds);
+                samples[index] = std::move(sample);
+            }
+            std::fflush(stdout);
+        }
+    } catch (std::exception const& e) {
+        fmt::print(stderr, "rocket-qstat: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}